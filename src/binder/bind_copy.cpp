@@ -0,0 +1,64 @@
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "binder/binder.h"
+#include "binder/statement/copy_statement.h"
+#include "binder/table_ref/bound_base_table_ref.h"
+#include "common/exception.h"
+#include "common/util/string_util.h"
+#include "fmt/format.h"
+#include "nodes/parsenodes.hpp"
+
+namespace bustub {
+
+auto Binder::BindCopy(duckdb_libpgquery::PGCopyStmt *stmt) -> std::unique_ptr<CopyStatement> {
+  if (!stmt->is_from) {
+    throw NotImplementedException("only COPY FROM is supported");
+  }
+  if (stmt->relation == nullptr || stmt->attlist != nullptr) {
+    throw NotImplementedException("COPY only loads into all columns of a table");
+  }
+  if (stmt->is_program || stmt->filename == nullptr) {
+    throw NotImplementedException("COPY only reads from a file");
+  }
+
+  // the file is always read as CSV, whatever the options say
+  char delimiter = ',';
+  bool header = false;
+  if (stmt->options != nullptr) {
+    for (auto cell = stmt->options->head; cell != nullptr; cell = cell->next) {
+      auto option = reinterpret_cast<duckdb_libpgquery::PGDefElem *>(cell->data.ptr_value);
+      auto *arg = reinterpret_cast<duckdb_libpgquery::PGValue *>(option->arg);
+      if (strcmp(option->defname, "format") == 0) {
+        if (arg == nullptr || arg->type != duckdb_libpgquery::T_PGString ||
+            StringUtil::Lower(arg->val.str) != "csv") {
+          throw NotImplementedException("COPY only supports the csv format");
+        }
+      } else if (strcmp(option->defname, "delimiter") == 0) {
+        if (arg == nullptr || arg->type != duckdb_libpgquery::T_PGString || strlen(arg->val.str) != 1) {
+          throw bustub::Exception("COPY delimiter must be a single character");
+        }
+        delimiter = arg->val.str[0];
+      } else if (strcmp(option->defname, "header") == 0) {
+        // `HEADER`, `HEADER true` or `HEADER false`
+        if (arg == nullptr) {
+          header = true;
+        } else if (arg->type == duckdb_libpgquery::T_PGInteger) {
+          header = arg->val.ival != 0;
+        } else if (arg->type == duckdb_libpgquery::T_PGString) {
+          auto value = StringUtil::Lower(arg->val.str);
+          header = value == "true" || value == "on" || value == "1";
+        }
+      } else {
+        throw NotImplementedException(fmt::format("unsupported COPY option {}", option->defname));
+      }
+    }
+  }
+
+  return std::make_unique<CopyStatement>(BindBaseTableRef(stmt->relation->relname, std::nullopt), stmt->filename,
+                                         delimiter, header);
+}
+
+}  // namespace bustub
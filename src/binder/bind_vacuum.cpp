@@ -0,0 +1,23 @@
+#include <memory>
+#include <optional>
+
+#include "binder/binder.h"
+#include "binder/statement/vacuum_statement.h"
+#include "binder/table_ref/bound_base_table_ref.h"
+#include "common/exception.h"
+#include "nodes/parsenodes.hpp"
+
+namespace bustub {
+
+auto Binder::BindVacuum(duckdb_libpgquery::PGVacuumStmt *stmt) -> std::unique_ptr<VacuumStatement> {
+  // `VACUUM FULL` is accepted too, as vacuum always moves tuples to release pages
+  if ((stmt->options & duckdb_libpgquery::PG_VACOPT_ANALYZE) != 0 || stmt->va_cols != nullptr) {
+    throw NotImplementedException("analyze is not supported");
+  }
+  if (stmt->relation == nullptr) {
+    return std::make_unique<VacuumStatement>(nullptr);
+  }
+  return std::make_unique<VacuumStatement>(BindBaseTableRef(stmt->relation->relname, std::nullopt));
+}
+
+}  // namespace bustub
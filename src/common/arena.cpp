@@ -0,0 +1,49 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arena.cpp
+//
+// Identification: src/common/arena.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/arena.h"
+
+#include <cstdint>
+
+namespace bustub {
+
+auto Arena::Allocate(size_t size, size_t alignment) -> void * {
+  BUSTUB_ASSERT(alignment <= alignof(std::max_align_t) && (alignment & (alignment - 1)) == 0, "unsupported alignment");
+  std::scoped_lock guard(latch_);
+  allocation_count_++;
+  // large allocations get a block of their own, so that they do not waste the rest of the current one
+  if (size > ARENA_BLOCK_SIZE / 4) {
+    blocks_.push_back(std::make_unique<char[]>(size));
+    return blocks_.back().get();
+  }
+  auto aligned = (reinterpret_cast<uintptr_t>(cursor_) + alignment - 1) & ~(alignment - 1);
+  if (cursor_ == nullptr || aligned + size > reinterpret_cast<uintptr_t>(end_)) {
+    blocks_.push_back(std::make_unique<char[]>(ARENA_BLOCK_SIZE));
+    cursor_ = blocks_.back().get();
+    end_ = cursor_ + ARENA_BLOCK_SIZE;
+    aligned = reinterpret_cast<uintptr_t>(cursor_);
+  }
+  cursor_ = reinterpret_cast<char *>(aligned + size);
+  return reinterpret_cast<void *>(aligned);
+}
+
+auto Arena::GetAllocationCount() const -> size_t {
+  std::scoped_lock guard(latch_);
+  return allocation_count_;
+}
+
+auto Arena::GetBlockCount() const -> size_t {
+  std::scoped_lock guard(latch_);
+  return blocks_.size();
+}
+
+}  // namespace bustub
@@ -1,6 +1,7 @@
-// DDL (Data Definition Language) statement handling in BusTub, including create table, create index, and set/show
-// variable.
+// DDL (Data Definition Language) statement handling in BusTub, including create table, create index, set/show
+// variable, vacuum, and copy.
 
+#include <fstream>
 #include <optional>
 #include <shared_mutex>
 #include <string>
@@ -9,11 +10,13 @@
 #include "binder/binder.h"
 #include "binder/bound_expression.h"
 #include "binder/bound_statement.h"
+#include "binder/statement/copy_statement.h"
 #include "binder/statement/create_statement.h"
 #include "binder/statement/explain_statement.h"
 #include "binder/statement/index_statement.h"
 #include "binder/statement/select_statement.h"
 #include "binder/statement/set_show_statement.h"
+#include "binder/statement/vacuum_statement.h"
 #include "buffer/buffer_pool_manager.h"
 #include "catalog/schema.h"
 #include "catalog/table_generator.h"
@@ -36,13 +39,98 @@
 #include "recovery/log_manager.h"
 #include "storage/disk/disk_manager.h"
 #include "storage/disk/disk_manager_memory.h"
+#include "storage/index/memcmp_key.h"
 #include "type/value_factory.h"
 
 namespace bustub {
 
+/** The number of rows COPY collects before handing them to the table heap and the indexes */
+static constexpr size_t COPY_BATCH_SIZE = 4096;
+
+/**
+ * Read one CSV record, spanning several lines if a quoted field holds a line break. A quote inside a quoted field is
+ * written twice. An empty field is NULL unless quoted.
+ * @return false at the end of the input
+ */
+static auto ReadCsvRecord(std::istream &in, char delimiter, std::vector<std::optional<std::string>> *fields,
+                          size_t *line_number) -> bool {
+  auto read_line = [&](std::string *line) -> bool {
+    if (!std::getline(in, *line)) {
+      return false;
+    }
+    (*line_number)++;
+    if (!line->empty() && line->back() == '\r') {
+      line->pop_back();
+    }
+    return true;
+  };
+
+  std::string line;
+  if (!read_line(&line)) {
+    return false;
+  }
+  fields->clear();
+  std::string field;
+  bool quoted = false;
+  bool in_quotes = false;
+  auto end_field = [&]() {
+    if (field.empty() && !quoted) {
+      fields->emplace_back(std::nullopt);
+    } else {
+      fields->emplace_back(std::move(field));
+    }
+    field.clear();
+    quoted = false;
+  };
+
+  size_t pos = 0;
+  while (true) {
+    if (pos == line.size()) {
+      if (!in_quotes) {
+        break;
+      }
+      if (!read_line(&line)) {
+        throw Exception(fmt::format("COPY: unterminated quoted field at line {}", *line_number));
+      }
+      field.push_back('\n');
+      pos = 0;
+      continue;
+    }
+    char c = line[pos++];
+    if (in_quotes) {
+      if (c != '"') {
+        field.push_back(c);
+      } else if (pos < line.size() && line[pos] == '"') {
+        field.push_back('"');
+        pos++;
+      } else {
+        in_quotes = false;
+      }
+    } else if (c == '"') {
+      in_quotes = true;
+      quoted = true;
+    } else if (c == delimiter) {
+      end_field();
+    } else {
+      field.push_back(c);
+    }
+  }
+  end_field();
+  return true;
+}
+
+/** Create an index whose keys are memcmp-encoded into `KeySize` bytes. */
+template <size_t KeySize>
+static auto CreateMemcmpIndex(Catalog *catalog, Transaction *txn, const IndexStatement &stmt, const Schema &key_schema,
+                              const std::vector<uint32_t> &col_ids, IndexType index_type) -> IndexInfo * {
+  return catalog->CreateIndex<MemcmpKey<KeySize>, RID, MemcmpComparator<KeySize>>(
+      txn, stmt.index_name_, stmt.table_->table_, stmt.table_->schema_, key_schema, col_ids, KeySize,
+      HashFunction<MemcmpKey<KeySize>>{}, index_type, stmt.include_cols_.size());
+}
+
 void BustubInstance::HandleCreateStatement(Transaction *txn, const CreateStatement &stmt, ResultWriter &writer) {
   std::unique_lock<std::shared_mutex> l(catalog_lock_);
-  auto info = catalog_->CreateTable(txn, stmt.table_, Schema(stmt.columns_));
+  auto info = catalog_->CreateTable(txn, stmt.table_, Schema(stmt.columns_), true, stmt.layout_);
   l.unlock();
 
   if (info == nullptr) {
@@ -52,29 +140,55 @@ void BustubInstance::HandleCreateStatement(Transaction *txn, const CreateStateme
 }
 
 void BustubInstance::HandleIndexStatement(Transaction *txn, const IndexStatement &stmt, ResultWriter &writer) {
+  if (stmt.cols_.empty()) {
+    throw NotImplementedException("index should have at least one column");
+  }
+  // Included columns are stored after the searched ones, so the key schema covers both.
   std::vector<uint32_t> col_ids;
-  for (const auto &col : stmt.cols_) {
-    auto idx = stmt.table_->schema_.GetColIdx(col->col_name_.back());
-    col_ids.push_back(idx);
-    if (stmt.table_->schema_.GetColumn(idx).GetType() != TypeId::INTEGER) {
-      throw NotImplementedException("only support creating index on integer column");
+  for (const auto *cols : {&stmt.cols_, &stmt.include_cols_}) {
+    for (const auto &col : *cols) {
+      auto idx = stmt.table_->schema_.GetColIdx(col->col_name_.back());
+      col_ids.push_back(idx);
+      if (!MemcmpKeyEncoder::IsEncodable(stmt.table_->schema_.GetColumn(idx).GetType())) {
+        throw NotImplementedException(fmt::format(
+            "cannot create index on {} column", Type::TypeIdToString(stmt.table_->schema_.GetColumn(idx).GetType())));
+      }
     }
   }
   auto key_schema = Schema::CopySchema(&stmt.table_->schema_, col_ids);
 
-  // TODO(spring2023): If you want to support composite index key for leaderboard optimization, remove this assertion
-  // and create index with different key type that can hold multiple keys based on number of index columns.
-  //
-  // You can also create clustered index that directly stores value inside the index by modifying the value type.
+  // `art` is the parser's default access method when no `USING` clause is given.
+  auto index_type = IndexType::BPlusTreeIndex;
+  if (stmt.index_type_ == "hash") {
+    index_type = IndexType::HashTableIndex;
+  } else if (!(stmt.index_type_.empty() || stmt.index_type_ == "art" || stmt.index_type_ == "btree")) {
+    throw NotImplementedException(fmt::format("unsupported index type {}", stmt.index_type_));
+  }
+  if (index_type == IndexType::HashTableIndex && !stmt.include_cols_.empty()) {
+    throw NotImplementedException("only B+ tree indexes can include columns");
+  }
 
-  if (col_ids.empty() || col_ids.size() > 2) {
-    throw NotImplementedException("only support creating index with exactly one or two columns");
+  // Keys are encoded so that they compare with memcmp; pick the smallest key type that holds the encoding. A B+ tree
+  // appends the RID to the key of each entry, so that rows with equal columns are all kept.
+  auto key_size = MemcmpKeyEncoder::EncodedSize(key_schema);
+  if (index_type == IndexType::BPlusTreeIndex) {
+    key_size += MemcmpKeyEncoder::RID_SIZE;
+  }
+  if (key_size > 64) {
+    throw NotImplementedException(fmt::format("index key of {} bytes is too wide, at most 64 bytes", key_size));
   }
 
   std::unique_lock<std::shared_mutex> l(catalog_lock_);
-  auto info = catalog_->CreateIndex<IntegerKeyType, IntegerValueType, IntegerComparatorType>(
-      txn, stmt.index_name_, stmt.table_->table_, stmt.table_->schema_, key_schema, col_ids, TWO_INTEGER_SIZE,
-      IntegerHashFunctionType{});
+  IndexInfo *info;
+  if (key_size <= 8) {
+    info = CreateMemcmpIndex<8>(catalog_, txn, stmt, key_schema, col_ids, index_type);
+  } else if (key_size <= 16) {
+    info = CreateMemcmpIndex<16>(catalog_, txn, stmt, key_schema, col_ids, index_type);
+  } else if (key_size <= 32) {
+    info = CreateMemcmpIndex<32>(catalog_, txn, stmt, key_schema, col_ids, index_type);
+  } else {
+    info = CreateMemcmpIndex<64>(catalog_, txn, stmt, key_schema, col_ids, index_type);
+  }
   l.unlock();
 
   if (info == nullptr) {
@@ -136,4 +250,104 @@ void BustubInstance::HandleVariableSetStatement(Transaction *txn, const Variable
   session_variables_[stmt.variable_] = stmt.value_;
 }
 
+void BustubInstance::HandleVacuumStatement(Transaction *txn, const VacuumStatement &stmt, ResultWriter &writer) {
+  std::unique_lock<std::shared_mutex> l(catalog_lock_);
+  std::vector<std::string> table_names;
+  if (stmt.table_ != nullptr) {
+    table_names.push_back(stmt.table_->table_);
+  } else {
+    table_names = catalog_->GetTableNames();
+  }
+
+  size_t released_pages = 0;
+  for (const auto &table_name : table_names) {
+    auto *table_info = catalog_->GetTable(table_name);
+    if (table_info->table_ == nullptr) {
+      continue;
+    }
+    auto indexes = catalog_->GetTableIndexes(table_name);
+    // a moved tuple keeps its index entries pointing to it
+    released_pages += table_info->table_->Vacuum([&](const Tuple &tuple, RID old_rid, RID new_rid) {
+      for (auto *index_info : indexes) {
+        auto key = tuple.KeyFromTuple(table_info->schema_, index_info->key_schema_, index_info->index_->GetKeyAttrs());
+        index_info->index_->DeleteEntry(key, old_rid, txn);
+        index_info->index_->InsertEntry(key, new_rid, txn);
+      }
+    });
+  }
+  l.unlock();
+
+  WriteOneCell(fmt::format("Vacuum released {} pages", released_pages), writer);
+}
+
+void BustubInstance::HandleCopyStatement(Transaction *txn, const CopyStatement &stmt, ResultWriter &writer) {
+  std::ifstream file(stmt.file_path_);
+  if (!file.is_open()) {
+    throw bustub::Exception(fmt::format("COPY: cannot open {}", stmt.file_path_));
+  }
+
+  std::shared_lock<std::shared_mutex> l(catalog_lock_);
+  auto *table_info = catalog_->GetTable(stmt.table_->table_);
+  auto indexes = catalog_->GetTableIndexes(stmt.table_->table_);
+  l.unlock();
+  if (table_info == nullptr || table_info->table_ == nullptr) {
+    throw bustub::Exception(fmt::format("COPY: cannot load into {}", stmt.table_->table_));
+  }
+  const auto &schema = table_info->schema_;
+
+  // Rows go in batches, so that the table heap fills whole pages at once and each index takes its entries sorted.
+  std::vector<Tuple> batch;
+  size_t row_count = 0;
+  auto flush = [&]() {
+    auto rids = table_info->table_->InsertTuples(TupleMeta{}, batch);
+    for (auto *index_info : indexes) {
+      std::vector<std::pair<Tuple, RID>> entries;
+      entries.reserve(rids.size());
+      for (size_t i = 0; i < rids.size(); i++) {
+        entries.emplace_back(
+            batch[i].KeyFromTuple(schema, index_info->key_schema_, index_info->index_->GetKeyAttrs()), rids[i]);
+      }
+      index_info->index_->InsertEntries(entries, txn);
+    }
+    row_count += rids.size();
+    batch.clear();
+  };
+
+  std::vector<std::optional<std::string>> fields;
+  std::vector<Value> values;
+  size_t line_number = 0;
+  bool is_header = stmt.header_;
+  while (ReadCsvRecord(file, stmt.delimiter_, &fields, &line_number)) {
+    if (is_header) {
+      is_header = false;
+      continue;
+    }
+    if (fields.size() != schema.GetColumnCount()) {
+      throw bustub::Exception(fmt::format("COPY: line {} has {} fields, expected {}", line_number, fields.size(),
+                                          schema.GetColumnCount()));
+    }
+    values.clear();
+    for (uint32_t i = 0; i < fields.size(); i++) {
+      auto type = schema.GetColumn(i).GetType();
+      if (!fields[i].has_value()) {
+        values.push_back(ValueFactory::GetNullValueByType(type));
+        continue;
+      }
+      try {
+        values.push_back(ValueFactory::GetVarcharValue(*fields[i]).CastAs(type));
+      } catch (const std::exception &e) {
+        throw bustub::Exception(fmt::format("COPY: line {}: invalid value '{}' for column {}", line_number, *fields[i],
+                                            schema.GetColumn(i).GetName()));
+      }
+    }
+    batch.emplace_back(values, &schema);
+    if (batch.size() == COPY_BATCH_SIZE) {
+      flush();
+    }
+  }
+  flush();
+
+  WriteOneCell(fmt::format("Copied {} rows", row_count), writer);
+}
+
 }  // namespace bustub
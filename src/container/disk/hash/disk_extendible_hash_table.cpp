@@ -19,6 +19,7 @@
 #include "common/logger.h"
 #include "common/rid.h"
 #include "container/disk/hash/disk_extendible_hash_table.h"
+#include "storage/index/memcmp_key.h"
 
 namespace bustub {
 
@@ -26,7 +27,22 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 HASH_TABLE_TYPE::DiskExtendibleHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
                                          const KeyComparator &comparator, HashFunction<KeyType> hash_fn)
     : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
-  //  implement me!
+  Page *dir_raw = buffer_pool_manager_->NewPage(&directory_page_id_);
+  if (dir_raw == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "Cannot allocate hash table directory page");
+  }
+  auto dir_page = reinterpret_cast<HashTableDirectoryPage *>(dir_raw->GetData());
+  dir_page->SetPageId(directory_page_id_);
+
+  page_id_t bucket_page_id;
+  if (buffer_pool_manager_->NewPage(&bucket_page_id) == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "Cannot allocate hash table bucket page");
+  }
+  dir_page->SetBucketPageId(0, bucket_page_id);
+  dir_page->SetLocalDepth(0, 0);
+
+  buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+  buffer_pool_manager_->UnpinPage(directory_page_id_, true);
 }
 
 /*****************************************************************************
@@ -46,22 +62,52 @@ auto HASH_TABLE_TYPE::Hash(KeyType key) -> uint32_t {
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 inline auto HASH_TABLE_TYPE::KeyToDirectoryIndex(KeyType key, HashTableDirectoryPage *dir_page) -> uint32_t {
-  return 0;
+  return Hash(key) & dir_page->GetGlobalDepthMask();
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 inline auto HASH_TABLE_TYPE::KeyToPageId(KeyType key, HashTableDirectoryPage *dir_page) -> page_id_t {
-  return 0;
+  return dir_page->GetBucketPageId(KeyToDirectoryIndex(key, dir_page));
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::FetchPage(page_id_t page_id) -> Page * {
+  Page *page = buffer_pool_manager_->FetchPage(page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "Cannot fetch hash table page");
+  }
+  return page;
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::FetchDirectoryPage() -> HashTableDirectoryPage * {
-  return nullptr;
+  return reinterpret_cast<HashTableDirectoryPage *>(FetchPage(directory_page_id_)->GetData());
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BUCKET_TYPE * {
-  return nullptr;
+  return reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(FetchPage(bucket_page_id)->GetData());
+}
+
+/*
+ * Latch coupling from the directory to a bucket: the bucket latch is always taken while the directory latch is
+ * still held, so a split or merge (which holds the directory write latch) can never leave a concurrent operation
+ * with a stale bucket page id.
+ */
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::FetchBucketLatched(const KeyType &key, bool exclusive) -> Page * {
+  Page *dir_raw = FetchPage(directory_page_id_);
+  dir_raw->RLatch();
+  page_id_t bucket_page_id = KeyToPageId(key, reinterpret_cast<HashTableDirectoryPage *>(dir_raw->GetData()));
+  Page *bucket_raw = FetchPage(bucket_page_id);
+  if (exclusive) {
+    bucket_raw->WLatch();
+  } else {
+    bucket_raw->RLatch();
+  }
+  dir_raw->RUnlatch();
+  buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+  return bucket_raw;
 }
 
 /*****************************************************************************
@@ -69,7 +115,14 @@ auto HASH_TABLE_TYPE::FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BU
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool {
-  return false;
+  table_latch_.RLock();
+  Page *bucket_raw = FetchBucketLatched(key, false);
+  auto bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(bucket_raw->GetData());
+  bool found = bucket->GetValue(key, comparator_, result);
+  bucket_raw->RUnlatch();
+  buffer_pool_manager_->UnpinPage(bucket_raw->GetPageId(), false);
+  table_latch_.RUnlock();
+  return found;
 }
 
 /*****************************************************************************
@@ -77,12 +130,110 @@ auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.RLock();
+  Page *bucket_raw = FetchBucketLatched(key, true);
+  auto bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(bucket_raw->GetData());
+  page_id_t bucket_page_id = bucket_raw->GetPageId();
+  if (!bucket->IsFull()) {
+    bool inserted = bucket->Insert(key, value, comparator_);
+    bucket_raw->WUnlatch();
+    buffer_pool_manager_->UnpinPage(bucket_page_id, inserted);
+    table_latch_.RUnlock();
+    return inserted;
+  }
+  bucket_raw->WUnlatch();
+  buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+  table_latch_.RUnlock();
+  return SplitInsert(transaction, key, value);
 }
 
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  while (true) {
+    table_latch_.RLock();
+    Page *dir_raw = FetchPage(directory_page_id_);
+    dir_raw->WLatch();
+    auto dir_page = reinterpret_cast<HashTableDirectoryPage *>(dir_raw->GetData());
+    uint32_t bucket_idx = KeyToDirectoryIndex(key, dir_page);
+    page_id_t bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+    Page *bucket_raw = FetchPage(bucket_page_id);
+    bucket_raw->WLatch();
+    auto bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(bucket_raw->GetData());
+
+    // someone else split or drained the bucket while we were waiting for the directory
+    if (!bucket->IsFull()) {
+      dir_raw->WUnlatch();
+      buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+      bool inserted = bucket->Insert(key, value, comparator_);
+      bucket_raw->WUnlatch();
+      buffer_pool_manager_->UnpinPage(bucket_page_id, inserted);
+      table_latch_.RUnlock();
+      return inserted;
+    }
+
+    uint32_t local_depth = dir_page->GetLocalDepth(bucket_idx);
+    uint32_t global_depth = dir_page->GetGlobalDepth();
+    if (local_depth == global_depth) {
+      bool can_grow = dir_page->Size() * 2 <= DIRECTORY_ARRAY_SIZE;
+      bucket_raw->WUnlatch();
+      buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+      dir_raw->WUnlatch();
+      buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+      table_latch_.RUnlock();
+      if (!can_grow) {
+        return false;
+      }
+      GrowDirectory(global_depth);
+      continue;
+    }
+
+    // split the bucket into its image; the directory keeps its size so other buckets stay available
+    page_id_t image_page_id;
+    Page *image_raw = buffer_pool_manager_->NewPage(&image_page_id);
+    if (image_raw == nullptr) {
+      bucket_raw->WUnlatch();
+      buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+      dir_raw->WUnlatch();
+      buffer_pool_manager_->UnpinPage(directory_page_id_, false);
+      table_latch_.RUnlock();
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "Cannot allocate hash table bucket page");
+    }
+    auto image = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(image_raw->GetData());
+    uint32_t high_bit = 1U << local_depth;
+    for (uint32_t idx = 0; idx < dir_page->Size(); idx++) {
+      if (dir_page->GetBucketPageId(idx) == bucket_page_id) {
+        dir_page->IncrLocalDepth(idx);
+        if ((idx & high_bit) != 0) {
+          dir_page->SetBucketPageId(idx, image_page_id);
+        }
+      }
+    }
+    for (uint32_t slot = 0; slot < BUCKET_ARRAY_SIZE; slot++) {
+      if (bucket->IsReadable(slot) && (Hash(bucket->KeyAt(slot)) & high_bit) != 0) {
+        image->Insert(bucket->KeyAt(slot), bucket->ValueAt(slot), comparator_);
+        bucket->RemoveAt(slot);
+      }
+    }
+    buffer_pool_manager_->UnpinPage(image_page_id, true);
+    bucket_raw->WUnlatch();
+    buffer_pool_manager_->UnpinPage(bucket_page_id, true);
+    dir_raw->WUnlatch();
+    buffer_pool_manager_->UnpinPage(directory_page_id_, true);
+    table_latch_.RUnlock();
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::GrowDirectory(uint32_t global_depth) {
+  table_latch_.WLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  // another inserter may have grown the directory before we got here
+  bool grow = dir_page->GetGlobalDepth() == global_depth;
+  if (grow) {
+    dir_page->IncrGlobalDepth();
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, grow);
+  table_latch_.WUnlock();
 }
 
 /*****************************************************************************
@@ -90,14 +241,76 @@ auto HASH_TABLE_TYPE::SplitInsert(Transaction *transaction, const KeyType &key,
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
-  return false;
+  table_latch_.RLock();
+  Page *bucket_raw = FetchBucketLatched(key, true);
+  auto bucket = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(bucket_raw->GetData());
+  page_id_t bucket_page_id = bucket_raw->GetPageId();
+  bool removed = bucket->Remove(key, value, comparator_);
+  bool empty = removed && bucket->IsEmpty();
+  bucket_raw->WUnlatch();
+  buffer_pool_manager_->UnpinPage(bucket_page_id, removed);
+  table_latch_.RUnlock();
+  if (empty) {
+    Merge(transaction, key, value);
+  }
+  return removed;
 }
 
 /*****************************************************************************
  * MERGE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const ValueType &value) {}
+void HASH_TABLE_TYPE::Merge(Transaction *transaction, const KeyType &key, const ValueType &value) {
+  table_latch_.RLock();
+  Page *dir_raw = FetchPage(directory_page_id_);
+  dir_raw->WLatch();
+  auto dir_page = reinterpret_cast<HashTableDirectoryPage *>(dir_raw->GetData());
+  uint32_t bucket_idx = KeyToDirectoryIndex(key, dir_page);
+  page_id_t bucket_page_id = dir_page->GetBucketPageId(bucket_idx);
+  uint32_t local_depth = dir_page->GetLocalDepth(bucket_idx);
+  uint32_t image_idx = dir_page->GetSplitImageIndex(bucket_idx);
+
+  Page *bucket_raw = FetchPage(bucket_page_id);
+  bucket_raw->RLatch();
+  bool empty = reinterpret_cast<HASH_TABLE_BUCKET_TYPE *>(bucket_raw->GetData())->IsEmpty();
+  bucket_raw->RUnlatch();
+  buffer_pool_manager_->UnpinPage(bucket_page_id, false);
+
+  bool merge = empty && local_depth > 0 && dir_page->GetLocalDepth(image_idx) == local_depth;
+  bool shrink = false;
+  if (merge) {
+    page_id_t image_page_id = dir_page->GetBucketPageId(image_idx);
+    for (uint32_t idx = 0; idx < dir_page->Size(); idx++) {
+      page_id_t page_id = dir_page->GetBucketPageId(idx);
+      if (page_id == bucket_page_id || page_id == image_page_id) {
+        dir_page->SetBucketPageId(idx, image_page_id);
+        dir_page->DecrLocalDepth(idx);
+      }
+    }
+    // nobody can reach the bucket any more once the directory no longer points at it
+    buffer_pool_manager_->DeletePage(bucket_page_id);
+    shrink = dir_page->CanShrink();
+  }
+  dir_raw->WUnlatch();
+  buffer_pool_manager_->UnpinPage(directory_page_id_, merge);
+  table_latch_.RUnlock();
+  if (shrink) {
+    ShrinkDirectory();
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::ShrinkDirectory() {
+  table_latch_.WLock();
+  HashTableDirectoryPage *dir_page = FetchDirectoryPage();
+  bool shrunk = false;
+  while (dir_page->CanShrink()) {
+    dir_page->DecrGlobalDepth();
+    shrunk = true;
+  }
+  buffer_pool_manager_->UnpinPage(directory_page_id_, shrunk);
+  table_latch_.WUnlock();
+}
 
 /*****************************************************************************
  * GETGLOBALDEPTH - DO NOT TOUCH
@@ -135,4 +348,9 @@ template class DiskExtendibleHashTable<GenericKey<16>, RID, GenericComparator<16
 template class DiskExtendibleHashTable<GenericKey<32>, RID, GenericComparator<32>>;
 template class DiskExtendibleHashTable<GenericKey<64>, RID, GenericComparator<64>>;
 
+template class DiskExtendibleHashTable<MemcmpKey<8>, RID, MemcmpComparator<8>>;
+template class DiskExtendibleHashTable<MemcmpKey<16>, RID, MemcmpComparator<16>>;
+template class DiskExtendibleHashTable<MemcmpKey<32>, RID, MemcmpComparator<32>>;
+template class DiskExtendibleHashTable<MemcmpKey<64>, RID, MemcmpComparator<64>>;
+
 }  // namespace bustub
@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -17,6 +19,7 @@
 
 #include "common/exception.h"
 #include "common/logger.h"
+#include "common/macros.h"
 #include "common/rid.h"
 #include "container/disk/hash/linear_probe_hash_table.h"
 
@@ -26,20 +29,103 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 HASH_TABLE_TYPE::LinearProbeHashTable(const std::string &name, BufferPoolManager *buffer_pool_manager,
                                       const KeyComparator &comparator, size_t num_buckets,
                                       HashFunction<KeyType> hash_fn)
-    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {}
+    : buffer_pool_manager_(buffer_pool_manager), comparator_(comparator), hash_fn_(std::move(hash_fn)) {
+  size_t num_blocks = std::max<size_t>(1, (num_buckets + BLOCK_ARRAY_SIZE - 1) / BLOCK_ARRAY_SIZE);
+  header_page_id_ = CreateHeaderPage(std::min(num_blocks, HEADER_PAGE_BLOCK_CAPACITY));
+}
 
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool {
-  return false;
+  table_latch_.RLock();
+  bool found = ProbeGetValue(header_page_id_, key, result);
+  if (new_header_page_id_ != INVALID_PAGE_ID) {
+    // migrated entries are tombstones in the old table, so nothing is reported twice
+    found = ProbeGetValue(new_header_page_id_, key, result) || found;
+  }
+  table_latch_.RUnlock();
+  return found;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::ProbeGetValue(page_id_t header_page_id, const KeyType &key, std::vector<ValueType> *result)
+    -> bool {
+  // the header page never changes after it is created
+  auto header_guard = buffer_pool_manager_->FetchPageBasic(header_page_id);
+  auto header_page = header_guard.template As<HashTableHeaderPage>();
+  size_t num_buckets = header_page->GetSize();
+  size_t bucket = hash_fn_.GetHash(key) % num_buckets;
+  bool found = false;
+  for (size_t probed = 0; probed < num_buckets;) {
+    auto block_guard = buffer_pool_manager_->FetchPageRead(header_page->GetBlockPageId(bucket / BLOCK_ARRAY_SIZE));
+    auto block = block_guard.template As<HASH_TABLE_BLOCK_TYPE>();
+    for (slot_offset_t offset = bucket % BLOCK_ARRAY_SIZE; offset < BLOCK_ARRAY_SIZE && probed < num_buckets;
+         offset++, probed++) {
+      if (!block->IsOccupied(offset)) {
+        return found;
+      }
+      if (block->IsReadable(offset) && comparator_(key, block->KeyAt(offset)) == 0) {
+        result->push_back(block->ValueAt(offset));
+        found = true;
+      }
+    }
+    bucket = (bucket / BLOCK_ARRAY_SIZE + 1) * BLOCK_ARRAY_SIZE % num_buckets;
+  }
+  return found;
 }
+
 /*****************************************************************************
  * INSERTION
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
+  MaybeMigrate();
+  table_latch_.RLock();
+  bool inserted;
+  if (new_header_page_id_ != INVALID_PAGE_ID) {
+    // the pair may still live in a block that has not been migrated yet
+    std::vector<ValueType> old_values;
+    ProbeGetValue(header_page_id_, key, &old_values);
+    inserted = std::find(old_values.begin(), old_values.end(), value) == old_values.end() &&
+               ProbeInsert(new_header_page_id_, key, value);
+  } else {
+    inserted = ProbeInsert(header_page_id_, key, value);
+  }
+  table_latch_.RUnlock();
+  if (inserted) {
+    MaybeStartResize();
+  }
+  return inserted;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::ProbeInsert(page_id_t header_page_id, const KeyType &key, const ValueType &value) -> bool {
+  auto header_guard = buffer_pool_manager_->FetchPageBasic(header_page_id);
+  auto header_page = header_guard.template As<HashTableHeaderPage>();
+  size_t num_buckets = header_page->GetSize();
+  size_t bucket = hash_fn_.GetHash(key) % num_buckets;
+  for (size_t probed = 0; probed < num_buckets;) {
+    auto block_guard = buffer_pool_manager_->FetchPageWrite(header_page->GetBlockPageId(bucket / BLOCK_ARRAY_SIZE));
+    auto block = block_guard.template AsMut<HASH_TABLE_BLOCK_TYPE>();
+    for (slot_offset_t offset = bucket % BLOCK_ARRAY_SIZE; offset < BLOCK_ARRAY_SIZE && probed < num_buckets;
+         offset++, probed++) {
+      // tombstones are never reused, so every copy of the key sits before the first free slot
+      if (!block->IsOccupied(offset)) {
+        block->Insert(offset, key, value);
+        num_occupied_++;
+        num_readable_++;
+        return true;
+      }
+      if (block->IsReadable(offset) && comparator_(key, block->KeyAt(offset)) == 0 &&
+          block->ValueAt(offset) == value) {
+        return false;
+      }
+    }
+    bucket = (bucket / BLOCK_ARRAY_SIZE + 1) * BLOCK_ARRAY_SIZE % num_buckets;
+  }
+  // full; the load factor check normally grows the table long before this
   return false;
 }
 
@@ -48,6 +134,48 @@ auto HASH_TABLE_TYPE::Insert(Transaction *transaction, const KeyType &key, const
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const ValueType &value) -> bool {
+  MaybeMigrate();
+  table_latch_.RLock();
+  bool removed;
+  if (new_header_page_id_ != INVALID_PAGE_ID) {
+    removed = ProbeRemove(new_header_page_id_, key, value);
+    if (removed) {
+      num_readable_--;
+    } else {
+      removed = ProbeRemove(header_page_id_, key, value);
+    }
+  } else {
+    removed = ProbeRemove(header_page_id_, key, value);
+    if (removed) {
+      num_readable_--;
+    }
+  }
+  table_latch_.RUnlock();
+  return removed;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::ProbeRemove(page_id_t header_page_id, const KeyType &key, const ValueType &value) -> bool {
+  auto header_guard = buffer_pool_manager_->FetchPageBasic(header_page_id);
+  auto header_page = header_guard.template As<HashTableHeaderPage>();
+  size_t num_buckets = header_page->GetSize();
+  size_t bucket = hash_fn_.GetHash(key) % num_buckets;
+  for (size_t probed = 0; probed < num_buckets;) {
+    auto block_guard = buffer_pool_manager_->FetchPageWrite(header_page->GetBlockPageId(bucket / BLOCK_ARRAY_SIZE));
+    auto block = block_guard.template AsMut<HASH_TABLE_BLOCK_TYPE>();
+    for (slot_offset_t offset = bucket % BLOCK_ARRAY_SIZE; offset < BLOCK_ARRAY_SIZE && probed < num_buckets;
+         offset++, probed++) {
+      if (!block->IsOccupied(offset)) {
+        return false;
+      }
+      if (block->IsReadable(offset) && comparator_(key, block->KeyAt(offset)) == 0 &&
+          block->ValueAt(offset) == value) {
+        block->Remove(offset);
+        return true;
+      }
+    }
+    bucket = (bucket / BLOCK_ARRAY_SIZE + 1) * BLOCK_ARRAY_SIZE % num_buckets;
+  }
   return false;
 }
 
@@ -55,14 +183,180 @@ auto HASH_TABLE_TYPE::Remove(Transaction *transaction, const KeyType &key, const
  * RESIZE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
-void HASH_TABLE_TYPE::Resize(size_t initial_size) {}
+void HASH_TABLE_TYPE::Resize(size_t initial_size) {
+  table_latch_.WLock();
+  if (new_header_page_id_ != INVALID_PAGE_ID) {
+    MigrateBlocks(HEADER_PAGE_BLOCK_CAPACITY);
+  }
+  size_t num_blocks = (2 * initial_size + BLOCK_ARRAY_SIZE - 1) / BLOCK_ARRAY_SIZE;
+  StartResize(std::clamp<size_t>(num_blocks, 1, HEADER_PAGE_BLOCK_CAPACITY));
+  table_latch_.WUnlock();
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::MaybeStartResize() {
+  table_latch_.RLock();
+  bool idle = new_header_page_id_ == INVALID_PAGE_ID;
+  page_id_t observed_header_page_id = header_page_id_;
+  auto header_guard = buffer_pool_manager_->FetchPageBasic(header_page_id_);
+  size_t num_blocks = header_guard.template As<HashTableHeaderPage>()->NumBlocks();
+  header_guard.Drop();
+  table_latch_.RUnlock();
+  // keep probe chains short: act once three quarters of the slots are taken
+  if (!idle || num_occupied_ * 4 < num_blocks * BLOCK_ARRAY_SIZE * 3) {
+    return;
+  }
+
+  table_latch_.WLock();
+  // the table may have been resized since the check above
+  if (new_header_page_id_ == INVALID_PAGE_ID && header_page_id_ == observed_header_page_id &&
+      num_occupied_ * 4 >= num_blocks * BLOCK_ARRAY_SIZE * 3) {
+    if (num_readable_ * 2 < num_occupied_) {
+      // mostly tombstones: rebuild at the same size to compact them
+      StartResize(num_blocks);
+    } else if (num_blocks < HEADER_PAGE_BLOCK_CAPACITY) {
+      StartResize(std::min(num_blocks * 2, HEADER_PAGE_BLOCK_CAPACITY));
+    } else if (num_readable_ < num_occupied_) {
+      StartResize(num_blocks);
+    }
+  }
+  table_latch_.WUnlock();
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::StartResize(size_t num_blocks) {
+  new_header_page_id_ = CreateHeaderPage(num_blocks);
+  next_migrate_block_ = 0;
+  num_occupied_ = 0;
+  num_readable_ = 0;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::MaybeMigrate() {
+  table_latch_.RLock();
+  bool resizing = new_header_page_id_ != INVALID_PAGE_ID;
+  table_latch_.RUnlock();
+  if (!resizing) {
+    return;
+  }
+  table_latch_.WLock();
+  if (new_header_page_id_ != INVALID_PAGE_ID) {
+    MigrateBlocks(MIGRATE_BLOCKS_PER_OP);
+  }
+  table_latch_.WUnlock();
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::MigrateBlocks(size_t max_blocks) {
+  auto old_header_guard = buffer_pool_manager_->FetchPageBasic(header_page_id_);
+  auto old_header_page = old_header_guard.template AsMut<HashTableHeaderPage>();
+  auto new_header_guard = buffer_pool_manager_->FetchPageBasic(new_header_page_id_);
+  auto new_header_page = new_header_guard.template AsMut<HashTableHeaderPage>();
+
+  size_t end = std::min(old_header_page->NumBlocks(), next_migrate_block_ + max_blocks);
+  for (; next_migrate_block_ < end; next_migrate_block_++) {
+    auto block_guard = buffer_pool_manager_->FetchPageBasic(old_header_page->GetBlockPageId(next_migrate_block_));
+    auto block = block_guard.template AsMut<HASH_TABLE_BLOCK_TYPE>();
+    for (slot_offset_t offset = 0; offset < BLOCK_ARRAY_SIZE; offset++) {
+      if (block->IsReadable(offset)) {
+        ResizeInsert(new_header_page, block->KeyAt(offset), block->ValueAt(offset));
+        block->Remove(offset);
+      }
+    }
+  }
+  if (next_migrate_block_ < old_header_page->NumBlocks()) {
+    return;
+  }
+
+  // every entry has moved: retire the old table
+  DeleteBlockPages(old_header_page);
+  old_header_guard.Drop();
+  buffer_pool_manager_->DeletePage(header_page_id_);
+  header_page_id_ = new_header_page_id_;
+  new_header_page_id_ = INVALID_PAGE_ID;
+  next_migrate_block_ = 0;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::ResizeInsert(HashTableHeaderPage *header_page, const KeyType &key, const ValueType &value) {
+  size_t num_buckets = header_page->GetSize();
+  size_t bucket = hash_fn_.GetHash(key) % num_buckets;
+  for (size_t probed = 0; probed < num_buckets;) {
+    auto block_guard = buffer_pool_manager_->FetchPageBasic(header_page->GetBlockPageId(bucket / BLOCK_ARRAY_SIZE));
+    auto block = block_guard.template AsMut<HASH_TABLE_BLOCK_TYPE>();
+    for (slot_offset_t offset = bucket % BLOCK_ARRAY_SIZE; offset < BLOCK_ARRAY_SIZE && probed < num_buckets;
+         offset++, probed++) {
+      if (block->Insert(offset, key, value)) {
+        num_occupied_++;
+        num_readable_++;
+        return;
+      }
+    }
+    bucket = (bucket / BLOCK_ARRAY_SIZE + 1) * BLOCK_ARRAY_SIZE % num_buckets;
+  }
+  BUSTUB_ASSERT(false, "resize target cannot hold the migrated entries");
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::CreateHeaderPage(size_t num_blocks) -> page_id_t {
+  page_id_t header_page_id;
+  Page *page = buffer_pool_manager_->NewPage(&header_page_id);
+  if (page == nullptr) {
+    throw Exception(ExceptionType::OUT_OF_MEMORY, "Cannot allocate hash table header page");
+  }
+  page->WLatch();
+  std::memset(page->GetData(), 0, BUSTUB_PAGE_SIZE);
+  auto header_page = reinterpret_cast<HashTableHeaderPage *>(page->GetData());
+  header_page->SetPageId(header_page_id);
+  header_page->SetSize(num_blocks * BLOCK_ARRAY_SIZE);
+  CreateNewBlockPages(header_page, num_blocks);
+  page->WUnlatch();
+  buffer_pool_manager_->UnpinPage(header_page_id, true);
+  return header_page_id;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::CreateNewBlockPages(HashTableHeaderPage *header_page, size_t num_blocks) {
+  for (size_t i = 0; i < num_blocks; i++) {
+    page_id_t block_page_id;
+    Page *page = buffer_pool_manager_->NewPage(&block_page_id);
+    if (page == nullptr) {
+      throw Exception(ExceptionType::OUT_OF_MEMORY, "Cannot allocate hash table block page");
+    }
+    // a recycled frame is not guaranteed to come back zeroed, and the bitmaps must start empty
+    std::memset(page->GetData(), 0, BUSTUB_PAGE_SIZE);
+    header_page->AddBlockPageId(block_page_id);
+    buffer_pool_manager_->UnpinPage(block_page_id, true);
+  }
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+void HASH_TABLE_TYPE::DeleteBlockPages(HashTableHeaderPage *old_header_page) {
+  for (size_t i = 0; i < old_header_page->NumBlocks(); i++) {
+    buffer_pool_manager_->DeletePage(old_header_page->GetBlockPageId(i));
+  }
+}
 
 /*****************************************************************************
  * GETSIZE
  *****************************************************************************/
 template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_TYPE::GetSize() -> size_t {
-  return 0;
+  table_latch_.RLock();
+  auto header_guard = buffer_pool_manager_->FetchPageBasic(
+      new_header_page_id_ != INVALID_PAGE_ID ? new_header_page_id_ : header_page_id_);
+  size_t size = header_guard.template As<HashTableHeaderPage>()->GetSize();
+  header_guard.Drop();
+  table_latch_.RUnlock();
+  return size;
+}
+
+template <typename KeyType, typename ValueType, typename KeyComparator>
+auto HASH_TABLE_TYPE::IsResizing() -> bool {
+  table_latch_.RLock();
+  bool resizing = new_header_page_id_ != INVALID_PAGE_ID;
+  table_latch_.RUnlock();
+  return resizing;
 }
 
 template class LinearProbeHashTable<int, int, IntComparator>;
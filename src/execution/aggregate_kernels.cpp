@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregate_kernels.cpp
+//
+// Identification: src/execution/aggregate_kernels.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/aggregate_kernels.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace bustub {
+
+/** Gather the values of a column all of type `type`, read as `T`, @return `false` if some value is of another type */
+template <typename T>
+static auto GatherAs(const std::vector<Value> &column, TypeId type, int64_t *values, uint8_t *nulls) -> bool {
+  for (size_t row = 0; row < column.size(); row++) {
+    const auto &value = column[row];
+    if (value.GetTypeId() != type) {
+      return false;
+    }
+    nulls[row] = static_cast<uint8_t>(value.IsNull());
+    values[row] = value.IsNull() ? 0 : value.GetAs<T>();
+  }
+  return true;
+}
+
+auto IsKernelInteger(TypeId type) -> bool {
+  return type == TypeId::TINYINT || type == TypeId::SMALLINT || type == TypeId::INTEGER || type == TypeId::BIGINT;
+}
+
+auto GatherIntegers(const std::vector<Value> &column, TypeId type, std::vector<int64_t> *values,
+                    std::vector<uint8_t> *nulls) -> bool {
+  values->resize(column.size());
+  nulls->resize(column.size());
+  // the type is switched on once per column, not once per row
+  switch (type) {
+    case TypeId::TINYINT:
+      return GatherAs<int8_t>(column, type, values->data(), nulls->data());
+    case TypeId::SMALLINT:
+      return GatherAs<int16_t>(column, type, values->data(), nulls->data());
+    case TypeId::INTEGER:
+      return GatherAs<int32_t>(column, type, values->data(), nulls->data());
+    case TypeId::BIGINT:
+      return GatherAs<int64_t>(column, type, values->data(), nulls->data());
+    default:
+      return false;
+  }
+}
+
+auto CountKernel(const uint8_t *nulls, size_t size) -> int64_t {
+  int64_t count = 0;
+  for (size_t i = 0; i < size; i++) {
+    count += 1 - nulls[i];
+  }
+  return count;
+}
+
+auto SumKernel(const int64_t *values, const uint8_t *nulls, size_t size) -> int64_t {
+  // a null row is gathered as 0, so that only the values are added up; unsigned, to wrap around rather than overflow
+  uint64_t sum = 0;
+  for (size_t i = 0; i < size; i++) {
+    sum += static_cast<uint64_t>(values[i]);
+  }
+  return static_cast<int64_t>(sum);
+}
+
+auto MinKernel(const int64_t *values, const uint8_t *nulls, size_t size) -> int64_t {
+  int64_t min = std::numeric_limits<int64_t>::max();
+  for (size_t i = 0; i < size; i++) {
+    min = std::min(min, nulls[i] != 0 ? std::numeric_limits<int64_t>::max() : values[i]);
+  }
+  return min;
+}
+
+auto MaxKernel(const int64_t *values, const uint8_t *nulls, size_t size) -> int64_t {
+  int64_t max = std::numeric_limits<int64_t>::min();
+  for (size_t i = 0; i < size; i++) {
+    max = std::max(max, nulls[i] != 0 ? std::numeric_limits<int64_t>::min() : values[i]);
+  }
+  return max;
+}
+
+}  // namespace bustub
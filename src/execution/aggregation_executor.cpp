@@ -9,11 +9,15 @@
 // Copyright (c) 2015-2021, Carnegie Mellon University Database Group
 //
 //===----------------------------------------------------------------------===//
+#include <algorithm>
+#include <exception>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "execution/aggregate_kernels.h"
 #include "execution/executors/aggregation_executor.h"
+#include "execution/executors/gather_executor.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -24,33 +28,268 @@ AggregationExecutor::AggregationExecutor(ExecutorContext *exec_ctx, const Aggreg
       plan_(plan),
       child_(std::move(child)),
       aht_(plan_->aggregates_, plan_->agg_types_),
-      aht_iterator_(aht_.Begin()) {}
+      aht_iterator_(aht_.Begin()),
+      use_kernels_(CanUseKernels(*plan_)) {}
+
+auto AggregationExecutor::CanUseKernels(const AggregationPlanNode &plan) -> bool {
+  if (!plan.GetGroupBys().empty()) {
+    return false;
+  }
+  for (size_t i = 0; i < plan.GetAggregates().size(); i++) {
+    auto type = plan.GetAggregates()[i]->GetReturnType();
+    if (!IsKernelInteger(type)) {
+      return false;
+    }
+    // the sum of a batch of bigints could overflow the kernel
+    if (plan.GetAggregateTypes()[i] == AggregationType::SumAggregate && type == TypeId::BIGINT) {
+      return false;
+    }
+  }
+  return true;
+}
 
 void AggregationExecutor::Init() {
-  child_->Init();
-  Tuple tuple{};
-  RID rid{};
-  while (child_->Next(&tuple, &rid)) {
-    aht_.InsertCombine(MakeAggregateKey(&tuple), MakeAggregateValue(&tuple));
+  aht_.Clear();
+  merged_.clear();
+  merged_idx_ = 0;
+  if (auto *gather = dynamic_cast<GatherExecutor *>(child_.get()); gather != nullptr) {
+    AggregateInParallel(gather);
+  } else {
+    // a query with a memory budget never runs on several workers, so that only a serial aggregation spills
+    spilled_.clear();
+    spill_partition_ = 0;
+    max_groups_ = 0;
+    if (auto budget = exec_ctx_->GetMemoryBudget(); budget > 0) {
+      auto group_size = sizeof(std::pair<const AggregateKey, AggregateState>) + sizeof(void *) * 2 +
+                        plan_->GetGroupBys().size() * sizeof(Value) +
+                        plan_->GetAggregates().size() * sizeof(AggregateAccumulator);
+      max_groups_ = std::max<size_t>(budget / group_size, 1);
+    }
+    child_->Run([this](TupleBatch *batch) { InsertBatch(&aht_, *batch, max_groups_ > 0); });
+  }
+  size_t group_count = aht_.Size();
+  for (auto &table : merged_) {
+    group_count += table.Size();
   }
-  if (GetOutputSchema().GetColumnCount() == 1 && aht_.Size() == 0) {
-    aht_.InsertIntialCombine();
+  // the merged partitions, if any, are output first, then the table of a serial aggregation
+  table_ = merged_.empty() ? &aht_ : &merged_.front();
+  if (GetOutputSchema().GetColumnCount() == 1 && group_count == 0) {
+    table_->InsertIntialCombine();
   }
-  aht_iterator_ = aht_.Begin();
+  aht_iterator_ = table_->Begin();
+}
+
+void AggregationExecutor::AggregateInParallel(GatherExecutor *gather) {
+  // pre-aggregation: each worker aggregates the morsels it scans into a small table of its own, which it flushes into
+  // partitions by group whenever it fills up, so that the groups being aggregated stay in cache
+  auto worker_count = gather->GetWorkerCount();
+  using Partition = std::vector<std::pair<AggregateKey, AggregateState>>;
+  std::vector<std::vector<Partition>> flushed(worker_count, std::vector<Partition>(AGGREGATION_MERGE_PARTITIONS));
+  std::vector<SimpleAggregationHashTable> worker_tables;
+  for (size_t i = 0; i < worker_count; i++) {
+    worker_tables.emplace_back(plan_->aggregates_, plan_->agg_types_);
+  }
+  auto flush = [&flushed, &worker_tables](size_t worker) {
+    auto &table = worker_tables[worker];
+    for (auto iter = table.Begin(); iter != table.End(); ++iter) {
+      auto partition = std::hash<AggregateKey>{}(iter.Key()) % AGGREGATION_MERGE_PARTITIONS;
+      flushed[worker][partition].emplace_back(iter.Key(), iter.State());
+    }
+    table.Clear();
+  };
+  gather->RunPipeline([this, &worker_tables, &flush](size_t worker, [[maybe_unused]] size_t morsel,
+                                                     const TupleBatch &batch) {
+    InsertBatch(&worker_tables[worker], batch);
+    if (worker_tables[worker].Size() >= AGGREGATION_PREAGGREGATION_GROUPS) {
+      flush(worker);
+    }
+  });
+  for (size_t worker = 0; worker < worker_count; worker++) {
+    flush(worker);
+  }
+
+  // merge: each partition is merged by a single worker into a table of its own, across what every worker flushed
+  for (size_t i = 0; i < AGGREGATION_MERGE_PARTITIONS; i++) {
+    merged_.emplace_back(plan_->aggregates_, plan_->agg_types_);
+  }
+  auto merge_workers = std::min(worker_count, AGGREGATION_MERGE_PARTITIONS);
+  std::vector<std::exception_ptr> errors(merge_workers);
+  GatherExecutor::RunOnWorkers(merge_workers, [this, &flushed, &errors, merge_workers](size_t worker) {
+    try {
+      for (size_t partition = worker; partition < AGGREGATION_MERGE_PARTITIONS; partition += merge_workers) {
+        for (const auto &worker_partitions : flushed) {
+          for (const auto &[key, state] : worker_partitions[partition]) {
+            merged_[partition].MergeCombine(key, state);
+          }
+        }
+      }
+    } catch (...) {
+      errors[worker] = std::current_exception();
+    }
+  });
+  for (const auto &error : errors) {
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+auto AggregationExecutor::NextTable() -> bool {
+  if (merged_idx_ + 1 < merged_.size()) {
+    table_ = &merged_[++merged_idx_];
+    aht_iterator_ = table_->Begin();
+    return true;
+  }
+  table_ = &aht_;
+  aht_iterator_ = aht_.End();
+  return LoadSpilledPartition();
+}
+
+void AggregationExecutor::InsertBatch(SimpleAggregationHashTable *aht, const TupleBatch &batch, bool spill) {
+  if (use_kernels_ && (batch.IsEmpty() || InsertBatchWithKernels(aht, batch))) {
+    return;
+  }
+  // the group-bys and the aggregates are evaluated over the whole batch, those that are its columns read in place
+  std::vector<std::vector<Value>> group_by_values(plan_->GetGroupBys().size());
+  std::vector<std::vector<Value>> aggregate_values(plan_->GetAggregates().size());
+  std::vector<const std::vector<Value> *> group_bys(group_by_values.size());
+  std::vector<const std::vector<Value> *> aggregates(aggregate_values.size());
+  for (size_t i = 0; i < group_bys.size(); i++) {
+    group_bys[i] = &plan_->GetGroupBys()[i]->EvaluateBatchRef(batch, &group_by_values[i]);
+  }
+  for (size_t i = 0; i < aggregates.size(); i++) {
+    aggregates[i] = &plan_->GetAggregates()[i]->EvaluateBatchRef(batch, &aggregate_values[i]);
+  }
+  for (size_t row = 0; row < batch.Size(); row++) {
+    auto key = MakeAggregateKey(group_bys, row);
+    auto value = MakeAggregateValue(aggregates, row);
+    if (!spill || aht->Size() < max_groups_) {
+      aht->InsertCombine(key, value);
+      continue;
+    }
+    if (aht->CombineIfPresent(key, value)) {
+      continue;
+    }
+    // the table is full, and the tuple of a group it does not have is aggregated with the partition of its group
+    if (spilled_.empty()) {
+      for (size_t i = 0; i < AGGREGATION_SPILL_PARTITIONS; i++) {
+        spilled_.push_back(std::make_unique<TmpTupleHeap>(exec_ctx_->GetBufferPoolManager()));
+      }
+    }
+    spilled_[std::hash<AggregateKey>{}(key) % AGGREGATION_SPILL_PARTITIONS]->Append(batch.GetTuple(row));
+  }
+}
+
+auto AggregationExecutor::InsertBatchWithKernels(SimpleAggregationHashTable *aht, const TupleBatch &batch) -> bool {
+  const auto &agg_types = plan_->GetAggregateTypes();
+  std::vector<std::vector<int64_t>> values(agg_types.size());
+  std::vector<std::vector<uint8_t>> nulls(agg_types.size());
+  std::vector<Value> evaluated;
+  for (size_t i = 0; i < agg_types.size(); i++) {
+    if (agg_types[i] == AggregationType::CountStarAggregate) {
+      continue;
+    }
+    const auto &agg_expr = plan_->GetAggregates()[i];
+    const auto &column = agg_expr->EvaluateBatchRef(batch, &evaluated);
+    if (!GatherIntegers(column, agg_expr->GetReturnType(), &values[i], &nulls[i])) {
+      return false;
+    }
+  }
+
+  // the aggregates of the batch, combined into those of the one group as a state built apart
+  AggregateState state(agg_types.size());
+  for (size_t i = 0; i < agg_types.size(); i++) {
+    auto size = batch.Size();
+    if (agg_types[i] == AggregationType::CountStarAggregate) {
+      state[i] = {TypeId::INTEGER, static_cast<int64_t>(size)};
+      continue;
+    }
+    auto count = CountKernel(nulls[i].data(), size);
+    if (agg_types[i] == AggregationType::CountAggregate) {
+      state[i] = {TypeId::INTEGER, count};
+      continue;
+    }
+    if (count == 0) {
+      continue;
+    }
+    auto type = plan_->GetAggregates()[i]->GetReturnType();
+    switch (agg_types[i]) {
+      case AggregationType::SumAggregate:
+        state[i] = {type, SumKernel(values[i].data(), nulls[i].data(), size)};
+        break;
+      case AggregationType::MinAggregate:
+        state[i] = {type, MinKernel(values[i].data(), nulls[i].data(), size)};
+        break;
+      case AggregationType::MaxAggregate:
+        state[i] = {type, MaxKernel(values[i].data(), nulls[i].data(), size)};
+        break;
+      default:
+        break;
+    }
+  }
+  aht->MergeCombine({std::vector<Value>()}, state);
+  return true;
+}
+
+auto AggregationExecutor::LoadSpilledPartition() -> bool {
+  // a partition is aggregated whole, and does not spill again
+  for (; spill_partition_ < spilled_.size(); spill_partition_++) {
+    auto heap = std::move(spilled_[spill_partition_]);
+    if (heap->GetTupleCount() == 0) {
+      continue;
+    }
+    aht_.Clear();
+    TupleBatch batch(&child_->GetOutputSchema());
+    std::vector<Tuple> tuples;
+    for (size_t page_idx = 0; page_idx < heap->GetPageCount(); page_idx++) {
+      tuples.clear();
+      heap->ReadPage(page_idx, &tuples);
+      batch.Clear();
+      for (const auto &tuple : tuples) {
+        batch.AppendTuple(tuple, RID{});
+      }
+      InsertBatch(&aht_, batch);
+    }
+    spill_partition_++;
+    aht_iterator_ = aht_.Begin();
+    return true;
+  }
+  return false;
 }
 
 auto AggregationExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (aht_iterator_ == aht_.End()) {
-    return false;
+  while (aht_iterator_ == table_->End()) {
+    if (!NextTable()) {
+      return false;
+    }
   }
   std::vector<Value> values;
+  auto aggregates = aht_iterator_.Val().aggregates_;
   values.insert(values.end(), aht_iterator_.Key().group_bys_.begin(), aht_iterator_.Key().group_bys_.end());
-  values.insert(values.end(), aht_iterator_.Val().aggregates_.begin(), aht_iterator_.Val().aggregates_.end());
-  *tuple = Tuple{values, &GetOutputSchema()};
+  values.insert(values.end(), aggregates.begin(), aggregates.end());
+  // built in the arena, then copied into the memory `tuple` already has
+  *tuple = Tuple{std::move(values), &GetOutputSchema(), exec_ctx_->GetArena()};
   ++aht_iterator_;
   return true;
 }
 
+auto AggregationExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Clear();
+  while (aht_iterator_ == table_->End()) {
+    if (!NextTable()) {
+      return false;
+    }
+  }
+  for (; aht_iterator_ != table_->End() && !batch->IsFull(); ++aht_iterator_) {
+    std::vector<Value> values;
+    auto aggregates = aht_iterator_.Val().aggregates_;
+    values.insert(values.end(), aht_iterator_.Key().group_bys_.begin(), aht_iterator_.Key().group_bys_.end());
+    values.insert(values.end(), aggregates.begin(), aggregates.end());
+    batch->AppendRow(std::move(values), RID{});
+  }
+  return !batch->IsEmpty();
+}
+
 auto AggregationExecutor::GetChildExecutor() const -> const AbstractExecutor * { return child_.get(); }
 
 }  // namespace bustub
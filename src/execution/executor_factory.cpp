@@ -12,13 +12,16 @@
 
 #include "execution/executor_factory.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "execution/executors/abstract_executor.h"
 #include "execution/executors/aggregation_executor.h"
 #include "execution/executors/delete_executor.h"
 #include "execution/executors/filter_executor.h"
+#include "execution/executors/gather_executor.h"
 #include "execution/executors/hash_join_executor.h"
 #include "execution/executors/index_scan_executor.h"
 #include "execution/executors/init_check_executor.h"
@@ -27,6 +30,7 @@
 #include "execution/executors/mock_scan_executor.h"
 #include "execution/executors/nested_index_join_executor.h"
 #include "execution/executors/nested_loop_join_executor.h"
+#include "execution/executors/pipeline_executor.h"
 #include "execution/executors/projection_executor.h"
 #include "execution/executors/seq_scan_executor.h"
 #include "execution/executors/sort_executor.h"
@@ -47,6 +51,13 @@ namespace bustub {
 auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPlanNodeRef &plan)
     -> std::unique_ptr<AbstractExecutor> {
   auto check_options_set = exec_ctx->GetCheckOptions()->check_options_set_;
+  // a pipeline over a table runs on the workers of the query when it has several, and its output is gathered
+  if (GatherExecutor::CanRun(exec_ctx, *plan)) {
+    return std::make_unique<GatherExecutor>(exec_ctx, plan);
+  }
+  if (exec_ctx->IsPushBased() && PipelineExecutor::IsStreaming(*plan)) {
+    return CreatePipeline(exec_ctx, plan);
+  }
   switch (plan->GetType()) {
     // Create a new sequential scan executor
     case PlanType::SeqScan: {
@@ -177,4 +188,35 @@ auto ExecutorFactory::CreateExecutor(ExecutorContext *exec_ctx, const AbstractPl
   }
 }
 
+auto ExecutorFactory::CreatePipeline(ExecutorContext *exec_ctx, const AbstractPlanNodeRef &plan)
+    -> std::unique_ptr<AbstractExecutor> {
+  // the executors of the pipeline have no child: a hash join only has its right side, which is a pipeline of its own
+  std::vector<std::unique_ptr<AbstractExecutor>> operators;
+  auto source_plan = plan;
+  while (PipelineExecutor::IsStreaming(*source_plan)) {
+    switch (source_plan->GetType()) {
+      case PlanType::Filter:
+        operators.push_back(std::make_unique<FilterExecutor>(
+            exec_ctx, dynamic_cast<const FilterPlanNode *>(source_plan.get()), nullptr));
+        break;
+      case PlanType::Projection:
+        operators.push_back(std::make_unique<ProjectionExecutor>(
+            exec_ctx, dynamic_cast<const ProjectionPlanNode *>(source_plan.get()), nullptr));
+        break;
+      case PlanType::HashJoin: {
+        const auto *hash_join_plan = dynamic_cast<const HashJoinPlanNode *>(source_plan.get());
+        auto right = ExecutorFactory::CreateExecutor(exec_ctx, hash_join_plan->GetRightPlan());
+        operators.push_back(std::make_unique<HashJoinExecutor>(exec_ctx, hash_join_plan, nullptr, std::move(right)));
+        break;
+      }
+      default:
+        UNREACHABLE("not a streaming plan");
+    }
+    source_plan = source_plan->GetChildAt(0);
+  }
+  std::reverse(operators.begin(), operators.end());
+  auto source = ExecutorFactory::CreateExecutor(exec_ctx, source_plan);
+  return std::make_unique<PipelineExecutor>(exec_ctx, plan, std::move(source), std::move(operators));
+}
+
 }  // namespace bustub
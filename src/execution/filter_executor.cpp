@@ -10,7 +10,9 @@ FilterExecutor::FilterExecutor(ExecutorContext *exec_ctx, const FilterPlanNode *
 
 void FilterExecutor::Init() {
   // Initialize the child executor
-  child_executor_->Init();
+  if (child_executor_ != nullptr) {
+    child_executor_->Init();
+  }
 }
 
 auto FilterExecutor::Next(Tuple *tuple, RID *rid) -> bool {
@@ -31,4 +33,24 @@ auto FilterExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   }
 }
 
+auto FilterExecutor::NextBatch(TupleBatch *batch) -> bool {
+  // the predicate is evaluated over the whole batch, and the batches it empties are skipped
+  std::vector<Value> predicate;
+  while (child_executor_->NextBatch(batch)) {
+    batch->Select(plan_->GetPredicate()->EvaluateBatchRef(*batch, &predicate));
+    if (!batch->IsEmpty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void FilterExecutor::Consume(TupleBatch *batch, const BatchSink &output) {
+  std::vector<Value> predicate;
+  batch->Select(plan_->GetPredicate()->EvaluateBatchRef(*batch, &predicate));
+  if (!batch->IsEmpty()) {
+    output(batch);
+  }
+}
+
 }  // namespace bustub
@@ -0,0 +1,274 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// gather_executor.cpp
+//
+// Identification: src/execution/gather_executor.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/gather_executor.h"
+
+#include <deque>
+#include <optional>
+
+#include "common/macros.h"
+#include "execution/executors/filter_executor.h"
+#include "execution/executors/projection_executor.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+
+namespace bustub {
+
+/** The morsels dealt to a worker: it takes them from the front, and the other workers steal them from the back */
+struct MorselQueue {
+  std::mutex latch_;
+  std::deque<size_t> morsels_;
+};
+
+/** @return the next morsel `worker` should scan, its own or stolen from another worker, or std::nullopt once all are */
+static auto TakeMorsel(std::vector<MorselQueue> *queues, size_t worker) -> std::optional<size_t> {
+  for (size_t i = 0; i < queues->size(); i++) {
+    auto &queue = (*queues)[(worker + i) % queues->size()];
+    std::scoped_lock lock(queue.latch_);
+    if (queue.morsels_.empty()) {
+      continue;
+    }
+    size_t morsel;
+    if (i == 0) {
+      morsel = queue.morsels_.front();
+      queue.morsels_.pop_front();
+    } else {
+      morsel = queue.morsels_.back();
+      queue.morsels_.pop_back();
+    }
+    return morsel;
+  }
+  return std::nullopt;
+}
+
+auto GatherExecutor::CanRun(ExecutorContext *exec_ctx, const AbstractPlanNode &plan) -> bool {
+  // the workers keep what they build in memory of their own, which a memory budget does not bound
+  if (exec_ctx->GetParallelism() <= 1 || exec_ctx->GetMemoryBudget() > 0) {
+    return false;
+  }
+  switch (plan.GetType()) {
+    case PlanType::Filter:
+    case PlanType::Projection:
+      return CanRun(exec_ctx, *plan.GetChildAt(0));
+    case PlanType::SeqScan: {
+      // a columnar scan of a PAX table reads whole columns at once, and is not split into morsels
+      const auto &scan_plan = dynamic_cast<const SeqScanPlanNode &>(plan);
+      const auto *table_info = exec_ctx->GetCatalog()->GetTable(scan_plan.table_oid_);
+      return !(scan_plan.columns_.has_value() && table_info->table_->GetLayout() == TableLayout::PAX);
+    }
+    default:
+      return false;
+  }
+}
+
+void GatherExecutor::RunOnWorkers(size_t worker_count, const std::function<void(size_t worker)> &task) {
+  if (worker_count == 1) {
+    task(0);
+    return;
+  }
+  std::vector<std::thread> workers;
+  workers.reserve(worker_count);
+  for (size_t worker = 0; worker < worker_count; worker++) {
+    workers.emplace_back(task, worker);
+  }
+  for (auto &thread : workers) {
+    thread.join();
+  }
+}
+
+GatherExecutor::GatherExecutor(ExecutorContext *exec_ctx, AbstractPlanNodeRef plan)
+    : AbstractExecutor(exec_ctx), plan_(std::move(plan)) {}
+
+GatherExecutor::~GatherExecutor() { Stop(); }
+
+void GatherExecutor::Stop() {
+  if (!runner_.joinable()) {
+    return;
+  }
+  cancelled_ = true;
+  {
+    // wake the workers waiting for the gather to catch up
+    std::scoped_lock lock(latch_);
+    cv_.notify_all();
+  }
+  runner_.join();
+}
+
+void GatherExecutor::Init() {
+  Stop();
+  cancelled_ = false;
+  done_.clear();
+  next_morsel_ = 0;
+  finished_ = false;
+  error_ = nullptr;
+  batches_.clear();
+  batch_idx_ = 0;
+  row_ = 0;
+
+  runner_ = std::thread([this] {
+    // the batches of a morsel are kept by the worker running it, and handed over together once it is done
+    std::vector<std::vector<TupleBatch>> outputs(GetWorkerCount());
+    std::exception_ptr error;
+    try {
+      auto sink = [&outputs](size_t worker, [[maybe_unused]] size_t morsel, const TupleBatch &batch) {
+        outputs[worker].push_back(batch);
+      };
+      auto morsel_sink = [this, &outputs](size_t worker, size_t morsel) {
+        std::unique_lock lock(latch_);
+        done_.emplace(morsel, std::move(outputs[worker]));
+        outputs[worker].clear();
+        cv_.notify_all();
+        // a worker only waits once it is done with a morsel, and the next morsel to be gathered is either running on a
+        // worker that has not waited since, or queued to one that is behind it: the gather always catches up
+        cv_.wait(lock, [this, morsel] { return morsel < next_morsel_ + GATHER_MORSELS_AHEAD || cancelled_; });
+      };
+      RunPipeline(sink, morsel_sink, &cancelled_);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    std::scoped_lock lock(latch_);
+    finished_ = true;
+    error_ = error;
+    cv_.notify_all();
+  });
+}
+
+auto GatherExecutor::NextMorsel() -> bool {
+  std::unique_lock lock(latch_);
+  cv_.wait(lock, [this] { return finished_ || done_.count(next_morsel_) > 0; });
+  auto it = done_.find(next_morsel_);
+  if (it == done_.end()) {
+    // every morsel done is gathered, and those left were never done because the pipeline failed
+    if (error_ != nullptr) {
+      std::rethrow_exception(error_);
+    }
+    return false;
+  }
+  batches_ = std::move(it->second);
+  done_.erase(it);
+  next_morsel_++;
+  cv_.notify_all();
+  batch_idx_ = 0;
+  row_ = 0;
+  return true;
+}
+
+auto GatherExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (batch_idx_ == batches_.size() || row_ == batches_[batch_idx_].Size()) {
+    if (batch_idx_ < batches_.size()) {
+      batch_idx_++;
+      row_ = 0;
+    } else if (!NextMorsel()) {
+      return false;
+    }
+  }
+  *tuple = batches_[batch_idx_].GetTuple(row_);
+  *rid = tuple->GetRid();
+  row_++;
+  return true;
+}
+
+auto GatherExecutor::NextBatch(TupleBatch *batch) -> bool {
+  while (batch_idx_ == batches_.size()) {
+    if (!NextMorsel()) {
+      batch->Clear();
+      return false;
+    }
+  }
+  *batch = std::move(batches_[batch_idx_++]);
+  return true;
+}
+
+void GatherExecutor::RunPipeline(const Sink &sink, const MorselSink &morsel_sink, const std::atomic<bool> *cancelled) {
+  const auto *scan_plan = plan_.get();
+  while (scan_plan->GetType() != PlanType::SeqScan) {
+    scan_plan = scan_plan->GetChildAt(0).get();
+  }
+  auto table_oid = dynamic_cast<const SeqScanPlanNode *>(scan_plan)->table_oid_;
+  auto morsels = exec_ctx_->GetCatalog()->GetTable(table_oid)->table_->MakeMorselIterators(MORSEL_PAGE_COUNT);
+
+  // the morsels are dealt in turn, so that each worker starts on a share of the table of its own
+  auto worker_count = GetWorkerCount();
+  std::vector<MorselQueue> queues(worker_count);
+  for (size_t i = 0; i < morsels.size(); i++) {
+    queues[i % worker_count].morsels_.push_back(i);
+  }
+
+  // every worker has executors of its own, so that none of their state is shared
+  std::vector<std::unique_ptr<AbstractExecutor>> pipelines;
+  std::vector<SeqScanExecutor *> scans(worker_count);
+  for (size_t worker = 0; worker < worker_count; worker++) {
+    pipelines.push_back(MakePipeline(plan_, &scans[worker]));
+  }
+
+  // once a worker fails, or the pipeline is cancelled, the workers stop at the end of the batch they are at
+  std::atomic<bool> failed{false};
+  auto stopped = [&failed, cancelled] { return failed || (cancelled != nullptr && *cancelled); };
+  std::vector<std::exception_ptr> errors(worker_count);
+  std::vector<std::thread> workers;
+  workers.reserve(worker_count);
+  for (size_t worker = 0; worker < worker_count; worker++) {
+    workers.emplace_back([&, worker] {
+      try {
+        auto &pipeline = pipelines[worker];
+        pipeline->Init();
+        TupleBatch batch(&plan_->OutputSchema());
+        std::optional<size_t> morsel;
+        while (!stopped() && (morsel = TakeMorsel(&queues, worker)).has_value()) {
+          scans[worker]->SetMorsel(std::move(morsels[*morsel]));
+          while (!stopped() && pipeline->NextBatch(&batch)) {
+            sink(worker, *morsel, batch);
+          }
+          if (!stopped() && morsel_sink != nullptr) {
+            morsel_sink(worker, *morsel);
+          }
+        }
+      } catch (...) {
+        errors[worker] = std::current_exception();
+        failed = true;
+      }
+    });
+  }
+  for (auto &thread : workers) {
+    thread.join();
+  }
+  for (const auto &error : errors) {
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+auto GatherExecutor::MakePipeline(const AbstractPlanNodeRef &plan, SeqScanExecutor **scan)
+    -> std::unique_ptr<AbstractExecutor> {
+  switch (plan->GetType()) {
+    case PlanType::Filter: {
+      const auto *filter_plan = dynamic_cast<const FilterPlanNode *>(plan.get());
+      return std::make_unique<FilterExecutor>(exec_ctx_, filter_plan, MakePipeline(filter_plan->GetChildPlan(), scan));
+    }
+    case PlanType::Projection: {
+      const auto *projection_plan = dynamic_cast<const ProjectionPlanNode *>(plan.get());
+      return std::make_unique<ProjectionExecutor>(exec_ctx_, projection_plan,
+                                                  MakePipeline(projection_plan->GetChildPlan(), scan));
+    }
+    case PlanType::SeqScan: {
+      auto executor = std::make_unique<SeqScanExecutor>(exec_ctx_, dynamic_cast<const SeqScanPlanNode *>(plan.get()));
+      *scan = executor.get();
+      return executor;
+    }
+    default:
+      UNREACHABLE("not a pipeline");
+  }
+}
+
+}  // namespace bustub
@@ -11,6 +11,11 @@
 //===----------------------------------------------------------------------===//
 
 #include "execution/executors/hash_join_executor.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "execution/executors/gather_executor.h"
 #include "binder/table_ref/bound_join_ref.h"
 #include "type/value.h"
 
@@ -22,78 +27,366 @@ HashJoinExecutor::HashJoinExecutor(ExecutorContext *exec_ctx, const HashJoinPlan
     : AbstractExecutor(exec_ctx),
       plan_{plan},
       left_executor_{std::move(left_child)},
-      right_executor_(std::move(right_child)) {
+      right_executor_(std::move(right_child)),
+      left_batch_(&plan->GetLeftPlan()->OutputSchema()),
+      next_batch_(&plan->OutputSchema()),
+      output_batch_(&plan->OutputSchema()) {
   if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
     // Note for 2023 Spring: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
+/**
+ * Evaluate join key expressions over a batch, one vector of values per expression. A key that is a column of the batch
+ * is read in place, and the others are evaluated into `values`.
+ */
+static void EvaluateJoinKeys(const std::vector<AbstractExpressionRef> &exprs, const TupleBatch &batch,
+                             std::vector<std::vector<Value>> *values, std::vector<const std::vector<Value> *> *keys) {
+  values->resize(exprs.size());
+  keys->resize(exprs.size());
+  for (size_t i = 0; i < exprs.size(); i++) {
+    (*keys)[i] = &exprs[i]->EvaluateBatchRef(batch, &(*values)[i]);
+  }
+}
+
+/** @return the join key of a row, from the key expressions evaluated over its batch */
+static auto MakeJoinKey(const std::vector<const std::vector<Value> *> &keys, size_t row) -> HashJoinKey {
+  HashJoinKey join_key;
+  join_key.attributes_.reserve(keys.size());
+  for (const auto *column : keys) {
+    join_key.attributes_.push_back((*column)[row]);
+  }
+  return join_key;
+}
+
+/** @return whether a join key has a NULL, in which case it joins nothing */
+static auto HasNull(const HashJoinKey &key) -> bool {
+  return std::any_of(key.attributes_.begin(), key.attributes_.end(), [](const Value &value) { return value.IsNull(); });
+}
+
+/** @return about the memory an entry of the build side takes */
+static auto EntrySize(const HashJoinEntry &entry) -> size_t {
+  return sizeof(std::pair<size_t, HashJoinEntry>) + entry.tuple_.GetLength() +
+         entry.key_.attributes_.size() * sizeof(Value);
+}
+
 void HashJoinExecutor::Init() {
-  left_executor_->Init();
-  right_executor_->Init();
-
-  Tuple tmp_tuple{};
-  RID rid;
-  while (right_executor_->Next(&tmp_tuple, &rid)) {
-    HashJoinKey join_key;
-    for (auto &e : plan_->RightJoinKeyExpressions()) {
-      join_key.attributes_.push_back(e->Evaluate(&tmp_tuple, plan_->GetRightPlan()->OutputSchema()));
-    }
-    hash_join_table_[join_key.Hash()].emplace_back(tmp_tuple);
-  }
-
-  while (left_executor_->Next(&tmp_tuple, &rid)) {
-    HashJoinKey left_join_key;
-    for (auto &e : plan_->LeftJoinKeyExpressions()) {
-      left_join_key.attributes_.emplace_back(e->Evaluate(&tmp_tuple, plan_->GetLeftPlan()->OutputSchema()));
-    }
-    if (hash_join_table_.count(left_join_key.Hash()) > 0) {
-      auto right_tuples = hash_join_table_[left_join_key.Hash()];
-      for (const auto &tuple : right_tuples) {
-        HashJoinKey right_join_key;
-        for (auto &right_expr : plan_->RightJoinKeyExpressions()) {
-          right_join_key.attributes_.emplace_back(right_expr->Evaluate(&tuple, plan_->GetRightPlan()->OutputSchema()));
-        }
-        /*hash值可能相同，另外判断*/
-        if (right_join_key == left_join_key) {
-          std::vector<Value> values{};
-          values.reserve(plan_->GetLeftPlan()->OutputSchema().GetColumnCount() +
-                         plan_->GetRightPlan()->OutputSchema().GetColumnCount());
-          for (uint32_t col_idx = 0; col_idx < plan_->GetLeftPlan()->OutputSchema().GetColumnCount(); col_idx++) {
-            values.push_back(tmp_tuple.GetValue(&plan_->GetLeftPlan()->OutputSchema(), col_idx));
-          }
-          for (uint32_t col_idx = 0; col_idx < plan_->GetRightPlan()->OutputSchema().GetColumnCount(); col_idx++) {
-            values.push_back(tuple.GetValue(&plan_->GetRightPlan()->OutputSchema(), col_idx));
-          }
-          output_tuples_.emplace_back(values, &GetOutputSchema());
+  spilled_build_.clear();
+  spilled_build_.resize(HASH_JOIN_PARTITION_COUNT);
+  spilled_probe_.clear();
+  spilled_probe_.resize(HASH_JOIN_PARTITION_COUNT);
+  partition_bytes_.assign(HASH_JOIN_PARTITION_COUNT, 0);
+  Build();
+
+  output_batches_.clear();
+  output_idx_ = 0;
+  next_batch_.Clear();
+  next_row_ = 0;
+  gathered_ = false;
+  if (auto *gather = dynamic_cast<GatherExecutor *>(left_executor_.get()); gather != nullptr) {
+    // the workers probe the table, which they only read, and what they output is gathered in the order of the morsels
+    gathered_ = true;
+    std::vector<std::vector<std::pair<size_t, TupleBatch>>> probed(gather->GetWorkerCount());
+    gather->RunPipeline([this, &probed](size_t worker, size_t morsel, const TupleBatch &batch) {
+      ProbeCursor cursor;
+      StartProbe(&cursor, &batch);
+      while (cursor.row_ < batch.Size()) {
+        TupleBatch output(&GetOutputSchema());
+        Probe(&cursor, &output);
+        if (!output.IsEmpty()) {
+          probed[worker].emplace_back(morsel, std::move(output));
         }
       }
-    } else if (plan_->join_type_ == JoinType::LEFT) {
-      std::vector<Value> values{};
-      values.reserve(plan_->GetLeftPlan()->OutputSchema().GetColumnCount() +
-                     plan_->GetRightPlan()->OutputSchema().GetColumnCount());
-      for (uint32_t col_idx = 0; col_idx < plan_->GetLeftPlan()->OutputSchema().GetColumnCount(); col_idx++) {
-        values.push_back(tmp_tuple.GetValue(&plan_->GetLeftPlan()->OutputSchema(), col_idx));
+    });
+    output_batches_ = GatherExecutor::MergeByMorsel(&probed);
+    return;
+  }
+  if (left_executor_ != nullptr) {
+    left_executor_->Init();
+  }
+  left_done_ = false;
+  spill_partition_ = 0;
+  left_batch_.Clear();
+  StartProbe(&cursor_, &left_batch_);
+}
+
+void HashJoinExecutor::Build() {
+  // every worker splits the tuples it builds by partition, each in the order of their morsels
+  using Partitioned = std::vector<std::vector<std::pair<size_t, HashJoinEntry>>>;
+  std::vector<Partitioned> built;
+  // a query with a memory budget never runs on several workers, so that only a serial build spills. What it builds is
+  // not allocated from the arena, which would keep the memory of the partitions spilled until the query ends.
+  auto budget = exec_ctx_->GetMemoryBudget();
+  auto *arena = budget > 0 ? nullptr : exec_ctx_->GetArena();
+  auto sink = [this, &built, budget, arena](size_t worker, size_t morsel, const TupleBatch &batch) {
+    std::vector<std::vector<Value>> values;
+    std::vector<const std::vector<Value> *> keys;
+    EvaluateJoinKeys(plan_->RightJoinKeyExpressions(), batch, &values, &keys);
+    for (size_t row = 0; row < batch.Size(); row++) {
+      auto key = MakeJoinKey(keys, row);
+      if (HasNull(key)) {
+        continue;
+      }
+      auto hash = key.Hash();
+      auto partition = hash & (HASH_JOIN_PARTITION_COUNT - 1);
+      if (spilled_build_[partition] != nullptr) {
+        spilled_build_[partition]->Append(batch.GetTuple(row));
+        continue;
       }
-      for (uint32_t col_idx = 0; col_idx < plan_->GetRightPlan()->OutputSchema().GetColumnCount(); col_idx++) {
-        values.push_back(
-            ValueFactory::GetNullValueByType(plan_->GetRightPlan()->OutputSchema().GetColumn(col_idx).GetType()));
+      auto &entry = built[worker][partition]
+                        .emplace_back(morsel, HashJoinEntry{hash, std::move(key), batch.GetTuple(row, arena)})
+                        .second;
+      if (budget > 0) {
+        partition_bytes_[partition] += EntrySize(entry);
       }
-      output_tuples_.emplace_back(values, &GetOutputSchema());
     }
+  };
+  if (auto *gather = dynamic_cast<GatherExecutor *>(right_executor_.get()); gather != nullptr) {
+    built.assign(gather->GetWorkerCount(), Partitioned(HASH_JOIN_PARTITION_COUNT));
+    gather->RunPipeline(sink);
+  } else {
+    built.assign(1, Partitioned(HASH_JOIN_PARTITION_COUNT));
+    right_executor_->Run([this, &sink, &built, budget](TupleBatch *right_batch) {
+      sink(0, 0, *right_batch);
+      if (budget > 0) {
+        SpillBuild(&built[0]);
+      }
+    });
   }
 
-  output_tuples_iter_ = output_tuples_.cbegin();
+  // then each partition is built on its own, by one of the workers
+  partitions_.clear();
+  partitions_.resize(HASH_JOIN_PARTITION_COUNT);
+  auto worker_count = std::min(exec_ctx_->GetParallelism(), HASH_JOIN_PARTITION_COUNT);
+  GatherExecutor::RunOnWorkers(worker_count, [this, &built, worker_count](size_t worker) {
+    for (size_t i = worker; i < HASH_JOIN_PARTITION_COUNT; i += worker_count) {
+      std::vector<std::vector<std::pair<size_t, HashJoinEntry>>> outputs;
+      outputs.reserve(built.size());
+      for (auto &partitioned : built) {
+        outputs.push_back(std::move(partitioned[i]));
+      }
+      partitions_[i].entries_ = GatherExecutor::MergeByMorsel(&outputs);
+      partitions_[i].Build();
+    }
+  });
+}
+
+void HashJoinExecutor::SpillBuild(std::vector<std::vector<std::pair<size_t, HashJoinEntry>>> *built) {
+  // the largest partitions are spilled first, until those left fit in the budget. Both sides of a partition spilled are
+  // written to disk, and joined once the left side is all probed.
+  auto *bpm = exec_ctx_->GetBufferPoolManager();
+  while (std::accumulate(partition_bytes_.begin(), partition_bytes_.end(), size_t{0}) > exec_ctx_->GetMemoryBudget()) {
+    auto largest = std::max_element(partition_bytes_.begin(), partition_bytes_.end()) - partition_bytes_.begin();
+    spilled_build_[largest] = std::make_unique<TmpTupleHeap>(bpm);
+    spilled_probe_[largest] = std::make_unique<TmpTupleHeap>(bpm);
+    for (const auto &[morsel, entry] : (*built)[largest]) {
+      spilled_build_[largest]->Append(entry.tuple_);
+    }
+    std::vector<std::pair<size_t, HashJoinEntry>>().swap((*built)[largest]);
+    partition_bytes_[largest] = 0;
+  }
+}
+
+void HashJoinExecutor::LoadSpilledPartition(size_t partition) {
+  auto heap = std::move(spilled_build_[partition]);
+  auto &entries = partitions_[partition].entries_;
+  const auto &right_schema = plan_->GetRightPlan()->OutputSchema();
+  std::vector<Tuple> tuples;
+  for (size_t page_idx = 0; page_idx < heap->GetPageCount(); page_idx++) {
+    tuples.clear();
+    heap->ReadPage(page_idx, &tuples);
+    for (auto &tuple : tuples) {
+      HashJoinKey key;
+      for (const auto &expr : plan_->RightJoinKeyExpressions()) {
+        key.attributes_.push_back(expr->Evaluate(&tuple, right_schema));
+      }
+      auto hash = key.Hash();
+      entries.push_back(HashJoinEntry{hash, std::move(key), std::move(tuple)});
+    }
+  }
+  partitions_[partition].Build();
+}
+
+auto HashJoinExecutor::NextLeftBatch() -> bool {
+  if (!left_done_) {
+    if (left_executor_->NextBatch(&left_batch_)) {
+      return true;
+    }
+    left_done_ = true;
+  }
+  // then the partitions spilled, one at a time: the right side of each is read back into memory, and probed with its
+  // left side, a page at a time
+  for (; spill_partition_ < HASH_JOIN_PARTITION_COUNT; spill_partition_++) {
+    auto &probe_heap = spilled_probe_[spill_partition_];
+    if (probe_heap == nullptr) {
+      continue;
+    }
+    if (spilled_build_[spill_partition_] != nullptr) {
+      LoadSpilledPartition(spill_partition_);
+      spill_page_ = 0;
+    }
+    if (spill_page_ < probe_heap->GetPageCount()) {
+      std::vector<Tuple> tuples;
+      probe_heap->ReadPage(spill_page_++, &tuples);
+      left_batch_.Clear();
+      for (const auto &tuple : tuples) {
+        left_batch_.AppendTuple(tuple, RID{});
+      }
+      return true;
+    }
+    partitions_[spill_partition_] = HashJoinPartition{};
+    probe_heap.reset();
+  }
+  return false;
+}
+
+void HashJoinExecutor::StartProbe(ProbeCursor *cursor, const TupleBatch *batch) const {
+  cursor->batch_ = batch;
+  std::vector<std::vector<Value>> values;
+  std::vector<const std::vector<Value> *> keys;
+  EvaluateJoinKeys(plan_->LeftJoinKeyExpressions(), *batch, &values, &keys);
+  cursor->keys_.clear();
+  cursor->hashes_.clear();
+  for (size_t row = 0; row < batch->Size(); row++) {
+    auto &key = cursor->keys_.emplace_back(MakeJoinKey(keys, row));
+    cursor->hashes_.push_back(key.Hash());
+  }
+  cursor->row_ = 0;
+  StartProbeRow(cursor);
+}
+
+void HashJoinExecutor::StartProbeRow(ProbeCursor *cursor) const {
+  cursor->matched_ = false;
+  cursor->spilled_ = false;
+  cursor->entry_ = HashJoinPartition::NO_ENTRY;
+  if (cursor->row_ < cursor->batch_->Size() && !HasNull(cursor->keys_[cursor->row_])) {
+    auto hash = cursor->hashes_[cursor->row_];
+    auto partition = hash & (HASH_JOIN_PARTITION_COUNT - 1);
+    cursor->spilled_ = spilled_build_[partition] != nullptr;
+    cursor->entry_ = partitions_[partition].First(hash);
+  }
+}
+
+void HashJoinExecutor::Probe(ProbeCursor *cursor, TupleBatch *output, size_t row_count) {
+  const auto &batch = *cursor->batch_;
+  auto end_row = batch.Size() - cursor->row_ > row_count ? cursor->row_ + row_count : batch.Size();
+  while (cursor->row_ < end_row && !output->IsFull()) {
+    auto hash = cursor->hashes_[cursor->row_];
+    if (cursor->spilled_) {
+      // the row probes its partition once it is read back
+      spilled_probe_[hash & (HASH_JOIN_PARTITION_COUNT - 1)]->Append(batch.GetTuple(cursor->row_));
+      cursor->row_++;
+      StartProbeRow(cursor);
+      continue;
+    }
+    const auto &partition = partitions_[hash & (HASH_JOIN_PARTITION_COUNT - 1)];
+    if (cursor->entry_ != HashJoinPartition::NO_ENTRY) {
+      // hashes can be the same for different keys, so the keys are compared too
+      const auto &entry = partition.entries_[cursor->entry_];
+      cursor->entry_ = partition.next_[cursor->entry_];
+      if (entry.hash_ == hash && entry.key_ == cursor->keys_[cursor->row_]) {
+        cursor->matched_ = true;
+        AppendJoinedRow(batch, cursor->row_, &entry.tuple_, output);
+      }
+      continue;
+    }
+    if (!cursor->matched_ && plan_->GetJoinType() == JoinType::LEFT) {
+      AppendJoinedRow(batch, cursor->row_, nullptr, output);
+    }
+    cursor->row_++;
+    StartProbeRow(cursor);
+  }
+}
+
+void HashJoinExecutor::AppendJoinedRow(const TupleBatch &left_batch, size_t row, const Tuple *right_tuple,
+                                       TupleBatch *output) const {
+  const auto &right_schema = plan_->GetRightPlan()->OutputSchema();
+  std::vector<Value> values{};
+  values.reserve(left_batch.GetSchema().GetColumnCount() + right_schema.GetColumnCount());
+  for (uint32_t col_idx = 0; col_idx < left_batch.GetSchema().GetColumnCount(); col_idx++) {
+    values.push_back(left_batch.GetValue(row, col_idx));
+  }
+  for (uint32_t col_idx = 0; col_idx < right_schema.GetColumnCount(); col_idx++) {
+    if (right_tuple == nullptr) {
+      values.push_back(ValueFactory::GetNullValueByType(right_schema.GetColumn(col_idx).GetType()));
+    } else {
+      values.push_back(right_tuple->GetValue(&right_schema, col_idx));
+    }
+  }
+  output->AppendRow(std::move(values), RID{});
 }
 
 auto HashJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (output_tuples_iter_ == output_tuples_.cend()) {
-    return false;
+  if (gathered_) {
+    if (next_row_ == next_batch_.Size()) {
+      if (!NextBatch(&next_batch_)) {
+        return false;
+      }
+      next_row_ = 0;
+    }
+    *tuple = next_batch_.GetTuple(next_row_++);
+    return true;
+  }
+  // a left row is only probed once the tuples the one before joins are all yielded
+  while (next_row_ == next_batch_.Size()) {
+    next_batch_.Clear();
+    next_row_ = 0;
+    if (cursor_.row_ >= left_batch_.Size()) {
+      if (!NextLeftBatch()) {
+        return false;
+      }
+      StartProbe(&cursor_, &left_batch_);
+      continue;
+    }
+    Probe(&cursor_, &next_batch_, 1);
   }
-  *tuple = *output_tuples_iter_;
-  ++output_tuples_iter_;
+  *tuple = next_batch_.GetTuple(next_row_++);
   return true;
 }
 
+auto HashJoinExecutor::NextBatch(TupleBatch *batch) -> bool {
+  if (gathered_) {
+    if (output_idx_ == output_batches_.size()) {
+      batch->Clear();
+      return false;
+    }
+    *batch = std::move(output_batches_[output_idx_++]);
+    return true;
+  }
+  // the left side is pulled a batch at a time, as the batches it joins are output
+  batch->Clear();
+  while (!batch->IsFull()) {
+    if (cursor_.row_ >= left_batch_.Size()) {
+      if (!NextLeftBatch()) {
+        break;
+      }
+      StartProbe(&cursor_, &left_batch_);
+      continue;
+    }
+    Probe(&cursor_, batch);
+  }
+  return !batch->IsEmpty();
+}
+
+void HashJoinExecutor::Consume(TupleBatch *batch, const BatchSink &output) {
+  ProbeCursor cursor;
+  StartProbe(&cursor, batch);
+  while (cursor.row_ < batch->Size()) {
+    output_batch_.Clear();
+    Probe(&cursor, &output_batch_);
+    if (!output_batch_.IsEmpty()) {
+      output(&output_batch_);
+    }
+  }
+}
+
+void HashJoinExecutor::Finish(const BatchSink &output) {
+  // the left side of the partitions spilled is read back a page at a time, and probes them as if it were pushed
+  left_done_ = true;
+  while (NextLeftBatch()) {
+    Consume(&left_batch_, output);
+  }
+}
+
 }  // namespace bustub
@@ -9,28 +9,130 @@
 // Copyright (c) 2015-19, Carnegie Mellon University Database Group
 //
 //===----------------------------------------------------------------------===//
+#include <algorithm>
+
 #include "execution/executors/index_scan_executor.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 IndexScanExecutor::IndexScanExecutor(ExecutorContext *exec_ctx, const IndexScanPlanNode *plan)
     : AbstractExecutor(exec_ctx),
       plan_(plan),
       index_info_{this->exec_ctx_->GetCatalog()->GetIndex(plan_->index_oid_)},
-      table_info_{this->exec_ctx_->GetCatalog()->GetTable(index_info_->table_name_)},
-      tree_(dynamic_cast<BPlusTreeIndexForTwoIntegerColumn *>(index_info_->index_.get())),
-      iter_(tree_->GetBeginIterator()) {}
+      table_info_{this->exec_ctx_->GetCatalog()->GetTable(index_info_->table_name_)} {}
 
-void IndexScanExecutor::Init() {}
+void IndexScanExecutor::Init() {
+  // the flag set by a B+ tree index may have flipped since planning, so it is checked on every run
+  index_only_ = plan_->index_only_ && index_info_->index_->CanReturnKeys();
+  rids_.clear();
+  rid_idx_ = 0;
+  fetched_.clear();
+  fetched_idx_ = 0;
+  iter_ = nullptr;
+  if (plan_->GetPredKey() == nullptr) {
+    iter_ = index_info_->index_->MakeCursor();
+    BUSTUB_ENSURE(iter_ != nullptr, "full index scan over an index without key order");
+    return;
+  }
+  auto key_value = plan_->GetPredKey()->Evaluate(nullptr, index_info_->key_schema_);
+  if (key_value.IsNull()) {
+    return;
+  }
+  Tuple key{{key_value}, index_info_->index_->GetSearchKeySchema()};
+  if (index_info_->index_type_ == IndexType::BPlusTreeIndex) {
+    // walk the matching entries, so the included columns can be read off them
+    iter_ = index_info_->index_->MakeCursor(key);
+    return;
+  }
+  index_info_->index_->ScanKey(key, &rids_, exec_ctx_->GetTransaction());
+}
 
-auto IndexScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (iter_ == tree_->GetEndIterator()) {
+auto IndexScanExecutor::NextRid(RID *rid) -> bool {
+  if (iter_ != nullptr) {
+    if (iter_->IsEnd()) {
+      return false;
+    }
+    *rid = iter_->GetRID();
+    iter_->Next();
+    return true;
+  }
+  if (rid_idx_ == rids_.size()) {
+    return false;
+  }
+  *rid = rids_[rid_idx_++];
+  return true;
+}
+
+auto IndexScanExecutor::FetchSortedBatch() -> bool {
+  std::vector<RID> batch;
+  RID next_rid;
+  while (batch.size() < SORTED_FETCH_BATCH_SIZE && NextRid(&next_rid)) {
+    batch.push_back(next_rid);
+  }
+  if (batch.empty()) {
     return false;
   }
-  *rid = (*iter_).second;
-  auto result = table_info_->table_->GetTuple(*rid);
-  *tuple = result.second;
-  ++iter_;
+  // in page order, so every page of the batch is fetched once
+  std::sort(batch.begin(), batch.end(), [](const RID &lhs, const RID &rhs) { return lhs.Get() < rhs.Get(); });
+  batch.erase(std::unique(batch.begin(), batch.end()), batch.end());
+  fetched_.clear();
+  fetched_idx_ = 0;
+  for (auto begin = batch.begin(); begin != batch.end();) {
+    auto end = std::find_if(begin, batch.end(),
+                            [&](const RID &other) { return other.GetPageId() != begin->GetPageId(); });
+    table_info_->table_->GetTuples(std::vector<RID>(begin, end), &fetched_);
+    begin = end;
+  }
   return true;
 }
 
+auto IndexScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  const auto &schema = GetOutputSchema();
+  while (true) {
+    Tuple result;
+    if (index_only_) {
+      if (iter_->IsEnd()) {
+        return false;
+      }
+      // the columns the plan above reads are all in the key, the others stay NULL
+      std::vector<Value> values;
+      values.reserve(schema.GetColumnCount());
+      for (const auto &column : schema.GetColumns()) {
+        values.push_back(ValueFactory::GetNullValueByType(column.GetType()));
+      }
+      const auto &key_attrs = index_info_->index_->GetKeyAttrs();
+      for (uint32_t i = 0; i < key_attrs.size(); i++) {
+        values[key_attrs[i]] = iter_->GetKeyValue(i);
+      }
+      result = Tuple(values, &schema);
+      *rid = iter_->GetRID();
+      iter_->Next();
+    } else if (plan_->sorted_fetch_) {
+      if (fetched_idx_ == fetched_.size() && !FetchSortedBatch()) {
+        return false;
+      }
+      auto &[meta, heap_tuple] = fetched_[fetched_idx_++];
+      if (meta.is_deleted_) {
+        continue;
+      }
+      *rid = heap_tuple.GetRid();
+      result = std::move(heap_tuple);
+    } else {
+      if (!NextRid(rid)) {
+        return false;
+      }
+      auto [meta, heap_tuple] = table_info_->table_->GetTuple(*rid);
+      if (meta.is_deleted_) {
+        continue;
+      }
+      result = std::move(heap_tuple);
+    }
+    if (plan_->filter_predicate_ != nullptr && !plan_->filter_predicate_->Evaluate(&result, schema).GetAs<bool>()) {
+      continue;
+    }
+    *tuple = std::move(result);
+    return true;
+  }
+}
+
 }  // namespace bustub
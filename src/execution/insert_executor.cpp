@@ -39,22 +39,29 @@ auto InsertExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
   if (is_end_) {
     return false;
   }
-  Tuple to_insert_tuple{};
+  Tuple child_tuple{};
   TupleMeta to_insert_tuple_meta{};
   RID emit_rid;
-  int32_t insert_count = 0;
 
-  while (child_executor_->Next(&to_insert_tuple, &emit_rid)) {
-    auto rid_tmp = table_info_->table_->InsertTuple(to_insert_tuple_meta, to_insert_tuple);
-    if (rid_tmp.has_value()) {
-      for (auto index : table_indexes_) {
-        index->index_->InsertEntry(
-            to_insert_tuple.KeyFromTuple(table_info_->schema_, index->key_schema_, index->index_->GetKeyAttrs()),
-            rid_tmp.value(), exec_ctx_->GetTransaction());
-      }
-      insert_count++;
+  // Read the whole child first: a new tuple may land in a page the child has yet to scan, e.g. in free space that
+  // deletes left, and must not be inserted again.
+  std::vector<Tuple> to_insert_tuples;
+  while (child_executor_->Next(&child_tuple, &emit_rid)) {
+    to_insert_tuples.push_back(std::move(child_tuple));
+  }
+  // lay the tuples out a page at a time, then give each index its entries in one batch
+  auto rids = table_info_->table_->InsertTuples(to_insert_tuple_meta, to_insert_tuples);
+  for (auto index : table_indexes_) {
+    std::vector<std::pair<Tuple, RID>> entries;
+    entries.reserve(rids.size());
+    for (size_t i = 0; i < rids.size(); i++) {
+      entries.emplace_back(
+          to_insert_tuples[i].KeyFromTuple(table_info_->schema_, index->key_schema_, index->index_->GetKeyAttrs()),
+          rids[i]);
     }
+    index->index_->InsertEntries(entries, exec_ctx_->GetTransaction());
   }
+  auto insert_count = static_cast<int32_t>(rids.size());
   std::vector<Value> values{};
   values.reserve(GetOutputSchema().GetColumnCount());
   Value temp{TypeId::INTEGER, insert_count};
@@ -37,4 +37,15 @@ auto LimitExecutor::Next(Tuple *tuple, RID *rid) -> bool {
   return true;
 }
 
+auto LimitExecutor::NextBatch(TupleBatch *batch) -> bool {
+  if (count_ >= plan_->GetLimit() || !child_executor_->NextBatch(batch)) {
+    batch->Clear();
+    return false;
+  }
+
+  batch->Truncate(plan_->GetLimit() - count_);
+  count_ += batch->Size();
+  return true;
+}
+
 }  // namespace bustub
@@ -11,20 +11,80 @@
 //===----------------------------------------------------------------------===//
 
 #include "execution/executors/nested_index_join_executor.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 
 NestIndexJoinExecutor::NestIndexJoinExecutor(ExecutorContext *exec_ctx, const NestedIndexJoinPlanNode *plan,
                                              std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx) {
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_executor_(std::move(child_executor)),
+      index_info_(exec_ctx_->GetCatalog()->GetIndex(plan_->GetIndexOid())),
+      table_info_(exec_ctx_->GetCatalog()->GetTable(plan_->GetInnerTableOid())) {
   if (!(plan->GetJoinType() == JoinType::LEFT || plan->GetJoinType() == JoinType::INNER)) {
     // Note for 2023 Spring: You ONLY need to implement left join and inner join.
     throw bustub::NotImplementedException(fmt::format("join type {} not supported", plan->GetJoinType()));
   }
 }
 
-void NestIndexJoinExecutor::Init() { throw NotImplementedException("NestIndexJoinExecutor is not implemented"); }
+void NestIndexJoinExecutor::Init() {
+  child_executor_->Init();
+  rids_.clear();
+  cursor_ = 0;
+}
+
+auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  const auto &left_schema = child_executor_->GetOutputSchema();
+  const auto &right_schema = plan_->InnerTableSchema();
+  while (true) {
+    // emit the remaining matches of the current outer tuple
+    while (cursor_ < rids_.size()) {
+      auto [meta, right_tuple] = table_info_->table_->GetTuple(rids_[cursor_++]);
+      // the index may only hold a prefix of long VARCHAR keys
+      if (meta.is_deleted_ || right_tuple.GetValue(&right_schema, index_info_->index_->GetKeyAttrs()[0])
+                                      .CompareEquals(key_value_) != CmpBool::CmpTrue) {
+        continue;
+      }
+      matched_ = true;
+      std::vector<Value> vals;
+      for (uint32_t idx = 0; idx < left_schema.GetColumnCount(); idx++) {
+        vals.push_back(left_tuple_.GetValue(&left_schema, idx));
+      }
+      for (uint32_t idx = 0; idx < right_schema.GetColumnCount(); idx++) {
+        vals.push_back(right_tuple.GetValue(&right_schema, idx));
+      }
+      *tuple = Tuple(vals, &GetOutputSchema());
+      return true;
+    }
+    if (probed_ && !matched_ && plan_->GetJoinType() == JoinType::LEFT) {
+      probed_ = false;
+      std::vector<Value> vals;
+      for (uint32_t idx = 0; idx < left_schema.GetColumnCount(); idx++) {
+        vals.push_back(left_tuple_.GetValue(&left_schema, idx));
+      }
+      for (uint32_t idx = 0; idx < right_schema.GetColumnCount(); idx++) {
+        vals.push_back(ValueFactory::GetNullValueByType(right_schema.GetColumn(idx).GetType()));
+      }
+      *tuple = Tuple(vals, &GetOutputSchema());
+      return true;
+    }
 
-auto NestIndexJoinExecutor::Next(Tuple *tuple, RID *rid) -> bool { return false; }
+    // probe the inner index with the next outer tuple
+    RID left_rid{};
+    if (!child_executor_->Next(&left_tuple_, &left_rid)) {
+      return false;
+    }
+    rids_.clear();
+    cursor_ = 0;
+    probed_ = true;
+    matched_ = false;
+    key_value_ = plan_->KeyPredicate()->Evaluate(&left_tuple_, left_schema);
+    if (!key_value_.IsNull()) {
+      Tuple key{{key_value_}, index_info_->index_->GetSearchKeySchema()};
+      index_info_->index_->ScanKey(key, &rids_, exec_ctx_->GetTransaction());
+    }
+  }
+}
 
 }  // namespace bustub
@@ -38,7 +38,7 @@ void NestedLoopJoinExecutor::Init() {
   Tuple tuple{};
   RID rid{};
   while (right_executor_->Next(&tuple, &rid)) {
-    right_tuples_.push_back(tuple);
+    right_tuples_.emplace_back(tuple, exec_ctx_->GetArena());
   }
 }
 
@@ -0,0 +1,116 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// pipeline_executor.cpp
+//
+// Identification: src/execution/pipeline_executor.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/executors/pipeline_executor.h"
+
+#include <utility>
+
+namespace bustub {
+
+auto PipelineExecutor::IsStreaming(const AbstractPlanNode &plan) -> bool {
+  switch (plan.GetType()) {
+    case PlanType::Filter:
+    case PlanType::Projection:
+    case PlanType::HashJoin:
+      return true;
+    default:
+      return false;
+  }
+}
+
+PipelineExecutor::PipelineExecutor(ExecutorContext *exec_ctx, AbstractPlanNodeRef plan,
+                                   std::unique_ptr<AbstractExecutor> &&source,
+                                   std::vector<std::unique_ptr<AbstractExecutor>> &&operators)
+    : AbstractExecutor(exec_ctx),
+      plan_(std::move(plan)),
+      source_(std::move(source)),
+      operators_(std::move(operators)),
+      source_batch_(&source_->GetOutputSchema()) {}
+
+void PipelineExecutor::Init() {
+  for (auto &op : operators_) {
+    op->Init();
+  }
+  source_->Init();
+  MakeOutputs([this](TupleBatch *batch) { output_batches_.push_back(*batch); }, &outputs_);
+  output_batches_.clear();
+  source_done_ = false;
+  next_row_ = 0;
+}
+
+void PipelineExecutor::Run(const BatchSink &sink) {
+  // the executors above the source are initialized first, so that a hash join builds its table before it is probed
+  for (auto &op : operators_) {
+    op->Init();
+  }
+  std::vector<BatchSink> outputs;
+  MakeOutputs(sink, &outputs);
+  auto &bottom = operators_.front();
+  source_->Run([&bottom, &outputs](TupleBatch *batch) { bottom->Consume(batch, outputs.front()); });
+  Finish(outputs);
+}
+
+void PipelineExecutor::MakeOutputs(const BatchSink &sink, std::vector<BatchSink> *outputs) {
+  outputs->clear();
+  for (size_t i = 0; i + 1 < operators_.size(); i++) {
+    outputs->emplace_back(
+        [this, i, outputs](TupleBatch *batch) { operators_[i + 1]->Consume(batch, (*outputs)[i + 1]); });
+  }
+  outputs->push_back(sink);
+}
+
+void PipelineExecutor::Finish(const std::vector<BatchSink> &outputs) {
+  for (size_t i = 0; i < operators_.size(); i++) {
+    operators_[i]->Finish(outputs[i]);
+  }
+}
+
+auto PipelineExecutor::PullSource() -> bool {
+  if (source_done_) {
+    return false;
+  }
+  if (source_->NextBatch(&source_batch_)) {
+    operators_.front()->Consume(&source_batch_, outputs_.front());
+  } else {
+    source_done_ = true;
+    Finish(outputs_);
+  }
+  return true;
+}
+
+auto PipelineExecutor::Next(Tuple *tuple, RID *rid) -> bool {
+  while (output_batches_.empty() || next_row_ == output_batches_.front().Size()) {
+    if (!output_batches_.empty()) {
+      output_batches_.pop_front();
+      next_row_ = 0;
+    } else if (!PullSource()) {
+      return false;
+    }
+  }
+  *tuple = output_batches_.front().GetTuple(next_row_++);
+  *rid = tuple->GetRid();
+  return true;
+}
+
+auto PipelineExecutor::NextBatch(TupleBatch *batch) -> bool {
+  while (output_batches_.empty()) {
+    if (!PullSource()) {
+      batch->Clear();
+      return false;
+    }
+  }
+  *batch = std::move(output_batches_.front());
+  output_batches_.pop_front();
+  return true;
+}
+
+}  // namespace bustub
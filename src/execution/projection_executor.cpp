@@ -5,11 +5,18 @@ namespace bustub {
 
 ProjectionExecutor::ProjectionExecutor(ExecutorContext *exec_ctx, const ProjectionPlanNode *plan,
                                        std::unique_ptr<AbstractExecutor> &&child_executor)
-    : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
+    : AbstractExecutor(exec_ctx),
+      plan_(plan),
+      child_executor_(std::move(child_executor)),
+      child_batch_(&plan_->GetChildPlan()->OutputSchema()),
+      columns_(plan_->GetExpressions().size()),
+      output_batch_(&plan_->OutputSchema()) {}
 
 void ProjectionExecutor::Init() {
   // Initialize the child executor
-  child_executor_->Init();
+  if (child_executor_ != nullptr) {
+    child_executor_->Init();
+  }
 }
 
 auto ProjectionExecutor::Next(Tuple *tuple, RID *rid) -> bool {
@@ -33,4 +40,26 @@ auto ProjectionExecutor::Next(Tuple *tuple, RID *rid) -> bool {
 
   return true;
 }
+
+auto ProjectionExecutor::NextBatch(TupleBatch *batch) -> bool {
+  if (!child_executor_->NextBatch(&child_batch_)) {
+    batch->Clear();
+    return false;
+  }
+
+  // Compute each expression over the whole batch
+  for (size_t i = 0; i < plan_->GetExpressions().size(); i++) {
+    plan_->GetExpressions()[i]->EvaluateBatch(child_batch_, &columns_[i]);
+  }
+  batch->SetColumns(&columns_, child_batch_.GetRids());
+  return true;
+}
+
+void ProjectionExecutor::Consume(TupleBatch *batch, const BatchSink &output) {
+  for (size_t i = 0; i < plan_->GetExpressions().size(); i++) {
+    plan_->GetExpressions()[i]->EvaluateBatch(*batch, &columns_[i]);
+  }
+  output_batch_.SetColumns(&columns_, batch->GetRids());
+  output(&output_batch_);
+}
 }  // namespace bustub
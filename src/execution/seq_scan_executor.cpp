@@ -13,34 +13,215 @@
 #include "execution/executors/seq_scan_executor.h"
 #include <memory>
 #include <utility>
+#include <vector>
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
 #include "storage/table/table_iterator.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 
+/** @return `comp_type` with its sides swapped, e.g. `a < b` as `b > a` */
+static auto SwapSides(ComparisonType comp_type) -> ComparisonType {
+  switch (comp_type) {
+    case ComparisonType::LessThan:
+      return ComparisonType::GreaterThan;
+    case ComparisonType::LessThanOrEqual:
+      return ComparisonType::GreaterThanOrEqual;
+    case ComparisonType::GreaterThan:
+      return ComparisonType::LessThan;
+    case ComparisonType::GreaterThanOrEqual:
+      return ComparisonType::LessThanOrEqual;
+    default:
+      return comp_type;
+  }
+}
+
+/**
+ * @return false if no tuple summarized by `zone` can satisfy `predicate`, true if some may. Only comparisons of a
+ * column with a constant, and their conjunctions and disjunctions, can rule a page out.
+ */
+static auto MayMatch(const AbstractExpression &predicate, const PageZone &zone) -> bool {
+  if (const auto *logic = dynamic_cast<const LogicExpression *>(&predicate); logic != nullptr) {
+    auto left = MayMatch(*logic->GetChildAt(0), zone);
+    auto right = MayMatch(*logic->GetChildAt(1), zone);
+    return logic->logic_type_ == LogicType::And ? left && right : left || right;
+  }
+  const auto *comparison = dynamic_cast<const ComparisonExpression *>(&predicate);
+  if (comparison == nullptr) {
+    return true;
+  }
+  auto comp_type = comparison->comp_type_;
+  const auto *column = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(0).get());
+  const auto *constant = dynamic_cast<const ConstantValueExpression *>(comparison->GetChildAt(1).get());
+  if (column == nullptr || constant == nullptr) {
+    column = dynamic_cast<const ColumnValueExpression *>(comparison->GetChildAt(1).get());
+    constant = dynamic_cast<const ConstantValueExpression *>(comparison->GetChildAt(0).get());
+    comp_type = SwapSides(comp_type);
+  }
+  if (column == nullptr || constant == nullptr) {
+    return true;
+  }
+
+  // a comparison with null is never true
+  const auto &value = constant->val_;
+  if (value.IsNull() || zone.AllNull(column->GetColIdx())) {
+    return false;
+  }
+  const auto &min = zone.columns_[column->GetColIdx()].min_;
+  const auto &max = zone.columns_[column->GetColIdx()].max_;
+  if (!min.CheckComparable(value) || (min.GetTypeId() == TypeId::VARCHAR) != (value.GetTypeId() == TypeId::VARCHAR)) {
+    return true;
+  }
+  switch (comp_type) {
+    case ComparisonType::Equal:
+      return min.CompareLessThanEquals(value) == CmpBool::CmpTrue &&
+             max.CompareGreaterThanEquals(value) == CmpBool::CmpTrue;
+    case ComparisonType::NotEqual:
+      return min.CompareNotEquals(value) == CmpBool::CmpTrue || max.CompareNotEquals(value) == CmpBool::CmpTrue;
+    case ComparisonType::LessThan:
+      return min.CompareLessThan(value) == CmpBool::CmpTrue;
+    case ComparisonType::LessThanOrEqual:
+      return min.CompareLessThanEquals(value) == CmpBool::CmpTrue;
+    case ComparisonType::GreaterThan:
+      return max.CompareGreaterThan(value) == CmpBool::CmpTrue;
+    case ComparisonType::GreaterThanOrEqual:
+      return max.CompareGreaterThanEquals(value) == CmpBool::CmpTrue;
+  }
+  return true;
+}
+
 SeqScanExecutor::SeqScanExecutor(ExecutorContext *exec_ctx, const SeqScanPlanNode *plan)
     : AbstractExecutor(exec_ctx),
       plan_(plan),
       table_info_(exec_ctx_->GetCatalog()->GetTable(plan_->table_oid_)),
-      table_iter_(table_info_->table_->MakeIterator()) {}
+      table_iter_(table_info_->table_->MakeIterator()) {
+  const auto *zone_map = table_info_->table_->GetZoneMap();
+  if (plan_->filter_predicate_ != nullptr && zone_map != nullptr) {
+    page_filter_ = [zone_map, predicate = plan_->filter_predicate_](page_id_t page_id) {
+      auto zone = zone_map->Get(page_id);
+      return !zone.has_value() || MayMatch(*predicate, *zone);
+    };
+  }
+  if (plan_->columns_.has_value() && table_info_->table_->GetLayout() == TableLayout::PAX) {
+    column_iter_.emplace(table_info_->table_->MakeColumnIterator(*plan_->columns_, page_filter_));
+  } else if (plan_->columns_.has_value()) {
+    table_iter_.ReadColumns(*plan_->columns_);
+  }
+}
 
 void SeqScanExecutor::Init() {}
 
+void SeqScanExecutor::SetMorsel(TableIterator &&morsel) {
+  BUSTUB_ASSERT(!column_iter_.has_value(), "a columnar scan is not split into morsels");
+  table_iter_ = std::move(morsel);
+  if (plan_->columns_.has_value()) {
+    table_iter_.ReadColumns(*plan_->columns_);
+  }
+  checked_page_id_ = INVALID_PAGE_ID;
+}
+
+auto SeqScanExecutor::Matches(const TupleView &tuple) const -> bool {
+  if (plan_->filter_predicate_ == nullptr) {
+    return true;
+  }
+  auto value = plan_->filter_predicate_->EvaluateView(tuple, GetOutputSchema());
+  return !value.IsNull() && value.GetAs<bool>();
+}
+
+auto SeqScanExecutor::ReadColumnValues() const -> std::vector<Value> {
+  const auto &schema = table_info_->schema_;
+  std::vector<Value> values;
+  values.reserve(schema.GetColumnCount());
+  for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+    values.push_back(ValueFactory::GetNullValueByType(schema.GetColumn(i).GetType()));
+  }
+  for (size_t i = 0; i < plan_->columns_->size(); i++) {
+    values[(*plan_->columns_)[i]] = column_iter_->GetValue(i);
+  }
+  return values;
+}
+
 auto SeqScanExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (table_iter_.IsEnd()) {
+  if (column_iter_.has_value()) {
+    auto &iter = *column_iter_;
+    for (; !iter.IsEnd(); ++iter) {
+      if (iter.GetTupleMeta().is_deleted_) {
+        continue;
+      }
+      Tuple result(ReadColumnValues(), &table_info_->schema_);
+      if (Matches(TupleView(result))) {
+        *tuple = std::move(result);
+        *rid = iter.GetRID();
+        ++iter;
+        return true;
+      }
+    }
     return false;
   }
-  auto meta = table_iter_.GetTuple().first;
-  while (!table_iter_.IsEnd() && meta.is_deleted_) {
-    ++table_iter_;
-    if (table_iter_.IsEnd()) {
-      return false;
+
+  while (!table_iter_.IsEnd()) {
+    auto current_rid = table_iter_.GetRID();
+    // the zone of each page is looked up once, as the scan enters it
+    if (page_filter_ != nullptr && current_rid.GetPageId() != checked_page_id_) {
+      checked_page_id_ = current_rid.GetPageId();
+      if (!page_filter_(checked_page_id_)) {
+        table_iter_.SkipPage();
+        continue;
+      }
+    }
+    // the filter reads the tuples in the page, and only the one that passes it is copied out
+    auto result = table_iter_.NextInPage(
+        [this](const TupleMeta &meta, const TupleView &view) { return !meta.is_deleted_ && Matches(view); });
+    if (result.has_value()) {
+      *rid = result->GetRid();
+      *tuple = std::move(*result);
+      return true;
     }
-    meta = table_iter_.GetTuple().first;
   }
-  *tuple = table_iter_.GetTuple().second;
-  *rid = table_iter_.GetRID();
-  ++table_iter_;
-  return true;
+  return false;
+}
+
+auto SeqScanExecutor::NextBatch(TupleBatch *batch) -> bool {
+  batch->Clear();
+  if (column_iter_.has_value()) {
+    auto &iter = *column_iter_;
+    std::vector<Value> predicate;
+    while (batch->IsEmpty() && !iter.IsEnd()) {
+      for (; !iter.IsEnd() && !batch->IsFull(); ++iter) {
+        if (!iter.GetTupleMeta().is_deleted_) {
+          batch->AppendRow(ReadColumnValues(), iter.GetRID());
+        }
+      }
+      // the predicate is evaluated over the columns read, a batch at a time
+      if (plan_->filter_predicate_ != nullptr) {
+        batch->Select(plan_->filter_predicate_->EvaluateBatchRef(*batch, &predicate));
+      }
+    }
+    return !batch->IsEmpty();
+  }
+
+  while (!batch->IsFull() && !table_iter_.IsEnd()) {
+    auto current_rid = table_iter_.GetRID();
+    if (page_filter_ != nullptr && current_rid.GetPageId() != checked_page_id_) {
+      checked_page_id_ = current_rid.GetPageId();
+      if (!page_filter_(checked_page_id_)) {
+        table_iter_.SkipPage();
+        continue;
+      }
+    }
+    // the filter reads the tuples in place, and those that pass it go straight into the batch; the page is left once
+    // the batch is full, and the tuple that filled it is also handed back, then dropped
+    table_iter_.NextInPage([this, batch](const TupleMeta &meta, const TupleView &view) {
+      if (!meta.is_deleted_ && Matches(view)) {
+        batch->AppendView(view);
+      }
+      return batch->IsFull();
+    });
+  }
+  return !batch->IsEmpty();
 }
 
 }  // namespace bustub
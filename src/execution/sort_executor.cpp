@@ -1,6 +1,9 @@
 #include "execution/executors/sort_executor.h"
+#include <algorithm>
 #include <utility>
 
+#include "execution/executors/gather_executor.h"
+
 namespace bustub {
 
 SortExecutor::SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan,
@@ -8,59 +11,111 @@ SortExecutor::SortExecutor(ExecutorContext *exec_ctx, const SortPlanNode *plan,
     : AbstractExecutor(exec_ctx), plan_(plan), child_(std::move(child_executor)) {}
 
 void SortExecutor::Init() {
-  child_->Init();
-  Tuple child_tuple{};
-  RID child_rid;
-  while (child_->Next(&child_tuple, &child_rid)) {
-    child_tuples_.push_back(child_tuple);
+  runs_.clear();
+  auto sort = [](std::vector<SortEntry> *entries) {
+    std::sort(entries->begin(), entries->end(), [](const SortEntry &a, const SortEntry &b) { return a.key_ < b.key_; });
+  };
+
+  if (auto *gather = dynamic_cast<GatherExecutor *>(child_.get()); gather != nullptr) {
+    // each worker sorts the tuples it scanned into a run of its own
+    std::vector<std::vector<SortEntry>> worker_entries(gather->GetWorkerCount());
+    gather->RunPipeline([this, &worker_entries](size_t worker, [[maybe_unused]] size_t morsel,
+                                                const TupleBatch &batch) {
+      AppendEntries(batch, exec_ctx_->GetArena(), &worker_entries[worker]);
+    });
+    runs_.resize(worker_entries.size());
+    GatherExecutor::RunOnWorkers(worker_entries.size(), [this, &worker_entries, &sort](size_t worker) {
+      sort(&worker_entries[worker]);
+      runs_[worker].entries_ = std::move(worker_entries[worker]);
+    });
+  } else {
+    // a run is cut every time the tuples take up the memory budget, and spilled. What is spilled is not allocated from
+    // the arena, which would keep its memory until the query ends.
+    auto budget = exec_ctx_->GetMemoryBudget();
+    auto *arena = budget > 0 ? nullptr : exec_ctx_->GetArena();
+    std::vector<SortEntry> entries;
+    size_t bytes = 0;
+    child_->Run([this, &sort, budget, arena, &entries, &bytes](TupleBatch *batch) {
+      bytes += AppendEntries(*batch, arena, &entries);
+      if (budget > 0 && bytes > budget) {
+        sort(&entries);
+        SpillRun(&entries);
+        bytes = 0;
+      }
+    });
+    // the last run is kept in memory
+    sort(&entries);
+    runs_.emplace_back().entries_ = std::move(entries);
   }
-  std::sort(
-      child_tuples_.begin(), child_tuples_.end(),
-      [order_bys = plan_->order_bys_, schema = child_->GetOutputSchema()](const Tuple &tuple_a, const Tuple &tuple_b) {
-        for (const auto &order_key : order_bys) {
-          switch (order_key.first) {
-            case OrderByType::INVALID:
-            case OrderByType::DEFAULT:
-            case OrderByType::ASC: {
-              if (static_cast<bool>(order_key.second->Evaluate(&tuple_a, schema)
-                                        .CompareLessThan(order_key.second->Evaluate(&tuple_b, schema)))) {
-                return true;
-              }
-              if (static_cast<bool>(order_key.second->Evaluate(&tuple_a, schema)
-                                        .CompareGreaterThan(order_key.second->Evaluate(&tuple_b, schema)))) {
-                return false;
-              }
-              break;
-            }
-            case OrderByType::DESC: {
-              if (static_cast<bool>(order_key.second->Evaluate(&tuple_a, schema)
-                                        .CompareGreaterThan(order_key.second->Evaluate(&tuple_b, schema)))) {
-                return true;
-              }
-              if (static_cast<bool>(order_key.second->Evaluate(&tuple_a, schema)
-                                        .CompareLessThan(order_key.second->Evaluate(&tuple_b, schema)))) {
-                return false;
-              }
-              break;
-            }
-          }
-        }
-        return false;
-      });
 
-  child_iter_ = child_tuples_.begin();
+  merge_ = std::make_unique<LoserTree<RunLess>>(runs_.size(), RunLess{this});
 }
 
 auto SortExecutor::Next(Tuple *tuple, RID *rid) -> bool {
-  if (child_iter_ == child_tuples_.end()) {
+  auto &run = runs_[merge_->Top()];
+  if (run.IsExhausted()) {
     return false;
   }
 
-  *tuple = *child_iter_;
+  *tuple = std::move(run.entries_[run.pos_].tuple_);
   *rid = tuple->GetRid();
-  ++child_iter_;
+  run.pos_++;
+  ReadBack(&run);
+  merge_->Pop();
 
   return true;
 }
 
+auto SortExecutor::RunLess::operator()(size_t a, size_t b) const -> bool {
+  const auto &run_a = sort_->runs_[a];
+  const auto &run_b = sort_->runs_[b];
+  if (run_a.IsExhausted()) {
+    return false;
+  }
+  if (run_b.IsExhausted()) {
+    return true;
+  }
+  return run_a.entries_[run_a.pos_].key_ < run_b.entries_[run_b.pos_].key_;
+}
+
+auto SortExecutor::AppendEntries(const TupleBatch &batch, Arena *arena, std::vector<SortEntry> *entries) const
+    -> size_t {
+  std::vector<SortKey> keys;
+  MakeSortKeys(plan_->order_bys_, batch, &keys);
+  size_t bytes = 0;
+  for (size_t row = 0; row < batch.Size(); row++) {
+    auto &entry = entries->emplace_back();
+    entry.key_ = std::move(keys[row]);
+    entry.tuple_ = batch.GetTuple(row, arena);
+    bytes += sizeof(SortEntry) + entry.tuple_.GetLength() + entry.key_.capacity();
+  }
+  return bytes;
+}
+
+void SortExecutor::SpillRun(std::vector<SortEntry> *entries) {
+  auto &run = runs_.emplace_back();
+  run.heap_ = std::make_unique<TmpTupleHeap>(exec_ctx_->GetBufferPoolManager());
+  for (const auto &entry : *entries) {
+    run.heap_->Append(entry.tuple_);
+  }
+  std::vector<SortEntry>().swap(*entries);
+  ReadBack(&run);
+}
+
+void SortExecutor::ReadBack(SortRun *run) const {
+  if (!run->IsExhausted() || run->heap_ == nullptr || run->next_page_ == run->heap_->GetPageCount()) {
+    return;
+  }
+  // the sort keys are made again from the tuples read back, which is all that is spilled
+  std::vector<Tuple> tuples;
+  run->heap_->ReadPage(run->next_page_++, &tuples);
+  run->entries_.clear();
+  run->pos_ = 0;
+  for (auto &tuple : tuples) {
+    auto &entry = run->entries_.emplace_back();
+    entry.key_ = MakeSortKey(plan_->order_bys_, tuple, child_->GetOutputSchema());
+    entry.tuple_ = std::move(tuple);
+  }
+}
+
 }  // namespace bustub
@@ -0,0 +1,104 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key.cpp
+//
+// Identification: src/execution/sort_key.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/sort_key.h"
+
+#include <cstring>
+
+#include "common/exception.h"
+
+namespace bustub {
+
+static constexpr uint64_t SIGN_BIT = uint64_t{1} << 63;
+
+/** Append the 8 bytes of `bits` to `key`, the most significant first */
+static void AppendBigEndian(uint64_t bits, SortKey *key) {
+  for (int shift = 56; shift >= 0; shift -= 8) {
+    key->push_back(static_cast<char>((bits >> shift) & 0xFF));
+  }
+}
+
+void AppendSortKey(const Value &value, OrderByType order_by_type, SortKey *key) {
+  auto begin = key->size();
+  if (value.IsNull()) {
+    key->push_back(0);
+  } else {
+    key->push_back(1);
+    switch (value.GetTypeId()) {
+      case TypeId::BOOLEAN:
+        key->push_back(value.GetAs<int8_t>());
+        break;
+      case TypeId::TINYINT:
+        AppendBigEndian(static_cast<uint64_t>(static_cast<int64_t>(value.GetAs<int8_t>())) ^ SIGN_BIT, key);
+        break;
+      case TypeId::SMALLINT:
+        AppendBigEndian(static_cast<uint64_t>(static_cast<int64_t>(value.GetAs<int16_t>())) ^ SIGN_BIT, key);
+        break;
+      case TypeId::INTEGER:
+        AppendBigEndian(static_cast<uint64_t>(static_cast<int64_t>(value.GetAs<int32_t>())) ^ SIGN_BIT, key);
+        break;
+      case TypeId::BIGINT:
+        AppendBigEndian(static_cast<uint64_t>(value.GetAs<int64_t>()) ^ SIGN_BIT, key);
+        break;
+      case TypeId::DECIMAL: {
+        auto decimal = value.GetAs<double>();
+        uint64_t bits;
+        std::memcpy(&bits, &decimal, sizeof(bits));
+        AppendBigEndian((bits & SIGN_BIT) != 0 ? ~bits : bits ^ SIGN_BIT, key);
+        break;
+      }
+      case TypeId::TIMESTAMP:
+        AppendBigEndian(value.GetAs<uint64_t>(), key);
+        break;
+      case TypeId::VARCHAR: {
+        const char *data = value.GetData();
+        for (uint32_t i = 0; i + 1 < value.GetLength(); i++) {
+          key->push_back(data[i]);
+          if (data[i] == 0) {
+            key->push_back(static_cast<char>(0xFF));
+          }
+        }
+        key->push_back(0);
+        key->push_back(0);
+        break;
+      }
+      case TypeId::INVALID:
+        throw ExecutionException("cannot sort by a value of an invalid type");
+    }
+  }
+  if (order_by_type == OrderByType::DESC) {
+    for (auto i = begin; i < key->size(); i++) {
+      (*key)[i] = static_cast<char>(~(*key)[i]);
+    }
+  }
+}
+
+auto MakeSortKey(const OrderBys &order_bys, const Tuple &tuple, const Schema &schema) -> SortKey {
+  SortKey key;
+  for (const auto &[order_by_type, expr] : order_bys) {
+    AppendSortKey(expr->Evaluate(&tuple, schema), order_by_type, &key);
+  }
+  return key;
+}
+
+void MakeSortKeys(const OrderBys &order_bys, const TupleBatch &batch, std::vector<SortKey> *keys) {
+  keys->assign(batch.Size(), SortKey{});
+  std::vector<Value> values;
+  for (const auto &[order_by_type, expr] : order_bys) {
+    const auto &column = expr->EvaluateBatchRef(batch, &values);
+    for (size_t row = 0; row < batch.Size(); row++) {
+      AppendSortKey(column[row], order_by_type, &(*keys)[row]);
+    }
+  }
+}
+
+}  // namespace bustub
@@ -8,54 +8,30 @@ TopNExecutor::TopNExecutor(ExecutorContext *exec_ctx, const TopNPlanNode *plan,
     : AbstractExecutor(exec_ctx), plan_(plan), child_executor_(std::move(child_executor)) {}
 
 void TopNExecutor::Init() {
-  child_executor_->Init();
-
-  auto cmp = [order_bys = plan_->order_bys_, schema = child_executor_->GetOutputSchema()](const Tuple &a,
-                                                                                          const Tuple &b) {
-    for (const auto &order_key : order_bys) {
-      switch (order_key.first) {
-        case OrderByType::INVALID:
-        case OrderByType::DEFAULT:
-        case OrderByType::ASC: {
-          if (static_cast<bool>(
-                  order_key.second->Evaluate(&a, schema).CompareLessThan(order_key.second->Evaluate(&b, schema)))) {
-            return true;
-          }
-          if (static_cast<bool>(
-                  order_key.second->Evaluate(&a, schema).CompareGreaterThan(order_key.second->Evaluate(&b, schema)))) {
-            return false;
-          }
-          break;
-        }
-        case OrderByType::DESC: {
-          if (static_cast<bool>(
-                  order_key.second->Evaluate(&a, schema).CompareGreaterThan(order_key.second->Evaluate(&b, schema)))) {
-            return true;
-          }
-          if (static_cast<bool>(
-                  order_key.second->Evaluate(&a, schema).CompareLessThan(order_key.second->Evaluate(&b, schema)))) {
-            return false;
-          }
-          break;
-        }
+  // with no entry to keep, the heap would be empty whenever its top is compared to a row
+  if (plan_->GetN() == 0) {
+    return;
+  }
+  // the heap keeps the n entries that come first, the one that comes last on top
+  auto cmp = [](const SortEntry &a, const SortEntry &b) { return a.key_ < b.key_; };
+  std::priority_queue<SortEntry, std::vector<SortEntry>, decltype(cmp)> pq(cmp);
+
+  std::vector<SortKey> keys;
+  child_executor_->Run([this, &pq, &keys](TupleBatch *batch) {
+    MakeSortKeys(plan_->order_bys_, *batch, &keys);
+    for (size_t row = 0; row < batch->Size(); row++) {
+      if (pq.size() == plan_->GetN() && !(keys[row] < pq.top().key_)) {
+        continue;
+      }
+      pq.push(SortEntry{std::move(keys[row]), batch->GetTuple(row)});
+      if (pq.size() > plan_->GetN()) {
+        pq.pop();
       }
     }
-    return false;
-  };
-
-  std::priority_queue<Tuple, std::vector<Tuple>, decltype(cmp)> pq(cmp);
-
-  Tuple child_tuple{};
-  RID child_rid;
-  while (child_executor_->Next(&child_tuple, &child_rid)) {
-    pq.push(child_tuple);
-    if (pq.size() > plan_->GetN()) {
-      pq.pop();
-    }
-  }
+  });
 
   while (!pq.empty()) {
-    child_tuples_.push(pq.top());
+    child_tuples_.push(pq.top().tuple_);
     pq.pop();
   }
 }
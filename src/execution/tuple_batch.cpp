@@ -0,0 +1,107 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_batch.cpp
+//
+// Identification: src/execution/tuple_batch.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "execution/tuple_batch.h"
+
+#include <utility>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+TupleBatch::TupleBatch(const Schema *schema) : schema_(schema), columns_(schema->GetColumnCount()) {
+  for (auto &column : columns_) {
+    column.reserve(TUPLE_BATCH_SIZE);
+  }
+  rids_.reserve(TUPLE_BATCH_SIZE);
+}
+
+void TupleBatch::Clear() {
+  for (auto &column : columns_) {
+    column.clear();
+  }
+  rids_.clear();
+}
+
+void TupleBatch::AppendTuple(const Tuple &tuple, RID rid) {
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    columns_[i].push_back(tuple.GetValue(schema_, i));
+  }
+  rids_.push_back(rid);
+}
+
+void TupleBatch::AppendView(const TupleView &tuple) {
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    columns_[i].push_back(tuple.GetValue(schema_, i));
+  }
+  rids_.push_back(tuple.GetRid());
+}
+
+void TupleBatch::AppendRow(std::vector<Value> values, RID rid) {
+  BUSTUB_ASSERT(values.size() == columns_.size(), "one value per column expected");
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    // a Value has no move constructor, so it is swapped in rather than copied
+    Swap(columns_[i].emplace_back(), values[i]);
+  }
+  rids_.push_back(rid);
+}
+
+auto TupleBatch::GetTuple(size_t row, Arena *arena) const -> Tuple {
+  std::vector<Value> values;
+  values.reserve(columns_.size());
+  for (const auto &column : columns_) {
+    values.push_back(column[row]);
+  }
+  Tuple tuple(std::move(values), schema_, arena);
+  tuple.rid_ = rids_[row];
+  return tuple;
+}
+
+void TupleBatch::Select(const std::vector<Value> &predicate) {
+  BUSTUB_ASSERT(predicate.size() == rids_.size(), "one predicate value per row expected");
+  // the rows kept are moved down in place, so that the columns keep their memory
+  size_t kept = 0;
+  for (size_t row = 0; row < rids_.size(); row++) {
+    if (predicate[row].IsNull() || !predicate[row].GetAs<bool>()) {
+      continue;
+    }
+    if (kept != row) {
+      for (auto &column : columns_) {
+        Swap(column[kept], column[row]);
+      }
+      rids_[kept] = rids_[row];
+    }
+    kept++;
+  }
+  Truncate(kept);
+}
+
+void TupleBatch::Truncate(size_t size) {
+  if (size >= rids_.size()) {
+    return;
+  }
+  for (auto &column : columns_) {
+    column.resize(size);
+  }
+  rids_.resize(size);
+}
+
+void TupleBatch::SetColumns(std::vector<std::vector<Value>> *columns, const std::vector<RID> &rids) {
+  BUSTUB_ASSERT(columns->size() == columns_.size(), "one vector of values per column expected");
+  for (uint32_t i = 0; i < columns_.size(); i++) {
+    BUSTUB_ASSERT((*columns)[i].size() == rids.size(), "one value per row expected");
+    columns_[i].swap((*columns)[i]);
+  }
+  rids_ = rids;
+}
+
+}  // namespace bustub
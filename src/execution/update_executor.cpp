@@ -36,11 +36,17 @@ auto UpdateExecutor::Next([[maybe_unused]] Tuple *tuple, RID *rid) -> bool {
   if (is_end_) {
     return false;
   }
-  Tuple to_update_tuple{};
+  Tuple child_tuple{};
+  RID child_rid;
+  // Read the whole child first: the new version of a tuple may land in a page the child has yet to scan, e.g. in free
+  // space that deletes left, and must not be updated again.
+  std::vector<std::pair<Tuple, RID>> to_update_tuples;
+  while (child_executor_->Next(&child_tuple, &child_rid)) {
+    to_update_tuples.emplace_back(std::move(child_tuple), child_rid);
+  }
 
-  RID emit_rid;
   int32_t update_count = 0;
-  while (child_executor_->Next(&to_update_tuple, &emit_rid)) {
+  for (auto &[to_update_tuple, emit_rid] : to_update_tuples) {
     auto to_delete_tuple_meta = table_info_->table_->GetTupleMeta(emit_rid);
     to_delete_tuple_meta.is_deleted_ = true;
     table_info_->table_->UpdateTupleMeta(to_delete_tuple_meta, emit_rid);
@@ -0,0 +1,49 @@
+//===----------------------------------------------------------------------===//
+//                         BusTub
+//
+// binder/copy_statement.h
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "binder/bound_statement.h"
+#include "binder/table_ref/bound_base_table_ref.h"
+#include "common/enums/statement_type.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+/** `COPY table FROM 'file'`, loading the rows of a CSV file into a table. */
+class CopyStatement : public BoundStatement {
+ public:
+  CopyStatement(std::unique_ptr<BoundBaseTableRef> table, std::string file_path, char delimiter, bool header)
+      : BoundStatement(StatementType::COPY_STATEMENT),
+        table_(std::move(table)),
+        file_path_(std::move(file_path)),
+        delimiter_(delimiter),
+        header_(header) {}
+
+  /** The table to load into */
+  std::unique_ptr<BoundBaseTableRef> table_;
+
+  /** The CSV file to read */
+  std::string file_path_;
+
+  /** The character between two fields */
+  char delimiter_;
+
+  /** Whether the first line holds the column names, and is skipped */
+  bool header_;
+
+  auto ToString() const -> std::string override {
+    return fmt::format("BoundCopy {{ table={}, file={}, delimiter='{}', header={} }}", table_->ToString(), file_path_,
+                       delimiter_, header_);
+  }
+};
+
+}  // namespace bustub
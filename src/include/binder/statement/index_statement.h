@@ -21,7 +21,8 @@ namespace bustub {
 class IndexStatement : public BoundStatement {
  public:
   explicit IndexStatement(std::string index_name, std::unique_ptr<BoundBaseTableRef> table,
-                          std::vector<std::unique_ptr<BoundColumnRef>> cols);
+                          std::vector<std::unique_ptr<BoundColumnRef>> cols, std::string index_type,
+                          std::vector<std::unique_ptr<BoundColumnRef>> include_cols = {});
 
   /** Name of the index */
   std::string index_name_;
@@ -32,6 +33,12 @@ class IndexStatement : public BoundStatement {
   /** Name of the columns */
   std::vector<std::unique_ptr<BoundColumnRef>> cols_;
 
+  /** Access method given in `USING`, e.g. `hash` */
+  std::string index_type_;
+
+  /** Columns stored in the index but not searched on, given in `WITH (include = 'a, b')` */
+  std::vector<std::unique_ptr<BoundColumnRef>> include_cols_;
+
   auto ToString() const -> std::string override;
 };
 
@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arena.h
+//
+// Identification: src/include/common/arena.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <type_traits>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+/** The size of the blocks an arena takes from the heap */
+static constexpr size_t ARENA_BLOCK_SIZE = 64 * 1024;
+
+/**
+ * Arena hands out memory from large blocks and never frees it one allocation at a time: every block is freed at once
+ * when the arena goes away. Many small allocations that all die together, e.g. the tuples a query materializes, then
+ * cost a pointer bump each instead of a malloc and a free.
+ */
+class Arena {
+ public:
+  Arena() = default;
+  ~Arena() = default;
+
+  DISALLOW_COPY_AND_MOVE(Arena);
+
+  /**
+   * Allocate memory that stays valid as long as the arena.
+   * @param size the number of bytes
+   * @param alignment the alignment of the memory, a power of two no larger than that of `std::max_align_t`
+   */
+  auto Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) -> void *;
+
+  /** @return the number of allocations made so far */
+  auto GetAllocationCount() const -> size_t;
+
+  /** @return the number of blocks taken from the heap so far */
+  auto GetBlockCount() const -> size_t;
+
+ private:
+  mutable std::mutex latch_;
+  std::vector<std::unique_ptr<char[]>> blocks_; /* protected by latch_ */
+  char *cursor_{nullptr};                       /* protected by latch_ */
+  char *end_{nullptr};                          /* protected by latch_ */
+  size_t allocation_count_{0};                  /* protected by latch_ */
+};
+
+/**
+ * ArenaAllocator lets a standard container allocate from an arena, or from the heap if it has none. Memory given back
+ * to an arena is only reclaimed with the arena.
+ *
+ * A copy of a container never shares the arena of the original: it allocates from the heap, unless it is given an
+ * allocator, so that what is copied out of a query outlives it. Assigning or swapping containers never moves the
+ * arena either.
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+  using is_always_equal = std::false_type;
+
+  ArenaAllocator() = default;
+  explicit ArenaAllocator(Arena *arena) : arena_(arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other) : arena_(other.GetArena()) {}  // NOLINT
+
+  auto allocate(size_t n) -> T * {  // NOLINT
+    if (arena_ == nullptr) {
+      return std::allocator<T>{}.allocate(n);
+    }
+    return static_cast<T *>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T *p, size_t n) {  // NOLINT
+    if (arena_ == nullptr) {
+      std::allocator<T>{}.deallocate(p, n);
+    }
+  }
+
+  auto select_on_container_copy_construction() const -> ArenaAllocator { return {}; }  // NOLINT
+
+  auto GetArena() const -> Arena * { return arena_; }
+
+  template <typename U>
+  auto operator==(const ArenaAllocator<U> &other) const -> bool {
+    return arena_ == other.GetArena();
+  }
+
+  template <typename U>
+  auto operator!=(const ArenaAllocator<U> &other) const -> bool {
+    return arena_ != other.GetArena();
+  }
+
+ private:
+  Arena *arena_{nullptr};
+};
+
+}  // namespace bustub
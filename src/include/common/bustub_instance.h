@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cctype>
 #include <iostream>
 #include <memory>
 #include <optional>
@@ -47,6 +49,8 @@ class IndexStatement;
 class VariableSetStatement;
 class VariableShowStatement;
 class ExplainStatement;
+class VacuumStatement;
+class CopyStatement;
 
 class ResultWriter {
  public:
@@ -275,6 +279,37 @@ class BustubInstance {
     return variable == "1" || variable == "true" || variable == "yes";
   }
 
+  auto IsQueryArenaEnabled() -> bool {
+    auto variable = StringUtil::Lower(GetSessionVariable("query_arena"));
+    return !(variable == "0" || variable == "false" || variable == "no");
+  }
+
+  /** @return whether queries may run push-based pipelines, unless `push_pipelines` is set to false */
+  auto IsPushPipelinesEnabled() -> bool {
+    auto variable = StringUtil::Lower(GetSessionVariable("push_pipelines"));
+    return !(variable == "0" || variable == "false" || variable == "no");
+  }
+
+  /** @return the number of workers a query runs its pipelines on, 1 unless `parallelism` is set to more */
+  auto GetParallelism() -> size_t {
+    auto variable = GetSessionVariable("parallelism");
+    // anything but a small number runs the query on its own thread
+    if (variable.empty() || variable.size() > 3 || !std::all_of(variable.begin(), variable.end(), ::isdigit)) {
+      return 1;
+    }
+    return std::clamp<size_t>(std::stoul(variable), 1, MAX_PARALLELISM);
+  }
+
+  /** @return the bytes the hash tables of a query may take before they spill, 0 unless `memory_budget` is set */
+  auto GetMemoryBudget() -> size_t {
+    // the budget is set in kilobytes, and anything but a number leaves the hash tables unbounded
+    auto variable = GetSessionVariable("memory_budget");
+    if (variable.empty() || variable.size() > 9 || !std::all_of(variable.begin(), variable.end(), ::isdigit)) {
+      return 0;
+    }
+    return std::stoul(variable) * 1024;
+  }
+
  private:
   void CmdDisplayTables(ResultWriter &writer);
   void CmdDisplayIndices(ResultWriter &writer);
@@ -286,6 +321,8 @@ class BustubInstance {
   void HandleExplainStatement(Transaction *txn, const ExplainStatement &stmt, ResultWriter &writer);
   void HandleVariableShowStatement(Transaction *txn, const VariableShowStatement &stmt, ResultWriter &writer);
   void HandleVariableSetStatement(Transaction *txn, const VariableSetStatement &stmt, ResultWriter &writer);
+  void HandleVacuumStatement(Transaction *txn, const VacuumStatement &stmt, ResultWriter &writer);
+  void HandleCopyStatement(Transaction *txn, const CopyStatement &stmt, ResultWriter &writer);
 
   std::unordered_map<std::string, std::string> session_variables_;
 };
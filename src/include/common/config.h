@@ -36,6 +36,8 @@ static constexpr int BUFFER_POOL_SIZE = 10;
 static constexpr int LOG_BUFFER_SIZE = ((BUFFER_POOL_SIZE + 1) * BUSTUB_PAGE_SIZE);  // size of a log buffer in byte
 static constexpr int BUCKET_SIZE = 50;                                               // size of extendible hash bucket
 static constexpr int LRUK_REPLACER_K = 10;  // lookback window for lru-k replacer
+static constexpr int BPLUSTREE_PATH_CACHE_LEVELS = 2;  // number of upper b+ tree levels cached for point lookups
+static constexpr int MAX_PARALLELISM = 64;            // most workers the pipelines of a query run on
 
 using frame_id_t = int32_t;    // frame id type
 using page_id_t = int32_t;     // page id type
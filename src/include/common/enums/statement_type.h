@@ -32,6 +32,8 @@ enum class StatementType : uint8_t {
   INDEX_STATEMENT,          // index statement type
   VARIABLE_SET_STATEMENT,   // set variable statement type
   VARIABLE_SHOW_STATEMENT,  // show variable statement type
+  VACUUM_STATEMENT,         // vacuum statement type
+  COPY_STATEMENT,           // copy statement type
 };
 
 }  // namespace bustub
@@ -75,6 +77,12 @@ struct fmt::formatter<bustub::StatementType> : formatter<string_view> {
       case bustub::StatementType::VARIABLE_SET_STATEMENT:
         name = "VariableSet";
         break;
+      case bustub::StatementType::VACUUM_STATEMENT:
+        name = "Vacuum";
+        break;
+      case bustub::StatementType::COPY_STATEMENT:
+        name = "Copy";
+        break;
     }
     return formatter<string_view>::format(name, ctx);
   }
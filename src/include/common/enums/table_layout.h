@@ -0,0 +1,45 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_layout.h
+//
+// Identification: src/include/enums/table_layout.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "common/config.h"
+#include "fmt/format.h"
+
+namespace bustub {
+
+//===--------------------------------------------------------------------===//
+// Table Layouts
+//===--------------------------------------------------------------------===//
+enum class TableLayout : uint8_t {
+  ROW,  // each tuple stored whole, in a slotted page
+  PAX,  // the tuples of a page split by column, each column in its own minipage
+};
+
+}  // namespace bustub
+
+template <>
+struct fmt::formatter<bustub::TableLayout> : formatter<string_view> {
+  template <typename FormatContext>
+  auto format(bustub::TableLayout c, FormatContext &ctx) const {
+    string_view name;
+    switch (c) {
+      case bustub::TableLayout::ROW:
+        name = "row";
+        break;
+      case bustub::TableLayout::PAX:
+        name = "pax";
+        break;
+    }
+    return formatter<string_view>::format(name, ctx);
+  }
+};
@@ -121,6 +121,14 @@ class DiskExtendibleHashTable {
    */
   auto KeyToPageId(KeyType key, HashTableDirectoryPage *dir_page) -> page_id_t;
 
+  /**
+   * Fetches a page from the buffer pool manager, throwing if the pool is exhausted.
+   *
+   * @param page_id the page_id to fetch
+   * @return a pointer to the pinned page
+   */
+  auto FetchPage(page_id_t page_id) -> Page *;
+
   /**
    * Fetches the directory page from the buffer pool manager.
    *
@@ -136,6 +144,15 @@ class DiskExtendibleHashTable {
    */
   auto FetchBucketPage(page_id_t bucket_page_id) -> HASH_TABLE_BUCKET_TYPE *;
 
+  /**
+   * Fetches and latches the bucket page for a key. The directory is read-latched until the bucket latch is held.
+   *
+   * @param key the key for lookup
+   * @param exclusive whether to write-latch the bucket instead of read-latching it
+   * @return the pinned and latched bucket page
+   */
+  auto FetchBucketLatched(const KeyType &key, bool exclusive) -> Page *;
+
   /**
    * Performs insertion with an optional bucket splitting.
    *
@@ -161,12 +178,25 @@ class DiskExtendibleHashTable {
    */
   void Merge(Transaction *transaction, const KeyType &key, const ValueType &value);
 
+  /**
+   * Doubles the directory under the exclusive table latch, unless another thread already did so.
+   *
+   * @param global_depth the global depth observed when the full bucket was found
+   */
+  void GrowDirectory(uint32_t global_depth);
+
+  /**
+   * Halves the directory under the exclusive table latch as long as no bucket needs the full global depth.
+   */
+  void ShrinkDirectory();
+
   // member variables
   page_id_t directory_page_id_;
   BufferPoolManager *buffer_pool_manager_;
   KeyComparator comparator_;
 
-  // Readers includes inserts and removes, writers are splits and merges
+  // Readers include lookups, inserts, removes, splits and merges; only resizing the directory is a writer.
+  // Splits and merges write-latch the directory page, everything else latches individual bucket pages.
   ReaderWriterLatch table_latch_;
   HashFunction<KeyType> hash_fn_;
 };
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <queue>
 #include <string>
 #include <vector>
@@ -30,6 +31,11 @@ namespace bustub {
  * Implementation of linear probing hash table that is backed by a buffer pool
  * manager. Non-unique keys are supported. Supports insert and delete. The
  * table dynamically grows once full.
+ *
+ * Growing is incremental: a resize only allocates the new blocks, and every later insert or remove moves a bounded
+ * number of old blocks over, so no single operation pays for a full rehash. While a resize is in progress lookups
+ * probe both tables. Removed slots stay behind as tombstones; once they make up most of the occupied slots, the
+ * table is rebuilt at the same size through the same migration path, which compacts them away.
  */
 template <typename KeyType, typename ValueType, typename KeyComparator>
 class LinearProbeHashTable {
@@ -73,33 +79,59 @@ class LinearProbeHashTable {
   auto GetValue(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool;
 
   /**
-   * Resizes the table to at least twice the initial size provided.
+   * Resizes the table to at least twice the initial size provided. Only the new blocks are allocated here; entries
+   * are moved over by the following inserts and removes. A resize still in progress is finished first.
    * @param initial_size the initial size of the hash table
    */
   void Resize(size_t initial_size);
 
   /**
    * Gets the size of the hash table
-   * @return current size of the hash table
+   * @return current size of the hash table, i.e. the number of buckets of the table new entries go to
    */
   auto GetSize() -> size_t;
 
+  /** @return whether a resize is still migrating blocks */
+  auto IsResizing() -> bool;
+
  private:
-  auto GetHeaderPage() -> HashTableHeaderPage *;
-  auto GetBlockPage(page_id_t block_page_id) -> HASH_TABLE_BLOCK_TYPE *;
-  void ResizeInsert(HashTableHeaderPage *header_page, const KeyType &key, const ValueType &value);
-  void DeleteBlockPages(HashTableHeaderPage *old_header_page);
+  /** Old blocks moved into the new table by each insert or remove while resizing */
+  static constexpr size_t MIGRATE_BLOCKS_PER_OP = 2;
+
+  auto CreateHeaderPage(size_t num_blocks) -> page_id_t;
   void CreateNewBlockPages(HashTableHeaderPage *header_page, size_t num_blocks);
-  auto GetValueLatchFree(Transaction *transaction, const KeyType &key, std::vector<ValueType> *result) -> bool;
+  void DeleteBlockPages(HashTableHeaderPage *old_header_page);
+  /** Starts moving entries into a table of `num_blocks` blocks; caller holds the table latch in write mode */
+  void StartResize(size_t num_blocks);
+  /** Moves the next few old blocks; caller holds the table latch in write mode */
+  void MigrateBlocks(size_t max_blocks);
+  /** Takes the table latch in write mode to do one migration step, if a resize is in progress */
+  void MaybeMigrate();
+  /** Starts a grow or a compaction if the table receiving inserts is too full; takes the table latch */
+  void MaybeStartResize();
+  /** Inserts during migration; caller holds the table latch in write mode, so no page latches are taken */
+  void ResizeInsert(HashTableHeaderPage *header_page, const KeyType &key, const ValueType &value);
+  auto ProbeInsert(page_id_t header_page_id, const KeyType &key, const ValueType &value) -> bool;
+  auto ProbeRemove(page_id_t header_page_id, const KeyType &key, const ValueType &value) -> bool;
+  auto ProbeGetValue(page_id_t header_page_id, const KeyType &key, std::vector<ValueType> *result) -> bool;
 
   // member variable
   page_id_t header_page_id_;
   BufferPoolManager *buffer_pool_manager_;
   KeyComparator comparator_;
 
-  // Readers includes inserts and removes, writer is only resize
+  // Readers includes inserts and removes, writer is resize and each migration step
   ReaderWriterLatch table_latch_;
 
+  /** The table being migrated into, INVALID_PAGE_ID when no resize is in progress */
+  page_id_t new_header_page_id_{INVALID_PAGE_ID};
+  /** The next old block to migrate */
+  size_t next_migrate_block_{0};
+
+  /** Occupied (including tombstones) and readable slots of the table receiving inserts */
+  std::atomic<size_t> num_occupied_{0};
+  std::atomic<size_t> num_readable_{0};
+
   // Hash function
   HashFunction<KeyType> hash_fn_;
 };
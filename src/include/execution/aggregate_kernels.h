@@ -0,0 +1,59 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregate_kernels.h
+//
+// Identification: src/include/execution/aggregate_kernels.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "type/type_id.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * Aggregate kernels compute an aggregate over a column of integers laid out contiguously, as int64s along with a byte
+ * per row that is 1 if the row is null, instead of combining Values one row at a time. Each is a branchless loop over
+ * the arrays, which the compiler vectorizes into SIMD instructions.
+ */
+
+/** @return whether a column of `type` can be gathered for the aggregate kernels */
+auto IsKernelInteger(TypeId type) -> bool;
+
+/**
+ * Gather a column of integers into contiguous arrays.
+ * @param column the values of the column, which are expected to be of `type`
+ * @param type the type of the column, known from the plan
+ * @param[out] values the value of each row, 0 if null
+ * @param[out] nulls 1 for each row that is null, 0 otherwise
+ * @return `false` if some value is not of `type`, and the column cannot be aggregated by the kernels
+ */
+auto GatherIntegers(const std::vector<Value> &column, TypeId type, std::vector<int64_t> *values,
+                    std::vector<uint8_t> *nulls) -> bool;
+
+/** @return the number of rows that are not null */
+auto CountKernel(const uint8_t *nulls, size_t size) -> int64_t;
+
+/**
+ * @return the sum of the rows that are not null. It wraps around on overflow, so that the caller ensures it cannot:
+ * the sum of a batch of 32-bit integers always fits in an int64.
+ */
+auto SumKernel(const int64_t *values, const uint8_t *nulls, size_t size) -> int64_t;
+
+/** @return the least row that is not null, or the largest int64 if every row is */
+auto MinKernel(const int64_t *values, const uint8_t *nulls, size_t size) -> int64_t;
+
+/** @return the greatest row that is not null, or the least int64 if every row is */
+auto MaxKernel(const int64_t *values, const uint8_t *nulls, size_t size) -> int64_t;
+
+}  // namespace bustub
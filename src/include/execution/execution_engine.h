@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <vector>
 
 #include "buffer/buffer_pool_manager.h"
@@ -21,7 +22,9 @@
 #include "execution/executor_context.h"
 #include "execution/executor_factory.h"
 #include "execution/executors/init_check_executor.h"
+#include "execution/executors/pipeline_executor.h"
 #include "execution/plans/abstract_plan.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -55,14 +58,13 @@ class ExecutionEngine {
                ExecutorContext *exec_ctx) -> bool {
     BUSTUB_ASSERT((txn == exec_ctx->GetTransaction()), "Broken Invariant");
 
-    // Construct the executor for the abstract plan node
+    // Choose how the query runs, then construct the executor for the abstract plan node
+    exec_ctx->SetPushBased(exec_ctx->IsPushBased() && IsPushBased(*plan, exec_ctx));
     auto executor = ExecutorFactory::CreateExecutor(exec_ctx, plan);
 
-    // Initialize the executor
     auto executor_succeeded = true;
 
     try {
-      executor->Init();
       PollExecutor(executor.get(), plan, result_set);
       PerformChecks(exec_ctx);
     } catch (const ExecutionException &ex) {
@@ -94,13 +96,35 @@ class ExecutionEngine {
    */
   static void PollExecutor(AbstractExecutor *executor, const AbstractPlanNodeRef &plan,
                            std::vector<Tuple> *result_set) {
-    RID rid{};
-    Tuple tuple{};
-    while (executor->Next(&tuple, &rid)) {
+    // the root is initialized and run to the end, pulled a batch at a time unless it is a push-based pipeline
+    executor->Run([result_set](TupleBatch *batch) {
       if (result_set != nullptr) {
-        result_set->push_back(tuple);
+        for (size_t row = 0; row < batch->Size(); row++) {
+          result_set->push_back(batch->GetTuple(row));
+        }
       }
+    });
+  }
+
+  /**
+   * @return whether the query runs push-based pipelines: if it has some executor that streams its input, runs on its
+   * own thread, whose pipelines push into the executors above them already otherwise, and none of its executors are
+   * checked, which counts how they are pulled
+   */
+  static auto IsPushBased(const AbstractPlanNode &plan, ExecutorContext *exec_ctx) -> bool {
+    if (exec_ctx->GetParallelism() > 1 || !exec_ctx->GetCheckOptions()->check_options_set_.empty()) {
+      return false;
+    }
+    return HasStreaming(plan);
+  }
+
+  /** @return whether `plan` or a plan below it streams its input */
+  static auto HasStreaming(const AbstractPlanNode &plan) -> bool {
+    if (PipelineExecutor::IsStreaming(plan)) {
+      return true;
     }
+    return std::any_of(plan.GetChildren().begin(), plan.GetChildren().end(),
+                       [](const AbstractPlanNodeRef &child) { return HasStreaming(*child); });
   }
 
   [[maybe_unused]] BufferPoolManager *bpm_;
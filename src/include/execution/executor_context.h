@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "catalog/catalog.h"
+#include "common/arena.h"
 #include "concurrency/transaction.h"
 #include "execution/check_options.h"
 #include "execution/executors/abstract_executor.h"
@@ -38,15 +39,24 @@ class ExecutorContext {
    * @param bpm The buffer pool manager that the executor uses
    * @param txn_mgr The transaction manager that the executor uses
    * @param lock_mgr The lock manager that the executor uses
+   * @param use_arena whether the executors allocate what they materialize from the arena of the query
+   * @param parallelism the number of workers the pipelines of the query run on
+   * @param memory_budget the memory in bytes the hash tables of the query may take before they spill, 0 for no limit
+   * @param push_based whether the query may run push-based pipelines
    */
   ExecutorContext(Transaction *transaction, Catalog *catalog, BufferPoolManager *bpm, TransactionManager *txn_mgr,
-                  LockManager *lock_mgr, bool is_delete)
+                  LockManager *lock_mgr, bool is_delete, bool use_arena = true, size_t parallelism = 1,
+                  size_t memory_budget = 0, bool push_based = false)
       : transaction_(transaction),
         catalog_{catalog},
         bpm_{bpm},
         txn_mgr_(txn_mgr),
         lock_mgr_(lock_mgr),
-        is_delete_(is_delete) {
+        is_delete_(is_delete),
+        use_arena_(use_arena),
+        parallelism_(parallelism),
+        memory_budget_(memory_budget),
+        push_based_(push_based) {
     nlj_check_exec_set_ = std::deque<std::pair<AbstractExecutor *, AbstractExecutor *>>(
         std::deque<std::pair<AbstractExecutor *, AbstractExecutor *>>{});
     check_options_ = std::make_shared<CheckOptions>();
@@ -93,6 +103,24 @@ class ExecutorContext {
 
   auto IsDelete() const -> bool { return is_delete_; }
 
+  /**
+   * @return the arena of the query, or nullptr if it does not use one. What is allocated from it lives until the query
+   * ends, when it is all freed at once, so it suits what the executors materialize: join, sort and aggregation state.
+   */
+  auto GetArena() -> Arena * { return use_arena_ ? &arena_ : nullptr; }
+
+  /** @return the number of workers the pipelines of the query run on, 1 to run the query on its own thread */
+  auto GetParallelism() const -> size_t { return parallelism_; }
+
+  /** @return the memory in bytes the hash tables of the query may take before they spill to disk, 0 for no limit */
+  auto GetMemoryBudget() const -> size_t { return memory_budget_; }
+
+  /** @return whether the query runs push-based pipelines, rather than pulling every executor */
+  auto IsPushBased() const -> bool { return push_based_; }
+
+  /** Set whether the query runs push-based pipelines, which the execution engine chooses before it is executed */
+  void SetPushBased(bool push_based) { push_based_ = push_based; }
+
  private:
   /** The transaction context associated with this executor context */
   Transaction *transaction_;
@@ -109,6 +137,12 @@ class ExecutorContext {
   /** The set of check options associated with this executor context */
   std::shared_ptr<CheckOptions> check_options_;
   bool is_delete_;
+  bool use_arena_;
+  size_t parallelism_;
+  size_t memory_budget_;
+  bool push_based_;
+  /** The memory the executors materialize into, freed when the query ends */
+  Arena arena_;
 };
 
 }  // namespace bustub
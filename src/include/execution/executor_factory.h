@@ -31,5 +31,13 @@ class ExecutorFactory {
    */
   static auto CreateExecutor(ExecutorContext *exec_ctx, const AbstractPlanNodeRef &plan)
       -> std::unique_ptr<AbstractExecutor>;
+
+ private:
+  /**
+   * Creates the push-based pipeline of the executors that stream their input from `plan` down, over the first
+   * executor below that does not.
+   */
+  static auto CreatePipeline(ExecutorContext *exec_ctx, const AbstractPlanNodeRef &plan)
+      -> std::unique_ptr<AbstractExecutor>;
 };
 }  // namespace bustub
@@ -12,15 +12,32 @@
 
 #pragma once
 
+#include <functional>
+
+#include "common/macros.h"
 #include "execution/executor_context.h"
+#include "execution/tuple_batch.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 class ExecutorContext;
+
+/** A sink takes each batch an executor outputs. It may change the batch, which is the executor's to reuse after. */
+using BatchSink = std::function<void(TupleBatch *batch)>;
+
 /**
  * The AbstractExecutor implements the Volcano tuple-at-a-time iterator model.
  * This is the base class from which all executors in the BustTub execution
  * engine inherit, and defines the minimal interface that all executors support.
+ *
+ * An executor also yields its tuples a batch at a time through NextBatch(). Executors that do not implement it
+ * natively are adapted by calling Next() until the batch is full. A consumer pulls an executor through either Next()
+ * or NextBatch(), not both.
+ *
+ * A pipeline breaker, e.g. an aggregation, runs its child with Run() instead, which pushes it every batch the child
+ * outputs. The executors that stream their input -- filters, projections and the probe side of hash joins -- can also
+ * be pushed the batches of the executor below them through Consume(), with no child of their own, when the query runs
+ * push-based pipelines (see PipelineExecutor).
  */
 class AbstractExecutor {
  public:
@@ -47,6 +64,47 @@ class AbstractExecutor {
    */
   virtual auto Next(Tuple *tuple, RID *rid) -> bool = 0;
 
+  /**
+   * Yield the next batch of tuples from this executor.
+   * @param[out] batch The batch, of the output schema, replaced by up to `TUPLE_BATCH_SIZE` tuples
+   * @return `true` if the batch has some tuple, `false` if there are no more tuples
+   */
+  virtual auto NextBatch(TupleBatch *batch) -> bool {
+    batch->Clear();
+    Tuple tuple{};
+    RID rid{};
+    while (!batch->IsFull() && Next(&tuple, &rid)) {
+      batch->AppendTuple(tuple, rid);
+    }
+    return !batch->IsEmpty();
+  }
+
+  /**
+   * Initialize the executor and run it to the end, pushing every batch it yields to `sink`.
+   * @param sink takes the batches of the executor
+   */
+  virtual void Run(const BatchSink &sink) {
+    Init();
+    TupleBatch batch(&GetOutputSchema());
+    while (NextBatch(&batch)) {
+      sink(&batch);
+    }
+  }
+
+  /**
+   * Take a batch pushed by the executor below, in a push-based pipeline, and push what it outputs to `output`. The
+   * executor is initialized first, with no child.
+   * @param batch the batch pushed, which the executor may change
+   * @param output takes the batches of the executor
+   */
+  virtual void Consume(TupleBatch *batch, const BatchSink &output) { UNREACHABLE("the executor does not stream"); }
+
+  /**
+   * Push what is left to `output`, once the executor below in a push-based pipeline has pushed all its batches.
+   * @param output takes the batches of the executor
+   */
+  virtual void Finish(const BatchSink &output) {}
+
   /** @return The schema of the tuples that this executor produces */
   virtual auto GetOutputSchema() const -> const Schema & = 0;
 
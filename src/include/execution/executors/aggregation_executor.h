@@ -12,22 +12,43 @@
 
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "common/exception.h"
 #include "common/util/hash_util.h"
 #include "container/hash/hash_function.h"
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/executors/gather_executor.h"
 #include "execution/expressions/abstract_expression.h"
 #include "execution/plans/aggregation_plan.h"
+#include "storage/table/tmp_tuple_heap.h"
 #include "storage/table/tuple.h"
 #include "type/value_factory.h"
 
 namespace bustub {
 
+/**
+ * The running state of an aggregate of a group. An integer input, of any width, and a count accumulate into an int64
+ * rather than into a Value, so that combining an input is an integer operation. Any other input, e.g. a decimal or a
+ * varchar, accumulates into a Value.
+ */
+struct AggregateAccumulator {
+  /** The type of what is accumulated, INVALID until some input that is not NULL is, or a row is counted */
+  TypeId type_{TypeId::INVALID};
+  /** The state of an integer type */
+  int64_t int_{0};
+  /** The state of any other type */
+  Value value_{};
+};
+
+/** The running states of the aggregates of a group, one per aggregate */
+using AggregateState = std::vector<AggregateAccumulator>;
+
 /**
  * A simplified hash table that has all the necessary functionality for aggregations.
  */
@@ -42,67 +63,44 @@ class SimpleAggregationHashTable {
                              const std::vector<AggregationType> &agg_types)
       : agg_exprs_{agg_exprs}, agg_types_{agg_types} {}
 
-  /** @return The initial aggregate value for this aggregation executor */
-  auto GenerateInitialAggregateValue() -> AggregateValue {
-    std::vector<Value> values{};
-    for (const auto &agg_type : agg_types_) {
-      switch (agg_type) {
-        case AggregationType::CountStarAggregate:
-          // Count start starts at zero.
-          values.emplace_back(ValueFactory::GetIntegerValue(0));
-          break;
-        case AggregationType::CountAggregate:
-        case AggregationType::SumAggregate:
-        case AggregationType::MinAggregate:
-        case AggregationType::MaxAggregate:
-          // Others starts at null.
-          values.emplace_back(ValueFactory::GetNullValueByType(TypeId::INTEGER));
-          break;
+  /** @return The initial aggregate state for this aggregation executor */
+  auto GenerateInitialAggregateState() -> AggregateState {
+    AggregateState state(agg_types_.size());
+    for (size_t i = 0; i < agg_types_.size(); i++) {
+      // Count star starts at zero, others at null.
+      if (agg_types_[i] == AggregationType::CountStarAggregate) {
+        state[i].type_ = TypeId::INTEGER;
       }
     }
-    return {values};
+    return state;
   }
 
   /**
-   * TODO(Student)
-   *
    * Combines the input into the aggregation result.
-   * @param[out] result The output aggregate value
+   * @param[out] result The output aggregate state
    * @param input The input value
    */
-  void CombineAggregateValues(AggregateValue *result, const AggregateValue &input) {
+  void CombineAggregateValues(AggregateState *result, const AggregateValue &input) {
     for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
+      auto &accumulator = (*result)[i];
       switch (agg_types_[i]) {
         case AggregationType::CountStarAggregate:
-          result->aggregates_[i] = result->aggregates_[i].Add(ValueFactory::GetIntegerValue(1));
+          accumulator.type_ = TypeId::INTEGER;
+          accumulator.int_++;
           break;
         case AggregationType::CountAggregate:
-          if (result->aggregates_[i].IsNull()) {
-            result->aggregates_[i] = ValueFactory::GetIntegerValue(0);
-          }
+          accumulator.type_ = TypeId::INTEGER;
           if (!input.aggregates_[i].IsNull()) {
-            result->aggregates_[i] = result->aggregates_[i].Add(ValueFactory::GetIntegerValue(1));
+            accumulator.int_++;
           }
           break;
         case AggregationType::SumAggregate:
-          if (result->aggregates_[i].IsNull()) {
-            result->aggregates_[i] = input.aggregates_[i];
-          } else if (!input.aggregates_[i].IsNull()) {
-            result->aggregates_[i] = result->aggregates_[i].Add(input.aggregates_[i]);
-          }
-          break;
         case AggregationType::MinAggregate:
-          if (result->aggregates_[i].IsNull()) {
-            result->aggregates_[i] = input.aggregates_[i];
-          } else if (!input.aggregates_[i].IsNull()) {
-            result->aggregates_[i] = result->aggregates_[i].Min(input.aggregates_[i]);
-          }
-          break;
         case AggregationType::MaxAggregate:
-          if (result->aggregates_[i].IsNull()) {
-            result->aggregates_[i] = input.aggregates_[i];
-          } else if (!input.aggregates_[i].IsNull()) {
-            result->aggregates_[i] = result->aggregates_[i].Max(input.aggregates_[i]);
+          if (!input.aggregates_[i].IsNull()) {
+            AggregateAccumulator other;
+            SetValue(&other, input.aggregates_[i]);
+            Combine(agg_types_[i], &accumulator, other);
           }
           break;
       }
@@ -115,30 +113,94 @@ class SimpleAggregationHashTable {
    * @param agg_val the value to be inserted
    */
   void InsertCombine(const AggregateKey &agg_key, const AggregateValue &agg_val) {
-    if (ht_.count(agg_key) == 0) {
-      ht_.insert({agg_key, GenerateInitialAggregateValue()});
+    // a single lookup, whether or not the key is there already
+    auto [iter, inserted] = ht_.try_emplace(agg_key);
+    if (inserted) {
+      iter->second = GenerateInitialAggregateState();
     }
-    CombineAggregateValues(&ht_[agg_key], agg_val);
+    CombineAggregateValues(&iter->second, agg_val);
   }
 
-  void InsertIntialCombine() { ht_.insert({{std::vector<Value>()}, GenerateInitialAggregateValue()}); }
+  /**
+   * Combines the input into the aggregation result of its key, if the key is in the hash table already.
+   * @param agg_key the key of the input
+   * @param agg_val the input value
+   * @return `true` if the key was in the hash table, `false` if the input was left out
+   */
+  auto CombineIfPresent(const AggregateKey &agg_key, const AggregateValue &agg_val) -> bool {
+    auto iter = ht_.find(agg_key);
+    if (iter == ht_.end()) {
+      return false;
+    }
+    CombineAggregateValues(&iter->second, agg_val);
+    return true;
+  }
+
+  /**
+   * Merges an aggregate state built apart, e.g. by another worker over other tuples, into the one of its key.
+   * @param agg_key the key of the aggregate state
+   * @param agg_state the aggregate state to be merged
+   */
+  void MergeCombine(const AggregateKey &agg_key, const AggregateState &agg_state) {
+    auto [iter, inserted] = ht_.try_emplace(agg_key, agg_state);
+    if (inserted) {
+      return;
+    }
+    for (uint32_t i = 0; i < agg_exprs_.size(); i++) {
+      Combine(agg_types_[i], &iter->second[i], agg_state[i]);
+    }
+  }
+
+  void InsertIntialCombine() { ht_.insert({{std::vector<Value>()}, GenerateInitialAggregateState()}); }
 
   /**
    * Clear the hash table
    */
   void Clear() { ht_.clear(); }
 
+  /** @return The value of an aggregate of a group, from its state */
+  static auto ToValue(const AggregateAccumulator &accumulator) -> Value {
+    switch (accumulator.type_) {
+      case TypeId::INVALID:
+        return ValueFactory::GetNullValueByType(TypeId::INTEGER);
+      case TypeId::TINYINT:
+        CheckRange(accumulator.int_, BUSTUB_INT8_MIN, BUSTUB_INT8_MAX);
+        return ValueFactory::GetTinyIntValue(static_cast<int8_t>(accumulator.int_));
+      case TypeId::SMALLINT:
+        CheckRange(accumulator.int_, BUSTUB_INT16_MIN, BUSTUB_INT16_MAX);
+        return ValueFactory::GetSmallIntValue(static_cast<int16_t>(accumulator.int_));
+      case TypeId::INTEGER:
+        CheckRange(accumulator.int_, BUSTUB_INT32_MIN, BUSTUB_INT32_MAX);
+        return ValueFactory::GetIntegerValue(static_cast<int32_t>(accumulator.int_));
+      case TypeId::BIGINT:
+        CheckRange(accumulator.int_, BUSTUB_INT64_MIN, BUSTUB_INT64_MAX);
+        return ValueFactory::GetBigIntValue(accumulator.int_);
+      default:
+        return accumulator.value_;
+    }
+  }
+
   /** An iterator over the aggregation hash table */
   class Iterator {
    public:
     /** Creates an iterator for the aggregate map. */
-    explicit Iterator(std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter) : iter_{iter} {}
+    explicit Iterator(std::unordered_map<AggregateKey, AggregateState>::const_iterator iter) : iter_{iter} {}
 
     /** @return The key of the iterator */
     auto Key() -> const AggregateKey & { return iter_->first; }
 
-    /** @return The value of the iterator */
-    auto Val() -> const AggregateValue & { return iter_->second; }
+    /** @return The aggregate state of the iterator */
+    auto State() -> const AggregateState & { return iter_->second; }
+
+    /** @return The value of the iterator, made from its aggregate state */
+    auto Val() -> AggregateValue {
+      AggregateValue value;
+      value.aggregates_.reserve(iter_->second.size());
+      for (const auto &accumulator : iter_->second) {
+        value.aggregates_.push_back(ToValue(accumulator));
+      }
+      return value;
+    }
 
     /** @return The iterator before it is incremented */
     auto operator++() -> Iterator & {
@@ -154,7 +216,7 @@ class SimpleAggregationHashTable {
 
    private:
     /** Aggregates map */
-    std::unordered_map<AggregateKey, AggregateValue>::const_iterator iter_;
+    std::unordered_map<AggregateKey, AggregateState>::const_iterator iter_;
   };
 
   /** @return Iterator to the start of the hash table */
@@ -166,17 +228,118 @@ class SimpleAggregationHashTable {
   auto Size() -> size_t { return ht_.size(); }
 
  private:
-  /** The hash table is just a map from aggregate keys to aggregate values */
-  std::unordered_map<AggregateKey, AggregateValue> ht_{};
+  /** Set an aggregate state to a value */
+  static void SetValue(AggregateAccumulator *accumulator, const Value &value) {
+    accumulator->type_ = value.GetTypeId();
+    switch (value.GetTypeId()) {
+      case TypeId::TINYINT:
+        accumulator->int_ = value.GetAs<int8_t>();
+        break;
+      case TypeId::SMALLINT:
+        accumulator->int_ = value.GetAs<int16_t>();
+        break;
+      case TypeId::INTEGER:
+        accumulator->int_ = value.GetAs<int32_t>();
+        break;
+      case TypeId::BIGINT:
+        accumulator->int_ = value.GetAs<int64_t>();
+        break;
+      default:
+        accumulator->value_ = value;
+        break;
+    }
+  }
+
+  /** @return whether the state of an aggregate is accumulated as an integer */
+  static auto IsInteger(TypeId type) -> bool {
+    return type == TypeId::TINYINT || type == TypeId::SMALLINT || type == TypeId::INTEGER || type == TypeId::BIGINT;
+  }
+
+  /** @throw Exception if an integer aggregate is out of the range of its type, as adding Values of the type would */
+  static void CheckRange(int64_t value, int64_t min, int64_t max) {
+    if (value < min || value > max) {
+      throw Exception(ExceptionType::OUT_OF_RANGE, "Numeric value out of range.");
+    }
+  }
+
+  /** Combine `input`, the state of an aggregate over some rows, into `result`, its state over others */
+  static void Combine(AggregationType agg_type, AggregateAccumulator *result, const AggregateAccumulator &input) {
+    if (input.type_ == TypeId::INVALID) {
+      return;
+    }
+    if (result->type_ == TypeId::INVALID) {
+      *result = input;
+      return;
+    }
+    if (IsInteger(result->type_) && IsInteger(input.type_)) {
+      switch (agg_type) {
+        case AggregationType::CountStarAggregate:
+        case AggregationType::CountAggregate:
+        case AggregationType::SumAggregate:
+          if (__builtin_add_overflow(result->int_, input.int_, &result->int_)) {
+            throw Exception(ExceptionType::OUT_OF_RANGE, "Numeric value out of range.");
+          }
+          break;
+        case AggregationType::MinAggregate:
+          result->int_ = std::min(result->int_, input.int_);
+          break;
+        case AggregationType::MaxAggregate:
+          result->int_ = std::max(result->int_, input.int_);
+          break;
+      }
+      // the integer types are ordered by width, and the widest wins, as when adding Values
+      result->type_ = std::max(result->type_, input.type_);
+      return;
+    }
+    // any other type is combined as a Value
+    auto value = ToValue(*result);
+    switch (agg_type) {
+      case AggregationType::CountStarAggregate:
+      case AggregationType::CountAggregate:
+      case AggregationType::SumAggregate:
+        SetValue(result, value.Add(ToValue(input)));
+        break;
+      case AggregationType::MinAggregate:
+        SetValue(result, value.Min(ToValue(input)));
+        break;
+      case AggregationType::MaxAggregate:
+        SetValue(result, value.Max(ToValue(input)));
+        break;
+    }
+  }
+
+  /** The hash table is just a map from aggregate keys to aggregate states */
+  std::unordered_map<AggregateKey, AggregateState> ht_{};
   /** The aggregate expressions that we have */
   const std::vector<AbstractExpressionRef> &agg_exprs_;
   /** The types of aggregations that we have */
   const std::vector<AggregationType> &agg_types_;
 };
 
+/** The number of partitions the input of an aggregation over its memory budget is spilled to */
+static constexpr size_t AGGREGATION_SPILL_PARTITIONS = 16;
+
+/** The groups the table of a worker of a parallel aggregation holds before it is flushed, few enough to stay cached */
+static constexpr size_t AGGREGATION_PREAGGREGATION_GROUPS = 1024;
+
+/** The number of partitions the groups a parallel aggregation flushes are split into, and each merged on its own */
+static constexpr size_t AGGREGATION_MERGE_PARTITIONS = 16;
+
 /**
  * AggregationExecutor executes an aggregation operation (e.g. COUNT, SUM, MIN, MAX)
  * over the tuples produced by a child executor.
+ *
+ * Over a parallel scan, the aggregation runs in two phases. Each worker pre-aggregates the tuples it scans into a
+ * small table of its own, flushing its groups into partitions by group whenever the table fills up; then each
+ * partition is merged, across all the workers, by a single worker into a table of its own, and the merged tables are
+ * output one after the other.
+ *
+ * An aggregation without group-bys whose inputs are all integers, as known from the plan, is computed by the
+ * aggregate kernels: each aggregate over a batch is a single typed loop over its column, combined into the one group.
+ *
+ * Once the hash table has as many groups as the memory budget of the query holds, the input tuples of the groups it
+ * does not have are spilled to disk, split into partitions by group. Each partition is aggregated on its own after
+ * the groups in memory are output.
  */
 class AggregationExecutor : public AbstractExecutor {
  public:
@@ -200,6 +363,13 @@ class AggregationExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the aggregation.
+   * @param[out] batch The batch of tuples produced by the aggregation
+   * @return `true` if the batch has some tuple, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
   /** @return The output schema for the aggregation */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
@@ -207,20 +377,46 @@ class AggregationExecutor : public AbstractExecutor {
   auto GetChildExecutor() const -> const AbstractExecutor *;
 
  private:
-  /** @return The tuple as an AggregateKey */
-  auto MakeAggregateKey(const Tuple *tuple) -> AggregateKey {
+  /**
+   * Evaluate the group-bys and aggregates over a batch of child tuples, and combine its rows into `aht`.
+   * @param spill whether the rows of new groups are spilled once `aht` holds as many groups as the budget allows
+   */
+  void InsertBatch(SimpleAggregationHashTable *aht, const TupleBatch &batch, bool spill = false);
+
+  /** @return whether the aggregates of `plan` are computed by the aggregate kernels */
+  static auto CanUseKernels(const AggregationPlanNode &plan) -> bool;
+
+  /**
+   * Compute each aggregate over a batch of child tuples with the aggregate kernels, and combine it into `aht`.
+   * @return `false` if some input is not of the type of the plan, and the batch was left out
+   */
+  auto InsertBatchWithKernels(SimpleAggregationHashTable *aht, const TupleBatch &batch) -> bool;
+
+  /** Pre-aggregate the tuples of a parallel scan on each worker, then merge the groups by partition into `merged_` */
+  void AggregateInParallel(GatherExecutor *gather);
+
+  /** Move on to the next table of groups to output, @return `false` if there is none left */
+  auto NextTable() -> bool;
+
+  /** Aggregate the next partition spilled into the hash table, @return `false` if there is none left */
+  auto LoadSpilledPartition() -> bool;
+
+  /** @return A row of the group-bys evaluated over a batch as an AggregateKey */
+  auto MakeAggregateKey(const std::vector<const std::vector<Value> *> &group_bys, size_t row) -> AggregateKey {
     std::vector<Value> keys;
-    for (const auto &expr : plan_->GetGroupBys()) {
-      keys.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
+    keys.reserve(group_bys.size());
+    for (const auto *column : group_bys) {
+      keys.push_back((*column)[row]);
     }
     return {keys};
   }
 
-  /** @return The tuple as an AggregateValue */
-  auto MakeAggregateValue(const Tuple *tuple) -> AggregateValue {
+  /** @return A row of the aggregates evaluated over a batch as an AggregateValue */
+  auto MakeAggregateValue(const std::vector<const std::vector<Value> *> &aggregates, size_t row) -> AggregateValue {
     std::vector<Value> vals;
-    for (const auto &expr : plan_->GetAggregates()) {
-      vals.emplace_back(expr->Evaluate(tuple, child_->GetOutputSchema()));
+    vals.reserve(aggregates.size());
+    for (const auto *column : aggregates) {
+      vals.push_back((*column)[row]);
     }
     return {vals};
   }
@@ -232,7 +428,19 @@ class AggregationExecutor : public AbstractExecutor {
   std::unique_ptr<AbstractExecutor> child_;
   /** Simple aggregation hash table */
   SimpleAggregationHashTable aht_;
+  /** The partitions a parallel aggregation merged, and the one being output */
+  std::vector<SimpleAggregationHashTable> merged_;
+  size_t merged_idx_{0};
+  /** The table being output */
+  SimpleAggregationHashTable *table_{&aht_};
   /** Simple aggregation hash table iterator */
   SimpleAggregationHashTable::Iterator aht_iterator_;
+  /** Whether the aggregates are computed by the aggregate kernels */
+  bool use_kernels_;
+  /** The groups the hash table holds at most before it spills, 0 for no limit */
+  size_t max_groups_{0};
+  /** The partitions of the child tuples spilled, and the next one to be aggregated */
+  std::vector<std::unique_ptr<TmpTupleHeap>> spilled_;
+  size_t spill_partition_{0};
 };
 }  // namespace bustub
@@ -48,6 +48,21 @@ class FilterExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the filter.
+   * @param[out] batch The batch of tuples produced by the filter
+   * @return `true` if the batch has some tuple, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
+  /**
+   * Take a batch pushed by the executor below, in a push-based pipeline, and push the tuples that satisfy the
+   * predicate to `output`.
+   * @param batch the batch pushed
+   * @param output takes the batches of the filter
+   */
+  void Consume(TupleBatch *batch, const BatchSink &output) override;
+
   /** @return The output schema for the filter plan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
@@ -55,7 +70,7 @@ class FilterExecutor : public AbstractExecutor {
   /** The filter plan node to be executed */
   const FilterPlanNode *plan_;
 
-  /** The child executor from which tuples are obtained */
+  /** The child executor from which tuples are obtained, or nullptr in a push-based pipeline */
   std::unique_ptr<AbstractExecutor> child_executor_;
 };
 }  // namespace bustub
@@ -0,0 +1,175 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// gather_executor.h
+//
+// Identification: src/include/execution/executors/gather_executor.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/executors/seq_scan_executor.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/tuple_batch.h"
+
+namespace bustub {
+
+/** The number of table pages in a morsel, the unit of work of a parallel pipeline */
+static constexpr size_t MORSEL_PAGE_COUNT = 4;
+/** How many morsels past the next one to be gathered the workers of a gather may have done, waiting to be gathered */
+static constexpr size_t GATHER_MORSELS_AHEAD = 16;
+
+/**
+ * GatherExecutor runs a pipeline -- a sequential scan under filters and projections -- on the workers of the query,
+ * and gathers what they output.
+ *
+ * The table is split into morsels of a few pages, dealt to the workers in turn. Each worker runs its own executors of
+ * the pipeline over one of its morsels at a time, then steals the morsels other workers have yet to start. The output
+ * of every morsel is kept apart and gathered in the order of the morsels, so that it comes out as from a serial scan.
+ * The pipeline runs in the background from `Init` on, and the output of a morsel is gathered as soon as it and the
+ * morsels before it are done; the workers wait rather than run more than `GATHER_MORSELS_AHEAD` morsels ahead.
+ *
+ * A pipeline breaker right above the pipeline, e.g. an aggregation or the build side of a hash join, runs the pipeline
+ * with a sink of its own instead, and merges what its workers built.
+ */
+class GatherExecutor : public AbstractExecutor {
+ public:
+  /**
+   * A sink takes each batch the pipeline outputs, along with the worker that output it and the index of its morsel.
+   * Workers call it concurrently, but the batches of a morsel all come from one worker, in order.
+   */
+  using Sink = std::function<void(size_t worker, size_t morsel, const TupleBatch &batch)>;
+
+  /** A morsel sink is told each time a worker is done with a morsel, once the sink has taken all its batches. */
+  using MorselSink = std::function<void(size_t worker, size_t morsel)>;
+
+  /**
+   * @return whether `plan` is a pipeline that runs on the workers of `exec_ctx`, if it has more than one and no memory
+   * budget
+   */
+  static auto CanRun(ExecutorContext *exec_ctx, const AbstractPlanNode &plan) -> bool;
+
+  /**
+   * Concatenate the output of every worker, tagged with its morsel, in the order of the morsels.
+   * @param outputs what each worker output, each in the order it was output
+   */
+  template <typename T>
+  static auto MergeByMorsel(std::vector<std::vector<std::pair<size_t, T>>> *outputs) -> std::vector<T> {
+    std::vector<std::pair<size_t, T>> merged;
+    for (auto &output : *outputs) {
+      std::move(output.begin(), output.end(), std::back_inserter(merged));
+    }
+    std::stable_sort(merged.begin(), merged.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+    std::vector<T> result;
+    result.reserve(merged.size());
+    for (auto &[morsel, value] : merged) {
+      result.push_back(std::move(value));
+    }
+    return result;
+  }
+
+  /** Run `task` on `worker_count` threads, passing each the index of its worker, until they are all done */
+  static void RunOnWorkers(size_t worker_count, const std::function<void(size_t worker)> &task);
+
+  /**
+   * Construct a new GatherExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The pipeline to be run on the workers
+   */
+  GatherExecutor(ExecutorContext *exec_ctx, AbstractPlanNodeRef plan);
+
+  /** Stop the pipeline, if it is still running */
+  ~GatherExecutor() override;
+
+  /** Start running the pipeline in the background */
+  void Init() override;
+
+  /**
+   * Yield the next tuple gathered.
+   * @param[out] tuple The next tuple produced by the pipeline
+   * @param[out] rid The next tuple RID produced by the pipeline
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /**
+   * Yield the next batch gathered.
+   * @param[out] batch The batch of tuples produced by the pipeline
+   * @return `true` if the batch has some tuple, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
+  /** @return The output schema of the pipeline */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
+
+  /** @return The number of workers the pipeline runs on */
+  auto GetWorkerCount() const -> size_t { return exec_ctx_->GetParallelism(); }
+
+  /**
+   * Run the pipeline over the whole table, on every worker, until each is done. Once a worker throws, the others stop
+   * taking morsels.
+   * @param sink takes the batches the workers output
+   * @param morsel_sink is told of each morsel done, if given
+   * @param cancelled stops the workers from taking more morsels once it is set, if given
+   * @throw the first exception a worker threw, once they are all done
+   */
+  void RunPipeline(const Sink &sink, const MorselSink &morsel_sink = nullptr,
+                   const std::atomic<bool> *cancelled = nullptr);
+
+ private:
+  /** @return the executors of a worker for `plan`, setting `scan` to the sequential scan at the bottom */
+  auto MakePipeline(const AbstractPlanNodeRef &plan, SeqScanExecutor **scan) -> std::unique_ptr<AbstractExecutor>;
+
+  /** Stop the pipeline running in the background, and wait for it */
+  void Stop();
+
+  /**
+   * Wait for the next morsel to be done, and make its output the batches the gather is at.
+   * @return `false` once every morsel is gathered
+   * @throw the exception the pipeline threw, once the morsels done before it are gathered
+   */
+  auto NextMorsel() -> bool;
+
+  /** The pipeline to be run */
+  AbstractPlanNodeRef plan_;
+
+  /** The thread running the pipeline, and whether it should stop */
+  std::thread runner_;
+  std::atomic<bool> cancelled_{false};
+
+  std::mutex latch_;
+  std::condition_variable cv_;
+  /** The output of the morsels done but not gathered yet */
+  std::unordered_map<size_t, std::vector<TupleBatch>> done_; /* protected by latch_ */
+  /** The next morsel to be gathered */
+  size_t next_morsel_{0}; /* protected by latch_ */
+  /** Whether the pipeline is over, and the exception it threw, if any */
+  bool finished_{false};       /* protected by latch_ */
+  std::exception_ptr error_;  /* protected by latch_ */
+
+  /** The output of the morsel being gathered, and the batch and row the gather is at */
+  std::vector<TupleBatch> batches_;
+  size_t batch_idx_{0};
+  size_t row_{0};
+};
+
+}  // namespace bustub
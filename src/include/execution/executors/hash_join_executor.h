@@ -13,8 +13,8 @@
 #pragma once
 
 #include <cstdint>
+#include <limits>
 #include <memory>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -22,6 +22,7 @@
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/hash_join_plan.h"
+#include "storage/table/tmp_tuple_heap.h"
 #include "storage/table/tuple.h"
 #include "type/type.h"
 #include "type/value.h"
@@ -54,8 +55,62 @@ struct HashJoinKey {
     return curr_hash;
   }
 };
+/** The build side of a hash join is split into 2^HASH_JOIN_PARTITION_BITS partitions, by the low bits of the hashes */
+static constexpr size_t HASH_JOIN_PARTITION_BITS = 6;
+static constexpr size_t HASH_JOIN_PARTITION_COUNT = 1 << HASH_JOIN_PARTITION_BITS;
+
+/** A tuple of the build side, kept with its join key and the hash of that key, so that a probe computes neither */
+struct HashJoinEntry {
+  hash_t hash_;
+  HashJoinKey key_;
+  Tuple tuple_;
+};
+
+/**
+ * A partition of the build side of a hash join. Its entries are stored next to each other, in the order they were
+ * built, and chained by bucket, so that a probe walks through the few entries whose hash falls in its bucket only.
+ */
+struct HashJoinPartition {
+  /** The index that ends a chain */
+  static constexpr uint32_t NO_ENTRY = UINT32_MAX;
+
+  /** Chain the entries by bucket, keeping them in order in each chain */
+  void Build() {
+    size_t bucket_count = 1;
+    while (bucket_count < entries_.size()) {
+      bucket_count <<= 1;
+    }
+    buckets_.assign(bucket_count, NO_ENTRY);
+    next_.resize(entries_.size());
+    for (auto i = static_cast<uint32_t>(entries_.size()); i-- > 0;) {
+      auto &first = buckets_[BucketOf(entries_[i].hash_)];
+      next_[i] = first;
+      first = i;
+    }
+  }
+
+  /** @return the first entry of the bucket of `hash`, or NO_ENTRY if it is empty */
+  auto First(hash_t hash) const -> uint32_t { return buckets_.empty() ? NO_ENTRY : buckets_[BucketOf(hash)]; }
+
+  /** @return the bucket of `hash`, from the bits above those of its partition */
+  auto BucketOf(hash_t hash) const -> size_t { return (hash >> HASH_JOIN_PARTITION_BITS) & (buckets_.size() - 1); }
+
+  std::vector<HashJoinEntry> entries_;
+  /** The first entry of every bucket */
+  std::vector<uint32_t> buckets_;
+  /** The entry after each in the chain of its bucket */
+  std::vector<uint32_t> next_;
+};
+
 /**
- * HashJoinExecutor executes a nested-loop JOIN on two tables.
+ * HashJoinExecutor executes a hash JOIN on two tables.
+ *
+ * The right side is built into partitions of a hash table, by all the workers of the query if it is a pipeline that
+ * runs on them. The left side probes the table a batch at a time, and the tuples it joins are output as they are
+ * found, unless it too runs on the workers, in which case what they output is gathered in the order of their morsels.
+ *
+ * When the right side takes more than the memory budget of the query, the join is a hybrid hash join: the largest
+ * partitions are spilled to disk, both sides, and joined one at a time once the partitions left in memory are.
  */
 class HashJoinExecutor : public AbstractExecutor {
  public:
@@ -73,27 +128,115 @@ class HashJoinExecutor : public AbstractExecutor {
   void Init() override;
 
   /**
-   * Yield the next tuple from the join.
+   * Yield the next tuple from the join, probing the left rows one at a time until one joins some tuple.
    * @param[out] tuple The next tuple produced by the join.
    * @param[out] rid The next tuple RID, not used by hash join.
    * @return `true` if a tuple was produced, `false` if there are no more tuples.
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the join.
+   * @param[out] batch The batch of tuples produced by the join
+   * @return `true` if the batch has some tuple, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
+  /**
+   * Probe the hash table with a batch of left tuples pushed by the executor below, in a push-based pipeline, and push
+   * the tuples they join to `output`.
+   * @param batch the batch of left tuples pushed
+   * @param output takes the batches of the join
+   */
+  void Consume(TupleBatch *batch, const BatchSink &output) override;
+
+  /**
+   * Join the partitions spilled, once the left side is all pushed, and push the tuples they join to `output`.
+   * @param output takes the batches of the join
+   */
+  void Finish(const BatchSink &output) override;
+
   /** @return The output schema for the join */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); };
 
  private:
-  /** The NestedLoopJoin plan node to be executed. */
+  /** Where the probe of a batch of left tuples is at */
+  struct ProbeCursor {
+    const TupleBatch *batch_{nullptr};
+    std::vector<HashJoinKey> keys_;
+    std::vector<hash_t> hashes_;
+    /** The row being probed, the next entry of its chain, and whether it has joined some tuple yet */
+    size_t row_{0};
+    uint32_t entry_{HashJoinPartition::NO_ENTRY};
+    bool matched_{false};
+    /** Whether the partition of the row is spilled, in which case the row is too */
+    bool spilled_{false};
+  };
+
+  /** Build the partitions of the hash table from the right side */
+  void Build();
+
+  /** Spill the largest partitions built so far to disk, until those left fit in the memory budget */
+  void SpillBuild(std::vector<std::vector<std::pair<size_t, HashJoinEntry>>> *built);
+
+  /** Read the right side of a partition spilled back into memory, and build it */
+  void LoadSpilledPartition(size_t partition);
+
+  /** Pull the next batch of left tuples to probe, from the left side then from the partitions spilled */
+  auto NextLeftBatch() -> bool;
+
+  /** Start probing the hash table with a batch of left tuples */
+  void StartProbe(ProbeCursor *cursor, const TupleBatch *batch) const;
+
+  /** Start probing the hash table with the row of the batch the cursor is at */
+  void StartProbeRow(ProbeCursor *cursor) const;
+
+  /**
+   * Add to `output` the tuples the left rows of the cursor join, until it is full, the rows are all probed or
+   * `row_count` of them are. The rows of a partition spilled are spilled too.
+   */
+  void Probe(ProbeCursor *cursor, TupleBatch *output, size_t row_count = std::numeric_limits<size_t>::max());
+
+  /** Add to `output` a row of a left batch joined with `right_tuple`, or with NULLs if it is nullptr */
+  void AppendJoinedRow(const TupleBatch &left_batch, size_t row, const Tuple *right_tuple, TupleBatch *output) const;
+
+  /** The HashJoin plan node to be executed. */
   const HashJoinPlanNode *plan_;
 
+  /** The left side, or nullptr in a push-based pipeline, which pushes it, and the right side */
   std::unique_ptr<AbstractExecutor> left_executor_;
   std::unique_ptr<AbstractExecutor> right_executor_;
 
-  std::unordered_map<hash_t, std::vector<Tuple>> hash_join_table_{};
+  /** The partitions of the hash table, chosen by the low bits of the hash of the keys */
+  std::vector<HashJoinPartition> partitions_;
+
+  /**
+   * The right and left sides of the partitions spilled to disk, when the right side is over the memory budget of the
+   * query, and about the memory each partition left in memory takes
+   */
+  std::vector<std::unique_ptr<TmpTupleHeap>> spilled_build_;
+  std::vector<std::unique_ptr<TmpTupleHeap>> spilled_probe_;
+  std::vector<size_t> partition_bytes_;
+
+  /** The batch of left tuples being probed, when the probe streams its output */
+  TupleBatch left_batch_;
+  ProbeCursor cursor_;
+  /** Whether the left side is all probed, and the partition spilled and page of its left side being probed then */
+  bool left_done_{false};
+  size_t spill_partition_{0};
+  size_t spill_page_{0};
+
+  /** The output of the workers, when the left side runs on them, and the batch the join is at */
+  bool gathered_{false};
+  std::vector<TupleBatch> output_batches_;
+  size_t output_idx_{0};
+
+  /** The tuples the left row probed last by Next joins, and the one it yields next */
+  TupleBatch next_batch_;
+  size_t next_row_{0};
 
-  std::vector<Tuple> output_tuples_;
-  std::vector<Tuple>::const_iterator output_tuples_iter_;
+  /** The batch pushed to the executor above, in a push-based pipeline */
+  TupleBatch output_batch_;
 };
 
 }  // namespace bustub
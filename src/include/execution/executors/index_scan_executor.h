@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "catalog/catalog.h"
@@ -19,7 +21,7 @@
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/index_scan_plan.h"
-#include "storage/index/b_plus_tree_index.h"
+#include "storage/index/index.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -44,11 +46,28 @@ class IndexScanExecutor : public AbstractExecutor {
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
  private:
+  /** The number of RIDs sorted at a time when fetching in page order */
+  static constexpr size_t SORTED_FETCH_BATCH_SIZE = 1024;
+
+  /** Take the RID of the next matching index entry */
+  auto NextRid(RID *rid) -> bool;
+
+  /** Fetch the next batch of matching tuples in page order into `fetched_`, @return false when there are none left */
+  auto FetchSortedBatch() -> bool;
+
   /** The index scan plan node to be executed. */
   const IndexScanPlanNode *plan_;
   const IndexInfo *index_info_;
   const TableInfo *table_info_;
-  BPlusTreeIndexForTwoIntegerColumn *tree_;
-  BPlusTreeIndexIteratorForTwoIntegerColumn iter_;
+  /** Walks the matching entries of a B+ tree index in key order */
+  std::unique_ptr<IndexCursor> iter_;
+  /** RIDs matching the probe key, when a hash index is probed */
+  std::vector<RID> rids_;
+  size_t rid_idx_{0};
+  /** Whether tuples are built from the index entries instead of being fetched from the table */
+  bool index_only_{false};
+  /** The current batch of tuples, when the plan fetches them in page order */
+  std::vector<std::pair<TupleMeta, Tuple>> fetched_;
+  size_t fetched_idx_{0};
 };
 }  // namespace bustub
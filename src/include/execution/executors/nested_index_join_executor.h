@@ -50,5 +50,17 @@ class NestIndexJoinExecutor : public AbstractExecutor {
  private:
   /** The nested index join plan node. */
   const NestedIndexJoinPlanNode *plan_;
+  /** The outer table */
+  std::unique_ptr<AbstractExecutor> child_executor_;
+  const IndexInfo *index_info_;
+  const TableInfo *table_info_;
+  /** The outer tuple being joined and the inner RIDs its key matched */
+  Tuple left_tuple_;
+  Value key_value_;
+  std::vector<RID> rids_;
+  size_t cursor_{0};
+  /** Whether `left_tuple_` has been probed and produced any output, for left joins */
+  bool probed_{false};
+  bool matched_{false};
 };
 }  // namespace bustub
@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// pipeline_executor.h
+//
+// Identification: src/include/execution/executors/pipeline_executor.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "execution/executor_context.h"
+#include "execution/executors/abstract_executor.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/tuple_batch.h"
+
+namespace bustub {
+
+/**
+ * PipelineExecutor runs a push-based pipeline: the executors that stream their input -- filters, projections and the
+ * probe side of hash joins -- stacked over a source, which is any other executor.
+ *
+ * The source is run to the end in a single loop, and each batch it outputs is pushed through the executors above it,
+ * each consuming the batches of the one below and pushing what it outputs to the one above, then to the sink of the
+ * pipeline: the pipeline breaker above it, e.g. an aggregation or the build side of a hash join, or the result set of
+ * the query. No executor of the pipeline pulls its input, so none has a child.
+ *
+ * An executor above that is not a pipeline breaker, e.g. a limit, pulls the pipeline instead, which pushes a batch of
+ * the source at a time through it and yields what comes out.
+ */
+class PipelineExecutor : public AbstractExecutor {
+ public:
+  /** @return whether `plan` streams its input, and is pushed its input in a push-based pipeline */
+  static auto IsStreaming(const AbstractPlanNode &plan) -> bool;
+
+  /**
+   * Construct a new PipelineExecutor instance.
+   * @param exec_ctx The executor context
+   * @param plan The top of the pipeline
+   * @param source The executor at the bottom of the pipeline
+   * @param operators The executors of the pipeline, with no child, from the one right above the source to the top
+   */
+  PipelineExecutor(ExecutorContext *exec_ctx, AbstractPlanNodeRef plan, std::unique_ptr<AbstractExecutor> &&source,
+                   std::vector<std::unique_ptr<AbstractExecutor>> &&operators);
+
+  /** Initialize the executors of the pipeline, and its source */
+  void Init() override;
+
+  /**
+   * Initialize the pipeline and run it to the end, pushing every batch of the source through it.
+   * @param sink takes the batches the pipeline outputs
+   */
+  void Run(const BatchSink &sink) override;
+
+  /**
+   * Yield the next tuple the pipeline outputs.
+   * @param[out] tuple The next tuple produced by the pipeline
+   * @param[out] rid The next tuple RID produced by the pipeline
+   * @return `true` if a tuple was produced, `false` if there are no more tuples
+   */
+  auto Next(Tuple *tuple, RID *rid) -> bool override;
+
+  /**
+   * Yield the next batch the pipeline outputs.
+   * @param[out] batch The batch of tuples produced by the pipeline
+   * @return `true` if the batch has some tuple, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
+  /** @return The output schema of the pipeline */
+  auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
+
+ private:
+  /** Set `outputs` to the sink each executor of the pipeline pushes to: the one above it, or `sink` for the top one */
+  void MakeOutputs(const BatchSink &sink, std::vector<BatchSink> *outputs);
+
+  /** Let each executor of the pipeline push what it has left, once the source is exhausted, from the bottom up */
+  void Finish(const std::vector<BatchSink> &outputs);
+
+  /**
+   * Pull a batch of the source and push it through the pipeline, or finish the pipeline once the source is exhausted.
+   * @return `false` if the pipeline was finished already
+   */
+  auto PullSource() -> bool;
+
+  /** The top of the pipeline */
+  AbstractPlanNodeRef plan_;
+
+  /** The source, and the executors above it */
+  std::unique_ptr<AbstractExecutor> source_;
+  std::vector<std::unique_ptr<AbstractExecutor>> operators_;
+
+  /** When the pipeline is pulled: the batch of the source, what the pipeline output for it, and the tuple Next is at */
+  TupleBatch source_batch_;
+  std::vector<BatchSink> outputs_;
+  std::deque<TupleBatch> output_batches_;
+  bool source_done_{false};
+  size_t next_row_{0};
+};
+
+}  // namespace bustub
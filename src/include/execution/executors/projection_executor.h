@@ -47,6 +47,20 @@ class ProjectionExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the projection.
+   * @param[out] batch The batch of tuples produced by the projection
+   * @return `true` if the batch has some tuple, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
+  /**
+   * Take a batch pushed by the executor below, in a push-based pipeline, and push the tuples it projects to `output`.
+   * @param batch the batch pushed
+   * @param output takes the batches of the projection
+   */
+  void Consume(TupleBatch *batch, const BatchSink &output) override;
+
   /** @return The output schema for the projection plan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
@@ -54,7 +68,13 @@ class ProjectionExecutor : public AbstractExecutor {
   /** The projection plan node to be executed */
   const ProjectionPlanNode *plan_;
 
-  /** The child executor from which tuples are obtained */
+  /** The child executor from which tuples are obtained, or nullptr in a push-based pipeline */
   std::unique_ptr<AbstractExecutor> child_executor_;
+
+  /** The batch pulled from the child, and the columns computed over it */
+  TupleBatch child_batch_;
+  std::vector<std::vector<Value>> columns_;
+  /** The batch pushed to the executor above, in a push-based pipeline */
+  TupleBatch output_batch_;
 };
 }  // namespace bustub
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -21,6 +22,7 @@
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
+#include "storage/table/table_column_iterator.h"
 #include "storage/table/table_iterator.h"
 #include "storage/table/tuple.h"
 
@@ -49,14 +51,38 @@ class SeqScanExecutor : public AbstractExecutor {
    */
   auto Next(Tuple *tuple, RID *rid) -> bool override;
 
+  /**
+   * Yield the next batch of tuples from the sequential scan.
+   * @param[out] batch The batch of tuples produced by the sequential scan
+   * @return `true` if the batch has some tuple, `false` if there are no more tuples
+   */
+  auto NextBatch(TupleBatch *batch) -> bool override;
+
+  /**
+   * Scan only a morsel of the table from now on, e.g. one of those dealt to a worker of a parallel pipeline.
+   * @param morsel an iterator over the morsel, from TableHeap::MakeMorselIterators
+   */
+  void SetMorsel(TableIterator &&morsel);
+
   /** @return The output schema for the sequential scan */
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
  private:
+  /** @return whether `tuple` satisfies the filter predicate of the plan, if any */
+  auto Matches(const TupleView &tuple) const -> bool;
+
+  /** @return the values of the tuple `column_iter_` is on, NULL for the columns it does not read */
+  auto ReadColumnValues() const -> std::vector<Value>;
+
   /** The sequential scan plan node to be executed */
   const SeqScanPlanNode *plan_;
   // std::shared_ptr<TableIterator> table_iter_;
   const TableInfo *table_info_;
   TableIterator table_iter_;
+  /** Set when the plan reads only some columns of a PAX table; the others are output as NULL */
+  std::optional<TableColumnIterator> column_iter_;
+  /** Set when the plan has a filter predicate: false for the pages whose zone rules the predicate out */
+  std::function<bool(page_id_t)> page_filter_;
+  page_id_t checked_page_id_{INVALID_PAGE_ID};
 };
 }  // namespace bustub
@@ -17,14 +17,38 @@
 
 #include "execution/executor_context.h"
 #include "execution/executors/abstract_executor.h"
+#include "execution/loser_tree.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/sort_plan.h"
+#include "execution/sort_key.h"
+#include "storage/table/tmp_tuple_heap.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
+/**
+ * A sorted run of tuples. It is kept in memory, or spilled to disk and read back a page at a time as it is merged.
+ */
+struct SortRun {
+  /** @return whether the run is all merged */
+  auto IsExhausted() const -> bool { return pos_ == entries_.size(); }
+
+  /** The entries of the run, or those of the page of it read back, and the one it is at */
+  std::vector<SortEntry> entries_;
+  size_t pos_{0};
+  /** The run spilled, and the next page of it to read back, if it is */
+  std::unique_ptr<TmpTupleHeap> heap_;
+  size_t next_page_{0};
+};
+
 /**
  * The SortExecutor executor executes a sort.
+ *
+ * The order-bys are evaluated once per child tuple, into a sort key compared as bytes. The child tuples are cut into
+ * sorted runs, which a loser tree merges as the tuples are output. A run is as large as the memory budget of the
+ * query, past which it is spilled to disk, so that only a page of every run is kept in memory while they are merged.
+ * Without a budget, the tuples make a single run, or a run per worker if the child runs on the workers of the query,
+ * each sorting its own.
  */
 class SortExecutor : public AbstractExecutor {
  public:
@@ -50,11 +74,30 @@ class SortExecutor : public AbstractExecutor {
   auto GetOutputSchema() const -> const Schema & override { return plan_->OutputSchema(); }
 
  private:
+  /** Tells the merge whether the head of a run comes before that of another */
+  struct RunLess {
+    auto operator()(size_t a, size_t b) const -> bool;
+    const SortExecutor *sort_;
+  };
+
+  /**
+   * Add the entries of a batch of child tuples to `entries`.
+   * @return about the memory the entries added take
+   */
+  auto AppendEntries(const TupleBatch &batch, Arena *arena, std::vector<SortEntry> *entries) const -> size_t;
+
+  /** Spill sorted entries to disk as a run */
+  void SpillRun(std::vector<SortEntry> *entries);
+
+  /** Read back the next page of a run spilled, once the entries of the page before are all merged */
+  void ReadBack(SortRun *run) const;
+
   /** The sort plan node to be executed */
   const SortPlanNode *plan_;
   std::unique_ptr<AbstractExecutor> child_;
-  std::vector<Tuple> child_tuples_;
 
-  std::vector<Tuple>::const_iterator child_iter_;
+  /** The sorted runs, and the loser tree merging them */
+  std::vector<SortRun> runs_;
+  std::unique_ptr<LoserTree<RunLess>> merge_;
 };
 }  // namespace bustub
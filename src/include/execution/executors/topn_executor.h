@@ -21,12 +21,16 @@
 #include "execution/executors/abstract_executor.h"
 #include "execution/plans/seq_scan_plan.h"
 #include "execution/plans/topn_plan.h"
+#include "execution/sort_key.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
 /**
  * The TopNExecutor executor executes a topn.
+ *
+ * The order-bys are evaluated once per child tuple, into a sort key compared as bytes, and a child tuple is only kept
+ * while its key is among the n that come first.
  */
 class TopNExecutor : public AbstractExecutor {
  public:
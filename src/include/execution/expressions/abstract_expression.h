@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "catalog/schema.h"
+#include "execution/tuple_batch.h"
 #include "fmt/format.h"
 #include "storage/table/tuple.h"
 
@@ -54,6 +55,33 @@ class AbstractExpression {
   /** @return The value obtained by evaluating the tuple with the given schema */
   virtual auto Evaluate(const Tuple *tuple, const Schema &schema) const -> Value = 0;
 
+  /** @return The value obtained by evaluating the tuple in place, e.g. in a page, with the given schema */
+  virtual auto EvaluateView(const TupleView &tuple, const Schema &schema) const -> Value = 0;
+
+  /**
+   * Evaluate the expression over every row of a batch at once.
+   * @param batch the rows, whose schema the expression refers to
+   * @param[out] values the value of each row, in order; anything in it before is dropped
+   */
+  virtual void EvaluateBatch(const TupleBatch &batch, std::vector<Value> *values) const = 0;
+
+  /** @return the column of the batch the expression is, if it is a bare column reference, or nullptr */
+  virtual auto GetBatchColumn(const TupleBatch &batch) const -> const std::vector<Value> * { return nullptr; }
+
+  /**
+   * Evaluate the expression over every row of a batch at once, without copying a column it reads as is.
+   * @param batch the rows, whose schema the expression refers to
+   * @param[out] values where the values are evaluated into, unless they are a column of the batch
+   * @return the value of each row, in order: either a column of `batch` or `values`
+   */
+  auto EvaluateBatchRef(const TupleBatch &batch, std::vector<Value> *values) const -> const std::vector<Value> & {
+    if (const auto *column = GetBatchColumn(batch); column != nullptr) {
+      return *column;
+    }
+    EvaluateBatch(batch, values);
+    return *values;
+  }
+
   /**
    * Returns the value obtained by evaluating a JOIN.
    * @param left_tuple The left tuple
@@ -54,6 +54,30 @@ class ArithmeticExpression : public AbstractExpression {
     return ValueFactory::GetIntegerValue(*res);
   }
 
+  auto EvaluateView(const TupleView &tuple, const Schema &schema) const -> Value override {
+    Value lhs = GetChildAt(0)->EvaluateView(tuple, schema);
+    Value rhs = GetChildAt(1)->EvaluateView(tuple, schema);
+    auto res = PerformComputation(lhs, rhs);
+    if (res == std::nullopt) {
+      return ValueFactory::GetNullValueByType(TypeId::INTEGER);
+    }
+    return ValueFactory::GetIntegerValue(*res);
+  }
+
+  void EvaluateBatch(const TupleBatch &batch, std::vector<Value> *values) const override {
+    // a child that is a column of the batch is read in place; the left one is otherwise evaluated into `values`, and
+    // each row is overwritten with its result
+    std::vector<Value> rhs_values;
+    const auto &lhs = GetChildAt(0)->EvaluateBatchRef(batch, values);
+    const auto &rhs = GetChildAt(1)->EvaluateBatchRef(batch, &rhs_values);
+    values->resize(lhs.size());
+    for (size_t row = 0; row < lhs.size(); row++) {
+      auto res = PerformComputation(lhs[row], rhs[row]);
+      (*values)[row] = res == std::nullopt ? ValueFactory::GetNullValueByType(TypeId::INTEGER)
+                                           : ValueFactory::GetIntegerValue(*res);
+    }
+  }
+
   auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
                     const Schema &right_schema) const -> Value override {
     Value lhs = GetChildAt(0)->EvaluateJoin(left_tuple, left_schema, right_tuple, right_schema);
@@ -29,6 +29,12 @@ class ConstantValueExpression : public AbstractExpression {
 
   auto Evaluate(const Tuple *tuple, const Schema &schema) const -> Value override { return val_; }
 
+  auto EvaluateView(const TupleView &tuple, const Schema &schema) const -> Value override { return val_; }
+
+  void EvaluateBatch(const TupleBatch &batch, std::vector<Value> *values) const override {
+    values->assign(batch.Size(), val_);
+  }
+
   auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
                     const Schema &right_schema) const -> Value override {
     return val_;
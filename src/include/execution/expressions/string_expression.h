@@ -73,6 +73,21 @@ class StringExpression : public AbstractExpression {
     return ValueFactory::GetVarcharValue(Compute(str));
   }
 
+  auto EvaluateView(const TupleView &tuple, const Schema &schema) const -> Value override {
+    Value val = GetChildAt(0)->EvaluateView(tuple, schema);
+    auto str = val.GetAs<char *>();
+    return ValueFactory::GetVarcharValue(Compute(str));
+  }
+
+  void EvaluateBatch(const TupleBatch &batch, std::vector<Value> *values) const override {
+    // a child that is a column of the batch is read in place, and its values are otherwise overwritten row by row
+    const auto &child = GetChildAt(0)->EvaluateBatchRef(batch, values);
+    values->resize(child.size());
+    for (size_t row = 0; row < child.size(); row++) {
+      (*values)[row] = ValueFactory::GetVarcharValue(Compute(child[row].GetAs<char *>()));
+    }
+  }
+
   auto EvaluateJoin(const Tuple *left_tuple, const Schema &left_schema, const Tuple *right_tuple,
                     const Schema &right_schema) const -> Value override {
     Value val = GetChildAt(0)->EvaluateJoin(left_tuple, left_schema, right_tuple, right_schema);
@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// loser_tree.h
+//
+// Identification: src/include/execution/loser_tree.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+namespace bustub {
+
+/**
+ * LoserTree merges k sorted runs. It is a tournament tree whose every inner node keeps the run that lost the match
+ * played there, and whose root keeps the run that won them all, i.e. the run whose head comes first. Once that head is
+ * taken, the run plays again against the losers on its path to the root only, a match per level.
+ *
+ * The tree only knows the runs by their index. `Less(a, b)` tells whether the head of run `a` comes before that of run
+ * `b`, a run that is exhausted coming after every other.
+ */
+template <typename Less>
+class LoserTree {
+ public:
+  /**
+   * Construct the tree over runs 0 to `run_count` - 1, and play their heads against each other.
+   * @param run_count the number of runs, at least 1
+   * @param less tells whether the head of a run comes before that of another
+   */
+  LoserTree(size_t run_count, Less less) : run_count_(run_count), less_(std::move(less)), tree_(run_count, run_count) {
+    for (size_t run = 0; run < run_count_; run++) {
+      Replay(run);
+    }
+  }
+
+  /** @return the run whose head comes first */
+  auto Top() const -> size_t { return tree_[0]; }
+
+  /** Play the run whose head was taken again, once it has a new head or is exhausted */
+  void Pop() { Replay(tree_[0]); }
+
+ private:
+  /** Play run `winner` from its leaf up to the root */
+  void Replay(size_t winner) {
+    for (size_t node = (winner + run_count_) / 2; node > 0; node /= 2) {
+      // while the tree is built, the first run to reach a node waits there for the winner of the other subtree
+      if (tree_[node] == run_count_) {
+        tree_[node] = winner;
+        return;
+      }
+      if (Beats(tree_[node], winner)) {
+        std::swap(tree_[node], winner);
+      }
+    }
+    tree_[0] = winner;
+  }
+
+  /** @return whether run `a` wins over run `b`, the run with the lower index on a tie so that the merge is stable */
+  auto Beats(size_t a, size_t b) const -> bool {
+    if (less_(a, b)) {
+      return true;
+    }
+    return !less_(b, a) && a < b;
+  }
+
+  size_t run_count_;
+  Less less_;
+  /** The run that won at the root, then the run that lost at every inner node */
+  std::vector<size_t> tree_;
+};
+
+}  // namespace bustub
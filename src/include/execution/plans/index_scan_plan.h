@@ -22,32 +22,81 @@
 namespace bustub {
 /**
  * IndexScanPlanNode identifies a table that should be scanned with an optional predicate.
+ * Without a probe key the whole index is walked in key order; with one, only the entries equal to the key are fetched.
  */
 class IndexScanPlanNode : public AbstractPlanNode {
  public:
   /**
    * Creates a new index scan plan node.
    * @param output the output format of this scan plan node
-   * @param table_oid the identifier of table to be scanned
+   * @param index_oid the identifier of the index to be scanned
+   * @param index_type the access method backing the index
+   * @param pred_key the constant key to probe for, or nullptr to scan the whole index
+   * @param filter_predicate the predicate applied to the fetched tuples, or nullptr
+   * @param index_only whether the columns that are read can all be taken from the index entries
+   * @param sorted_fetch whether to fetch the matching tuples in page order rather than in key order
    */
-  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid)
-      : AbstractPlanNode(std::move(output), {}), index_oid_(index_oid) {}
+  IndexScanPlanNode(SchemaRef output, index_oid_t index_oid, IndexType index_type = IndexType::BPlusTreeIndex,
+                    AbstractExpressionRef pred_key = nullptr, AbstractExpressionRef filter_predicate = nullptr,
+                    bool index_only = false, bool sorted_fetch = false)
+      : AbstractPlanNode(std::move(output), {}),
+        index_oid_(index_oid),
+        index_type_(index_type),
+        pred_key_(std::move(pred_key)),
+        filter_predicate_(std::move(filter_predicate)),
+        index_only_(index_only),
+        sorted_fetch_(sorted_fetch) {}
 
   auto GetType() const -> PlanType override { return PlanType::IndexScan; }
 
   /** @return the identifier of the table that should be scanned */
   auto GetIndexOid() const -> index_oid_t { return index_oid_; }
 
+  /** @return the key to probe for, or nullptr for a full index scan */
+  auto GetPredKey() const -> const AbstractExpressionRef & { return pred_key_; }
+
   BUSTUB_PLAN_NODE_CLONE_WITH_CHILDREN(IndexScanPlanNode);
 
   /** The table whose tuples should be scanned. */
   index_oid_t index_oid_;
 
-  // Add anything you want here for index lookup
+  /** The access method of the index, shown in EXPLAIN */
+  IndexType index_type_;
+
+  /** The equality key to look up; a hash index can only be used this way */
+  AbstractExpressionRef pred_key_;
+
+  /** The predicate that fetched tuples must satisfy */
+  AbstractExpressionRef filter_predicate_;
+
+  /**
+   * Whether the scan may skip the table heap. Only the indexed columns of the produced tuples are filled in then, the
+   * others are NULL, so this is only set when nothing above reads them.
+   */
+  bool index_only_;
+
+  /**
+   * Whether the matching RIDs are collected in batches and sorted, so every table page is fetched once per batch. The
+   * tuples then come out in no particular order, so this is only set for key probes.
+   */
+  bool sorted_fetch_;
 
  protected:
   auto PlanNodeToString() const -> std::string override {
-    return fmt::format("IndexScan {{ index_oid={} }}", index_oid_);
+    std::string details = fmt::format("index_oid={}, index_type={}", index_oid_, index_type_);
+    if (pred_key_ != nullptr) {
+      details += fmt::format(", pred_key={}", pred_key_);
+    }
+    if (filter_predicate_ != nullptr) {
+      details += fmt::format(", filter={}", filter_predicate_);
+    }
+    if (index_only_) {
+      details += ", index_only=true";
+    }
+    if (sorted_fetch_) {
+      details += ", sorted_fetch=true";
+    }
+    return fmt::format("IndexScan {{ {} }}", details);
   }
 };
 
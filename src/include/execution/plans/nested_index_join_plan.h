@@ -35,7 +35,8 @@ class NestedIndexJoinPlanNode : public AbstractPlanNode {
  public:
   NestedIndexJoinPlanNode(SchemaRef output, AbstractPlanNodeRef child, AbstractExpressionRef key_predicate,
                           table_oid_t inner_table_oid, index_oid_t index_oid, std::string index_name,
-                          std::string index_table_name, SchemaRef inner_table_schema, JoinType join_type)
+                          std::string index_table_name, SchemaRef inner_table_schema, JoinType join_type,
+                          IndexType index_type = IndexType::BPlusTreeIndex)
       : AbstractPlanNode(std::move(output), {std::move(child)}),
         key_predicate_(std::move(key_predicate)),
         inner_table_oid_(inner_table_oid),
@@ -43,7 +44,8 @@ class NestedIndexJoinPlanNode : public AbstractPlanNode {
         index_name_(std::move(index_name)),
         index_table_name_(std::move(index_table_name)),
         inner_table_schema_(std::move(inner_table_schema)),
-        join_type_(join_type) {}
+        join_type_(join_type),
+        index_type_(index_type) {}
 
   auto GetType() const -> PlanType override { return PlanType::NestedIndexJoin; }
 
@@ -81,10 +83,13 @@ class NestedIndexJoinPlanNode : public AbstractPlanNode {
   /** The join type */
   JoinType join_type_;
 
+  /** The access method of the inner index, shown in EXPLAIN */
+  IndexType index_type_;
+
  protected:
   auto PlanNodeToString() const -> std::string override {
-    return fmt::format("NestedIndexJoin {{ type={}, key_predicate={}, index={}, index_table={} }}", join_type_,
-                       key_predicate_, index_name_, index_table_name_);
+    return fmt::format("NestedIndexJoin {{ type={}, key_predicate={}, index={}, index_type={}, index_table={} }}",
+                       join_type_, key_predicate_, index_name_, index_type_, index_table_name_);
   }
 };
 }  // namespace bustub
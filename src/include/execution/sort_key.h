@@ -0,0 +1,60 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key.h
+//
+// Identification: src/include/execution/sort_key.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "binder/bound_order_by.h"
+#include "execution/expressions/abstract_expression.h"
+#include "execution/tuple_batch.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/** The order-bys of a sort or a topn: the order of each and the expression it sorts by */
+using OrderBys = std::vector<std::pair<OrderByType, AbstractExpressionRef>>;
+
+/**
+ * A sort key is the values of the order-bys over a tuple, normalized into bytes that compare byte by byte, as memcmp
+ * does, the way the tuples are to be sorted. The values are evaluated once per tuple, and never compared as Values.
+ *
+ * Each value is a byte telling whether it is null, null coming first, then, unless null:
+ * - integers, of any width, as 8 bytes big endian with the sign bit flipped
+ * - decimals as the 8 bytes of the double big endian, with the sign bit flipped if positive, all bits if negative
+ * - timestamps as 8 bytes big endian, and booleans as a byte
+ * - varchars as their bytes, a 0 escaped as 0 0xFF, and ended with 0 0
+ *
+ * Every byte of a value sorted DESC is inverted, so that a null comes last. Since no encoding is a prefix of another,
+ * the values of a key never run into each other.
+ */
+using SortKey = std::string;
+
+/** A tuple to be sorted, along with its sort key */
+struct SortEntry {
+  SortKey key_;
+  Tuple tuple_;
+};
+
+/** Append the encoding of `value` sorted by `order_by_type` to `key` */
+void AppendSortKey(const Value &value, OrderByType order_by_type, SortKey *key);
+
+/** @return the sort key of `tuple` over `order_bys` */
+auto MakeSortKey(const OrderBys &order_bys, const Tuple &tuple, const Schema &schema) -> SortKey;
+
+/** Set `keys` to the sort key of every row of `batch` over `order_bys`, each order-by evaluated over the batch */
+void MakeSortKeys(const OrderBys &order_bys, const TupleBatch &batch, std::vector<SortKey> *keys);
+
+}  // namespace bustub
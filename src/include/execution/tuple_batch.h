@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_batch.h
+//
+// Identification: src/include/execution/tuple_batch.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/arena.h"
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/** The number of rows an executor puts in a batch, at most */
+static constexpr size_t TUPLE_BATCH_SIZE = 1024;
+
+/**
+ * TupleBatch holds up to `TUPLE_BATCH_SIZE` rows of a schema, laid out by column: the values of each column are kept
+ * together, so that an expression is evaluated over a whole column in one call instead of once per tuple.
+ */
+class TupleBatch {
+ public:
+  /** Create an empty batch of rows of `schema`, which must outlive the batch. */
+  explicit TupleBatch(const Schema *schema);
+
+  /** @return the schema of the rows */
+  auto GetSchema() const -> const Schema & { return *schema_; }
+
+  /** @return the number of rows */
+  auto Size() const -> size_t { return rids_.size(); }
+
+  /** @return whether the batch has no row */
+  auto IsEmpty() const -> bool { return rids_.empty(); }
+
+  /** @return whether the batch has `TUPLE_BATCH_SIZE` rows or more */
+  auto IsFull() const -> bool { return rids_.size() >= TUPLE_BATCH_SIZE; }
+
+  /** Remove every row, keeping the memory of the columns. */
+  void Clear();
+
+  /** @return the values of a column, one per row */
+  auto GetColumn(uint32_t column_idx) const -> const std::vector<Value> & { return columns_[column_idx]; }
+
+  /** @return the value of a column in a row */
+  auto GetValue(size_t row, uint32_t column_idx) const -> const Value & { return columns_[column_idx][row]; }
+
+  /** @return the RID of a row */
+  auto GetRid(size_t row) const -> RID { return rids_[row]; }
+
+  /** @return the RIDs of the rows */
+  auto GetRids() const -> const std::vector<RID> & { return rids_; }
+
+  /** Append a row with the values of `tuple`. */
+  void AppendTuple(const Tuple &tuple, RID rid);
+
+  /** Append a row with the values of a tuple read in place. */
+  void AppendView(const TupleView &tuple);
+
+  /** Append a row, one value per column. */
+  void AppendRow(std::vector<Value> values, RID rid);
+
+  /** @return a row as a tuple, its data allocated from `arena` if given */
+  auto GetTuple(size_t row, Arena *arena = nullptr) const -> Tuple;
+
+  /**
+   * Keep only the rows for which `predicate`, one boolean value per row, is true, in their order. The predicate may
+   * be a column of the batch itself, as the predicate of a row is read before the row moves.
+   */
+  void Select(const std::vector<Value> &predicate);
+
+  /** Keep only the first `size` rows. */
+  void Truncate(size_t size);
+
+  /**
+   * Replace the rows with columns computed elsewhere, e.g. by evaluating expressions over another batch.
+   * @param columns the values of each column, one per row
+   * @param rids the RID of each row
+   */
+  void SetColumns(std::vector<std::vector<Value>> *columns, const std::vector<RID> &rids);
+
+ private:
+  const Schema *schema_;
+  std::vector<std::vector<Value>> columns_;
+  std::vector<RID> rids_;
+};
+
+}  // namespace bustub
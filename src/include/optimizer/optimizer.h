@@ -4,6 +4,7 @@
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -83,9 +84,30 @@ class Optimizer {
    */
   auto OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
 
-  /** @brief check if the index can be matched */
+  /** @brief check if the index can be matched, preferring a hash index since only equality lookups are needed */
   auto MatchIndex(const std::string &table_name, uint32_t index_key_idx)
-      -> std::optional<std::tuple<index_oid_t, std::string>>;
+      -> std::optional<std::tuple<index_oid_t, std::string, IndexType>>;
+
+  /**
+   * @brief optimize `col = constant` filters over a table scan into an index probe, if an index on `col` exists.
+   */
+  auto OptimizeSeqScanAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief mark an index scan below a projection or an aggregation as index-only when some B+ tree index searched on
+   * the same columns stores every column read, so the table heap is never touched.
+   */
+  auto OptimizeIndexOnlyScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /**
+   * @brief make a sequential scan of a PAX table below a projection or an aggregation, possibly through a filter, read
+   * only the columns used above it. A scan of a table of the row layout then leaves out the values stored out of line
+   * of the other columns.
+   */
+  auto OptimizeColumnarScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef;
+
+  /** @brief collect the indexes of the columns `expr` reads from its (only) input */
+  static void CollectColumns(const AbstractExpressionRef &expr, std::unordered_set<uint32_t> *columns);
 
   /**
    * @brief optimize sort + limit as top N
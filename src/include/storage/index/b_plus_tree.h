@@ -11,13 +11,16 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <deque>
 #include <iostream>
+#include <memory>
 #include <mutex>  // NOLINT
 #include <optional>
 #include <queue>
 #include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "common/config.h"
@@ -58,6 +61,23 @@ class Context {
   auto IsRootPage(page_id_t page_id) -> bool { return page_id == root_page_id_; }
 };
 
+/**
+ * @brief Bumps the structure version of a B+ tree for as long as it lives.
+ *
+ * The version is odd while a writer may be changing internal pages (or the root page id), and even otherwise.
+ * Readers of the path cache snapshot the version before descending and re-check it afterwards.
+ */
+class StructureChangeGuard {
+ public:
+  explicit StructureChangeGuard(std::atomic<uint64_t> *version) : version_(version) { version_->fetch_add(1); }
+  StructureChangeGuard(const StructureChangeGuard &) = delete;
+  auto operator=(const StructureChangeGuard &) -> StructureChangeGuard & = delete;
+  ~StructureChangeGuard() { version_->fetch_add(1); }
+
+ private:
+  std::atomic<uint64_t> *version_;
+};
+
 #define BPLUSTREE_TYPE BPlusTree<KeyType, ValueType, KeyComparator>
 
 // Main class providing the API for the Interactive B+ Tree.
@@ -69,7 +89,8 @@ class BPlusTree {
  public:
   explicit BPlusTree(std::string name, page_id_t header_page_id, BufferPoolManager *buffer_pool_manager,
                      const KeyComparator &comparator, int leaf_max_size = LEAF_PAGE_SIZE,
-                     int internal_max_size = INTERNAL_PAGE_SIZE);
+                     int internal_max_size = INTERNAL_PAGE_SIZE,
+                     int path_cache_levels = BPLUSTREE_PATH_CACHE_LEVELS);
 
   // Returns true if this B+ tree has no keys and values.
   auto IsEmpty() const -> bool;
@@ -142,6 +163,30 @@ class BPlusTree {
    */
   auto ToPrintableBPlusTree(page_id_t root_id) -> PrintableBPlusTree;
 
+  // Return the child of an internal page that may contain key
+  auto LookupChild(const InternalPage *page, const KeyType &key) -> page_id_t;
+
+  /**
+   * Point lookup that starts below the cached upper levels. Returns std::nullopt if the tree structure changed
+   * while descending, in which case the caller falls back to the normal lookup.
+   */
+  auto GetValueThroughPathCache(const KeyType &key, std::vector<ValueType> *result) -> std::optional<bool>;
+
+  // Walk the cached internal pages for the given structure version, INVALID_PAGE_ID if the cache is stale
+  auto DescendPathCache(const KeyType &key, uint64_t version, int *level) -> page_id_t;
+
+  void ResetPathCache(uint64_t version, page_id_t root_page_id);
+
+  void CachePathPage(uint64_t version, page_id_t page_id, const char *data);
+
+  /** In-memory copies of the internal pages in the top path_cache_levels_ levels of the tree. */
+  struct PathCache {
+    // odd versions are never reached by readers, so the cache starts out invalid
+    uint64_t version_{1};
+    page_id_t root_page_id_{INVALID_PAGE_ID};
+    std::unordered_map<page_id_t, std::unique_ptr<char[]>> pages_;
+  };
+
   // member variable
   std::mutex latch_;  // NOLINT
   std::string index_name_;
@@ -151,6 +196,10 @@ class BPlusTree {
   int leaf_max_size_;
   int internal_max_size_;
   page_id_t header_page_id_;
+  int path_cache_levels_;
+  std::atomic<uint64_t> structure_version_{0};
+  std::shared_mutex path_cache_latch_;
+  PathCache path_cache_;
 };
 
 /**
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <string>
@@ -19,11 +21,46 @@
 #include "container/hash/hash_function.h"
 #include "storage/index/b_plus_tree.h"
 #include "storage/index/index.h"
+#include "storage/index/memcmp_key.h"
 
 namespace bustub {
 
 #define BPLUSTREE_INDEX_TYPE BPlusTreeIndex<KeyType, ValueType, KeyComparator>
 
+/**
+ * Adapts the B+ tree iterator to the type-erased `IndexCursor`.
+ *
+ * A cursor made for a lookup key starts at the first entry not less than the key and stops once the leading
+ * `prefix_size` bytes of the entries stop matching it.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+class BPlusTreeIndexCursor : public IndexCursor {
+ public:
+  BPlusTreeIndexCursor(BPlusTree<KeyType, ValueType, KeyComparator> *tree, Schema *key_schema)
+      : iter_(tree->Begin()), key_schema_(key_schema) {}
+
+  BPlusTreeIndexCursor(BPlusTree<KeyType, ValueType, KeyComparator> *tree, Schema *key_schema, const KeyType &key,
+                       size_t prefix_size)
+      : iter_(tree->Begin(key)), key_schema_(key_schema), key_(key), prefix_size_(prefix_size) {}
+
+  auto IsEnd() -> bool override {
+    return iter_.IsEnd() || (prefix_size_ > 0 && memcmp((*iter_).first.data_, key_.data_, prefix_size_) != 0);
+  }
+
+  auto GetRID() -> RID override { return (*iter_).second; }
+
+  void Next() override { ++iter_; }
+
+  auto GetKeyValue(uint32_t column_idx) -> Value override { return (*iter_).first.ToValue(key_schema_, column_idx); }
+
+ private:
+  INDEXITERATOR_TYPE iter_;
+  Schema *key_schema_;
+  /** The lookup key, compared on its first `prefix_size_` bytes; 0 for a full scan */
+  KeyType key_{};
+  size_t prefix_size_{0};
+};
+
 INDEX_TEMPLATE_ARGUMENTS
 class BPlusTreeIndex : public Index {
  public:
@@ -31,6 +68,8 @@ class BPlusTreeIndex : public Index {
 
   auto InsertEntry(const Tuple &key, RID rid, Transaction *transaction) -> bool override;
 
+  auto InsertEntries(const std::vector<std::pair<Tuple, RID>> &entries, Transaction *transaction) -> size_t override;
+
   void DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) override;
 
   void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) override;
@@ -41,9 +80,24 @@ class BPlusTreeIndex : public Index {
 
   auto GetEndIterator() -> INDEXITERATOR_TYPE;
 
+  auto MakeCursor() -> std::unique_ptr<IndexCursor> override;
+
+  auto MakeCursor(const Tuple &key) -> std::unique_ptr<IndexCursor> override;
+
+  auto CanReturnKeys() const -> bool override { return keys_decodable_.load(); }
+
  protected:
+  // the key of the entry of `key` for `rid`, which holds the RID too if the keys are memcmp-encoded
+  auto MakeEntryKey(const Tuple &key, RID rid) -> KeyType;
+
   // comparator for key
   KeyComparator comparator_;
+  // the number of leading key bytes a lookup key fixes
+  size_t search_prefix_size_;
+  // where the RID of an entry is encoded into its key, after the columns; 0 if it is not
+  size_t rid_offset_{0};
+  // cleared for good once a key is inserted that `KeyType::ToValue` cannot give back
+  std::atomic<bool> keys_decodable_{true};
   // container
   std::shared_ptr<BPlusTree<KeyType, ValueType, KeyComparator>> container_;
 };
@@ -35,6 +35,9 @@ class GenericKey {
     memcpy(data_, tuple.GetData(), tuple.GetLength());
   }
 
+  // the tuple layout is the key, so the schema is not needed
+  inline void SetFromKey(const Tuple &tuple, [[maybe_unused]] const Schema &key_schema) { SetFromKey(tuple); }
+
   // NOTE: for test purpose only
   inline void SetFromInteger(int64_t key) {
     memset(data_, 0, KeySize);
@@ -55,6 +58,11 @@ class GenericKey {
     return Value::DeserializeFrom(data_ptr, column_type);
   }
 
+  /** @return whether `ToValue` gives back the columns of `tuple`, i.e. the whole tuple fits in the key */
+  static auto CanDecode(const Tuple &tuple, [[maybe_unused]] const Schema &key_schema) -> bool {
+    return tuple.GetLength() <= KeySize;
+  }
+
   // NOTE: for test purpose only
   // interpret the first 8 bytes as int64_t from data vector
   inline auto ToString() const -> int64_t { return *reinterpret_cast<int64_t *>(const_cast<char *>(data_)); }
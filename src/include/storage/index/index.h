@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "catalog/schema.h"
+#include "common/macros.h"
 #include "storage/table/tuple.h"
 #include "type/value.h"
 
@@ -43,11 +44,18 @@ class IndexMetadata {
    * @param table_name The name of the table on which the index is created
    * @param tuple_schema The schema of the indexed key
    * @param key_attrs The mapping from indexed columns to base table columns
+   * @param include_count The number of trailing key attributes that are only carried along, not searched on
    */
   IndexMetadata(std::string index_name, std::string table_name, const Schema *tuple_schema,
-                std::vector<uint32_t> key_attrs)
-      : name_(std::move(index_name)), table_name_(std::move(table_name)), key_attrs_(std::move(key_attrs)) {
+                std::vector<uint32_t> key_attrs, size_t include_count = 0)
+      : name_(std::move(index_name)),
+        table_name_(std::move(table_name)),
+        key_attrs_(std::move(key_attrs)),
+        include_count_(include_count) {
+    BUSTUB_ASSERT(include_count_ < key_attrs_.size(), "an index needs at least one search column");
     key_schema_ = std::make_shared<Schema>(Schema::CopySchema(tuple_schema, key_attrs_));
+    std::vector<uint32_t> search_attrs(key_attrs_.begin(), key_attrs_.end() - include_count_);
+    search_key_schema_ = std::make_shared<Schema>(Schema::CopySchema(tuple_schema, search_attrs));
   }
 
   ~IndexMetadata() = default;
@@ -72,6 +80,12 @@ class IndexMetadata {
   /** @return The mapping relation between indexed columns and base table columns */
   inline auto GetKeyAttrs() const -> const std::vector<uint32_t> & { return key_attrs_; }
 
+  /** @return The number of included columns at the end of the key, which are stored but not searched on */
+  inline auto GetIncludeCount() const -> size_t { return include_count_; }
+
+  /** @return A schema object pointer for the leading key columns that lookups are made with */
+  inline auto GetSearchKeySchema() const -> Schema * { return search_key_schema_.get(); }
+
   /** @return A string representation for debugging */
   auto ToString() const -> std::string {
     std::stringstream os;
@@ -92,8 +106,38 @@ class IndexMetadata {
   std::string table_name_;
   /** The mapping relation between key schema and tuple schema */
   const std::vector<uint32_t> key_attrs_;
+  /** The number of included columns at the end of `key_attrs_` */
+  const size_t include_count_;
   /** The schema of the indexed key */
   std::shared_ptr<Schema> key_schema_;
+  /** The schema of the searched part of the key */
+  std::shared_ptr<Schema> search_key_schema_;
+};
+
+/**
+ * class IndexCursor - Walks the entries of an ordered index in key order.
+ *
+ * The cursor hides the key type of the index, so executors can scan any
+ * ordered index without knowing how its keys are encoded.
+ */
+class IndexCursor {
+ public:
+  virtual ~IndexCursor() = default;
+
+  /** @return whether the cursor is past the last entry */
+  virtual auto IsEnd() -> bool = 0;
+
+  /** @return The RID of the current entry */
+  virtual auto GetRID() -> RID = 0;
+
+  /** Advance to the next entry */
+  virtual void Next() = 0;
+
+  /**
+   * @return The `column_idx`-th key column of the current entry, decoded from the index itself.
+   * Only valid when the index `CanReturnKeys()`.
+   */
+  virtual auto GetKeyValue(uint32_t column_idx) -> Value = 0;
 };
 
 /////////////////////////////////////////////////////////////////////
@@ -139,6 +183,12 @@ class Index {
   /** @return The index key attributes */
   auto GetKeyAttrs() const -> const std::vector<uint32_t> & { return metadata_->GetKeyAttrs(); }
 
+  /** @return The number of included columns at the end of the key */
+  auto GetIncludeCount() const -> size_t { return metadata_->GetIncludeCount(); }
+
+  /** @return The schema lookup keys are built with, i.e. the key schema without the included columns */
+  auto GetSearchKeySchema() const -> Schema * { return metadata_->GetSearchKeySchema(); }
+
   /** @return A string representation for debugging */
   auto ToString() const -> std::string {
     std::stringstream os;
@@ -160,6 +210,20 @@ class Index {
    */
   virtual auto InsertEntry(const Tuple &key, RID rid, Transaction *transaction) -> bool = 0;
 
+  /**
+   * Insert many entries at once, e.g. for a bulk load. An index may reorder them to insert faster.
+   * @param entries The index keys and their RIDs
+   * @param transaction The transaction context
+   * @returns the number of entries inserted
+   */
+  virtual auto InsertEntries(const std::vector<std::pair<Tuple, RID>> &entries, Transaction *transaction) -> size_t {
+    size_t count = 0;
+    for (const auto &[key, rid] : entries) {
+      count += static_cast<size_t>(InsertEntry(key, rid, transaction));
+    }
+    return count;
+  }
+
   /**
    * Delete an index entry by key.
    * @param key The index key
@@ -176,6 +240,29 @@ class Index {
    */
   virtual void ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) = 0;
 
+  ///////////////////////////////////////////////////////////////////
+  // Ordered Scan
+  ///////////////////////////////////////////////////////////////////
+
+  /**
+   * Start a scan over all entries in key order.
+   * @return A cursor at the first entry, or nullptr if the index keeps no key order
+   */
+  virtual auto MakeCursor() -> std::unique_ptr<IndexCursor> { return nullptr; }
+
+  /**
+   * Start a scan over the entries whose search columns equal `key`.
+   * @param key The lookup key, laid out by `GetSearchKeySchema()`
+   * @return A cursor at the first matching entry, or nullptr if the index keeps no key order
+   */
+  virtual auto MakeCursor([[maybe_unused]] const Tuple &key) -> std::unique_ptr<IndexCursor> { return nullptr; }
+
+  /**
+   * @return whether the key columns of every entry can be read back through `IndexCursor::GetKeyValue`, so that a scan
+   * needs no table access for them
+   */
+  virtual auto CanReturnKeys() const -> bool { return false; }
+
  private:
   /** The Index structure owns its metadata */
   std::unique_ptr<IndexMetadata> metadata_;
@@ -0,0 +1,243 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// memcmp_key.h
+//
+// Identification: src/include/storage/index/memcmp_key.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "catalog/schema.h"
+#include "common/macros.h"
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/**
+ * Order-preserving encoding of index keys.
+ *
+ * Every key column is written into a fixed-width, big-endian slot so that comparing two encoded keys with `memcmp`
+ * gives the same order as comparing the columns one by one:
+ *  - INTEGER / BIGINT: two's complement with the sign bit flipped
+ *  - DECIMAL: IEEE 754 bits, sign bit flipped for positives and all bits flipped for negatives
+ *  - VARCHAR(n): the characters zero-padded to n bytes, or cut to n bytes if longer
+ *
+ * NULLs are stored in-band by the type system (e.g. INT32_MIN), so they encode like any other value. A NULL VARCHAR
+ * encodes like the empty string.
+ *
+ * A B+ tree holds each key once, so it appends the RID of the entry to the columns: rows whose columns encode the same,
+ * e.g. duplicates or VARCHARs cut to the same prefix, are still kept as distinct entries, ordered by RID.
+ */
+class MemcmpKeyEncoder {
+ public:
+  /** The number of bytes an encoded RID takes */
+  static constexpr size_t RID_SIZE = 8;
+
+  /** @return whether a column of this type can be part of an encoded key */
+  static auto IsEncodable(TypeId type) -> bool {
+    return type == TypeId::INTEGER || type == TypeId::BIGINT || type == TypeId::DECIMAL || type == TypeId::VARCHAR;
+  }
+
+  /** @return the number of bytes the encoding of a key with this schema takes */
+  static auto EncodedSize(const Schema &key_schema) -> size_t {
+    size_t size = 0;
+    for (const auto &column : key_schema.GetColumns()) {
+      size += ColumnWidth(column);
+    }
+    return size;
+  }
+
+  /** Encodes the key tuple `key` laid out by `key_schema` into `data`, which has room for `size` bytes. */
+  static void Encode(const Tuple &key, const Schema &key_schema, char *data, size_t size) {
+    memset(data, 0, size);
+    size_t offset = 0;
+    for (uint32_t i = 0; i < key_schema.GetColumnCount(); i++) {
+      const auto &column = key_schema.GetColumn(i);
+      auto width = ColumnWidth(column);
+      BUSTUB_ASSERT(offset + width <= size, "key does not fit the key type");
+      auto value = key.GetValue(&key_schema, i);
+      switch (column.GetType()) {
+        case TypeId::INTEGER:
+          PutBigEndian(data + offset, static_cast<uint32_t>(value.GetAs<int32_t>()) ^ (1U << 31), width);
+          break;
+        case TypeId::BIGINT:
+          PutBigEndian(data + offset, static_cast<uint64_t>(value.GetAs<int64_t>()) ^ (1ULL << 63), width);
+          break;
+        case TypeId::DECIMAL: {
+          auto decimal = value.GetAs<double>();
+          uint64_t bits;
+          memcpy(&bits, &decimal, sizeof(bits));
+          bits = (bits >> 63) != 0 ? ~bits : bits ^ (1ULL << 63);
+          PutBigEndian(data + offset, bits, width);
+          break;
+        }
+        case TypeId::VARCHAR:
+          if (!value.IsNull() && value.GetLength() > 0) {
+            // the stored length counts the trailing '\0'
+            memcpy(data + offset, value.GetData(), std::min<size_t>(value.GetLength() - 1, width));
+          }
+          break;
+        default:
+          UNREACHABLE("type cannot be encoded into an index key");
+      }
+      offset += width;
+    }
+  }
+
+  /** Encodes `rid` into the `RID_SIZE` bytes at `data`, big-endian page id then slot, so that entries sort by RID. */
+  static void EncodeRID(RID rid, char *data) {
+    PutBigEndian(data, static_cast<uint32_t>(rid.GetPageId()), sizeof(uint32_t));
+    PutBigEndian(data + sizeof(uint32_t), rid.GetSlotNum(), sizeof(uint32_t));
+  }
+
+  /** Decodes the `column_idx`-th column of a key encoded with `key_schema`. */
+  static auto Decode(const char *data, const Schema &key_schema, uint32_t column_idx) -> Value {
+    size_t offset = 0;
+    for (uint32_t i = 0; i < column_idx; i++) {
+      offset += ColumnWidth(key_schema.GetColumn(i));
+    }
+    const auto &column = key_schema.GetColumn(column_idx);
+    auto width = ColumnWidth(column);
+    auto bits = column.GetType() == TypeId::VARCHAR ? 0 : GetBigEndian(data + offset, width);
+    switch (column.GetType()) {
+      case TypeId::INTEGER:
+        return {TypeId::INTEGER, static_cast<int32_t>(static_cast<uint32_t>(bits) ^ (1U << 31))};
+      case TypeId::BIGINT:
+        return {TypeId::BIGINT, static_cast<int64_t>(bits ^ (1ULL << 63))};
+      case TypeId::DECIMAL: {
+        bits = (bits >> 63) != 0 ? bits ^ (1ULL << 63) : ~bits;
+        double decimal;
+        memcpy(&decimal, &bits, sizeof(decimal));
+        return {TypeId::DECIMAL, decimal};
+      }
+      case TypeId::VARCHAR:
+        return {TypeId::VARCHAR, std::string(data + offset, strnlen(data + offset, width))};
+      default:
+        UNREACHABLE("type cannot be decoded from an index key");
+    }
+  }
+
+  /** @return whether every column of `key` comes back unchanged from `Decode`, i.e. no VARCHAR is NULL or truncated */
+  static auto RoundTrips(const Tuple &key, const Schema &key_schema) -> bool {
+    for (uint32_t i = 0; i < key_schema.GetColumnCount(); i++) {
+      const auto &column = key_schema.GetColumn(i);
+      if (column.GetType() != TypeId::VARCHAR) {
+        continue;
+      }
+      auto value = key.GetValue(&key_schema, i);
+      if (value.IsNull() || value.GetLength() - 1 > column.GetLength()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  static auto ColumnWidth(const Column &column) -> size_t {
+    return column.GetType() == TypeId::VARCHAR ? column.GetLength() : column.GetFixedLength();
+  }
+
+  static void PutBigEndian(char *data, uint64_t value, size_t width) {
+    for (size_t i = 0; i < width; i++) {
+      data[width - 1 - i] = static_cast<char>(value & 0xff);
+      value >>= 8;
+    }
+  }
+
+  static auto GetBigEndian(const char *data, size_t width) -> uint64_t {
+    uint64_t value = 0;
+    for (size_t i = 0; i < width; i++) {
+      value = (value << 8) | static_cast<uint8_t>(data[i]);
+    }
+    return value;
+  }
+};
+
+/**
+ * Index key holding an order-preserving encoding of its columns, see `MemcmpKeyEncoder`.
+ */
+template <size_t KeySize>
+class MemcmpKey {
+ public:
+  inline void SetFromKey(const Tuple &tuple, const Schema &key_schema) {
+    MemcmpKeyEncoder::Encode(tuple, key_schema, data_, KeySize);
+  }
+
+  /** Writes `rid` after the `offset` bytes the columns are encoded into, which makes the key of each entry unique. */
+  inline void SetRID(size_t offset, RID rid) {
+    BUSTUB_ASSERT(offset + MemcmpKeyEncoder::RID_SIZE <= KeySize, "RID does not fit the key type");
+    MemcmpKeyEncoder::EncodeRID(rid, data_ + offset);
+  }
+
+  inline auto ToValue(Schema *schema, uint32_t column_idx) const -> Value {
+    return MemcmpKeyEncoder::Decode(data_, *schema, column_idx);
+  }
+
+  /** @return whether `ToValue` gives back the columns of `tuple` exactly */
+  static auto CanDecode(const Tuple &tuple, const Schema &key_schema) -> bool {
+    return MemcmpKeyEncoder::RoundTrips(tuple, key_schema);
+  }
+
+  // NOTE: for test purpose only
+  inline void SetFromInteger(int64_t key) {
+    memset(data_, 0, KeySize);
+    auto bits = static_cast<uint64_t>(key) ^ (1ULL << 63);
+    for (size_t i = 0; i < sizeof(int64_t) && i < KeySize; i++) {
+      data_[i] = static_cast<char>(bits >> (8 * (sizeof(int64_t) - 1 - i)));
+    }
+  }
+
+  // NOTE: for test purpose only
+  // interpret the first 8 bytes as written by SetFromInteger
+  inline auto ToString() const -> int64_t {
+    uint64_t bits = 0;
+    for (size_t i = 0; i < sizeof(int64_t) && i < KeySize; i++) {
+      bits = (bits << 8) | static_cast<uint8_t>(data_[i]);
+    }
+    return static_cast<int64_t>(bits ^ (1ULL << 63));
+  }
+
+  // NOTE: for test purpose only
+  friend auto operator<<(std::ostream &os, const MemcmpKey &key) -> std::ostream & {
+    os << key.ToString();
+    return os;
+  }
+
+  char data_[KeySize];
+};
+
+/** Whether an index key type is a `MemcmpKey`, whose entries a B+ tree index makes unique with their RID */
+template <typename KeyType>
+struct IsMemcmpKey : std::false_type {};
+
+template <size_t KeySize>
+struct IsMemcmpKey<MemcmpKey<KeySize>> : std::true_type {};
+
+/**
+ * Compares two `MemcmpKey`s bytewise; no column is ever decoded.
+ */
+template <size_t KeySize>
+class MemcmpComparator {
+ public:
+  inline auto operator()(const MemcmpKey<KeySize> &lhs, const MemcmpKey<KeySize> &rhs) const -> int {
+    int cmp = memcmp(lhs.data_, rhs.data_, KeySize);
+    return cmp < 0 ? -1 : (cmp > 0 ? 1 : 0);
+  }
+
+  // the key schema is baked into the encoding, it is only taken to match the other comparators
+  explicit MemcmpComparator([[maybe_unused]] Schema *key_schema) {}
+};
+
+}  // namespace bustub
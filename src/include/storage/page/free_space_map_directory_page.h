@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map_directory_page.h
+//
+// Identification: src/include/storage/page/free_space_map_directory_page.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "common/config.h"
+
+namespace bustub {
+
+static constexpr uint64_t FSM_DIRECTORY_PAGE_HEADER_SIZE = 8;
+/** The number of free-space map pages one directory page keeps track of */
+static constexpr uint32_t FSM_DIRECTORY_PAGE_CAPACITY =
+    (BUSTUB_PAGE_SIZE - FSM_DIRECTORY_PAGE_HEADER_SIZE) / (2 * sizeof(page_id_t) + sizeof(uint8_t));
+
+/**
+ * Free-space map directory page, summarizing a set of free-space map pages.
+ *
+ * Every free-space map page is kept as the first page id of its range, its own page id, and the largest bucket of
+ * the range, so that a lookup only reads a free-space map page that surely has a page with enough room.
+ *
+ * Header format (size in bytes):
+ * ------------------------------------
+ * | NextPageId (4) | Size (4) |
+ * ------------------------------------
+ * Followed by the first page ids of the ranges, the page ids of their map pages, then their largest buckets:
+ * -------------------------------------------------------------------------------------------------
+ * | FirstPageId_0 (4) | ... | MapPageId_0 (4) | ... | MaxBucket_0 (1) | ... |
+ * -------------------------------------------------------------------------------------------------
+ */
+class FreeSpaceMapDirectoryPage {
+ public:
+  /** Initialize an empty directory page. */
+  void Init();
+
+  /** @return the page id of the next directory page */
+  auto GetNextPageId() const -> page_id_t { return next_page_id_; }
+
+  /** Set the page id of the next directory page. */
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  /** @return the number of entries in this page */
+  auto GetSize() const -> uint32_t { return size_; }
+
+  /** @return whether another entry can be appended */
+  auto IsFull() const -> bool { return size_ == FSM_DIRECTORY_PAGE_CAPACITY; }
+
+  /** @return the index of the entry of the range starting at `first_page_id`, if any */
+  auto FindRange(page_id_t first_page_id) const -> std::optional<uint32_t>;
+
+  /** @return the page id of the free-space map page of the `index`-th entry */
+  auto MapPageIdAt(uint32_t index) const -> page_id_t;
+
+  /** @return the largest bucket of the `index`-th entry */
+  auto MaxBucketAt(uint32_t index) const -> uint8_t;
+
+  /** Set the largest bucket of the `index`-th entry. */
+  void SetMaxBucket(uint32_t index, uint8_t bucket);
+
+  /**
+   * Append an entry for a free-space map page.
+   * @return the index of the new entry
+   */
+  auto Append(page_id_t first_page_id, page_id_t map_page_id, uint8_t max_bucket) -> uint32_t;
+
+  /** @return the index of an entry whose largest bucket is `bucket` or above, if any */
+  auto FindMaxBucketAtLeast(uint8_t bucket) const -> std::optional<uint32_t>;
+
+ private:
+  page_id_t next_page_id_;
+  uint32_t size_;
+  page_id_t first_page_ids_[FSM_DIRECTORY_PAGE_CAPACITY];
+  page_id_t map_page_ids_[FSM_DIRECTORY_PAGE_CAPACITY];
+  uint8_t max_buckets_[FSM_DIRECTORY_PAGE_CAPACITY];
+};
+
+static_assert(sizeof(FreeSpaceMapDirectoryPage) <= BUSTUB_PAGE_SIZE);
+
+}  // namespace bustub
@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map_page.h
+//
+// Identification: src/include/storage/page/free_space_map_page.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include "common/config.h"
+
+namespace bustub {
+
+/** The free space of a table page is rounded down to a multiple of this many bytes */
+static constexpr uint32_t FSM_BUCKET_BYTES = 64;
+static constexpr uint32_t FSM_NUM_BUCKETS = BUSTUB_PAGE_SIZE / FSM_BUCKET_BYTES;
+static constexpr uint64_t FSM_PAGE_HEADER_SIZE = 4 + FSM_NUM_BUCKETS * sizeof(uint16_t);
+/** The number of consecutive page ids one free-space map page keeps track of */
+static constexpr uint32_t FSM_PAGE_CAPACITY = BUSTUB_PAGE_SIZE - FSM_PAGE_HEADER_SIZE;
+
+/**
+ * Free-space map page, recording how much room each page of a range of page ids has left.
+ *
+ * The page covers the `FSM_PAGE_CAPACITY` page ids from its first one, and keeps a bucket for each, the bucket `b`
+ * meaning the page has at least `b * FSM_BUCKET_BYTES` bytes free. A page id that is not a page of the table is left
+ * in bucket 0, like a full page, as no insert ever looks for less than one bucket. The header counts the page ids of
+ * each bucket, so that the largest bucket is known without looking at the entries.
+ *
+ * Header format (size in bytes):
+ * ---------------------------------------------------------------------------
+ * | FirstPageId (4) | BucketCount_0 (2) | ... | BucketCount_63 (2) |
+ * ---------------------------------------------------------------------------
+ * Followed by the bucket of each page id of the range:
+ * -----------------------------------------------
+ * | Bucket_0 (1) | Bucket_1 (1) | ... |
+ * -----------------------------------------------
+ */
+class FreeSpaceMapPage {
+ public:
+  /** Initialize a free-space map page for the range starting at `first_page_id`, every page id in bucket 0. */
+  void Init(page_id_t first_page_id);
+
+  /** @return the first page id of the range of this page */
+  auto GetFirstPageId() const -> page_id_t { return first_page_id_; }
+
+  /** @return the first page id of the range a free-space map page covering `page_id` starts at */
+  static auto RangeOf(page_id_t page_id) -> page_id_t {
+    return page_id - page_id % static_cast<page_id_t>(FSM_PAGE_CAPACITY);
+  }
+
+  /** @return the bucket of `page_id`, which must be in the range of this page */
+  auto GetBucket(page_id_t page_id) const -> uint8_t;
+
+  /** Set the bucket of `page_id`, which must be in the range of this page. */
+  void SetBucket(page_id_t page_id, uint8_t bucket);
+
+  /** @return the largest bucket of any page id in the range */
+  auto GetMaxBucket() const -> uint8_t;
+
+  /** @return a page id in bucket `bucket` or above, if any */
+  auto FindBucketAtLeast(uint8_t bucket) const -> std::optional<page_id_t>;
+
+ private:
+  page_id_t first_page_id_;
+  uint16_t bucket_counts_[FSM_NUM_BUCKETS];
+  uint8_t buckets_[FSM_PAGE_CAPACITY];
+};
+
+static_assert(sizeof(FreeSpaceMapPage) <= BUSTUB_PAGE_SIZE);
+
+}  // namespace bustub
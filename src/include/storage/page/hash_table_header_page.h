@@ -17,11 +17,15 @@
 #include <cstdlib>
 #include <string>
 
+#include "common/config.h"
 #include "storage/index/generic_key.h"
 #include "storage/page/hash_table_page_defs.h"
 
 namespace bustub {
 
+/** The number of block page ids that fit in a header page, after its fixed fields */
+static constexpr size_t HEADER_PAGE_BLOCK_CAPACITY = (BUSTUB_PAGE_SIZE - 4 * sizeof(size_t)) / sizeof(page_id_t);
+
 /**
  *
  * Header Page for linear probing hash table.
@@ -82,20 +86,20 @@ class HashTableHeaderPage {
    * @param index the index of the block
    * @return the page_id for the block.
    */
-  auto GetBlockPageId(size_t index) -> page_id_t;
+  auto GetBlockPageId(size_t index) const -> page_id_t;
 
   /**
    * @return the number of blocks currently stored in the header page
    */
-  auto NumBlocks() -> size_t;
+  auto NumBlocks() const -> size_t;
 
  private:
-  __attribute__((unused)) lsn_t lsn_;
-  __attribute__((unused)) size_t size_;
-  __attribute__((unused)) page_id_t page_id_;
-  __attribute__((unused)) size_t next_ind_;
+  lsn_t lsn_;
+  size_t size_;
+  page_id_t page_id_;
+  size_t next_ind_;
   // Flexible array member for page data.
-  __attribute__((unused)) page_id_t block_page_ids_[1];
+  page_id_t block_page_ids_[1];
 };
 
 }  // namespace bustub
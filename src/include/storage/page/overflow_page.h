@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// overflow_page.h
+//
+// Identification: src/include/storage/page/overflow_page.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "common/config.h"
+
+namespace bustub {
+
+static constexpr uint64_t OVERFLOW_PAGE_HEADER_SIZE = 8;
+
+/** Where a value stored out of line is: the first page of its chain, and its size */
+struct OutOfLinePointer {
+  page_id_t first_page_id_;
+  uint32_t size_;
+};
+
+/**
+ * Overflow page format: one chunk of a value stored out of line, chained to the page of the next chunk.
+ *
+ *  ----------------------------------------------------
+ *  | NextPageId (4) | Size (4) | ... CHUNK DATA ...   |
+ *  ----------------------------------------------------
+ */
+class OverflowPage {
+ public:
+  /** The largest chunk a page holds */
+  static constexpr uint32_t CAPACITY = BUSTUB_PAGE_SIZE - OVERFLOW_PAGE_HEADER_SIZE;
+
+  /** Initialize the page with a chunk of `size` bytes from `data`, the last one of its chain. */
+  void Init(const char *data, uint32_t size) {
+    next_page_id_ = INVALID_PAGE_ID;
+    size_ = size;
+    memcpy(data_, data, size);
+  }
+
+  /** @return the page ID of the next chunk, or INVALID_PAGE_ID for the last one */
+  auto GetNextPageId() const -> page_id_t { return next_page_id_; }
+
+  /** Set the page id of the next chunk. */
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  /** @return the size of the chunk */
+  auto GetSize() const -> uint32_t { return size_; }
+
+  /** @return the data of the chunk */
+  auto GetData() const -> const char * { return data_; }
+
+ private:
+  page_id_t next_page_id_;
+  uint32_t size_;
+  char data_[0];
+};
+
+static_assert(sizeof(OverflowPage) == OVERFLOW_PAGE_HEADER_SIZE);
+
+}  // namespace bustub
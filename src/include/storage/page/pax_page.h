@@ -0,0 +1,124 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// pax_page.h
+//
+// Identification: src/include/storage/page/pax_page.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/config.h"
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+static constexpr uint64_t PAX_PAGE_HEADER_SIZE = 16;
+
+/**
+ * PAX (partition attributes across) page format: the tuples of a page are split by column, the values of each column
+ * kept together in a minipage, so that a scan of a few columns only reads their minipages.
+ *
+ *  ------------------------------------------------------------------------------------------------
+ *  | HEADER | TupleMeta_0 | ... | MINIPAGE 0 | ... | MINIPAGE n | ... FREE SPACE ... | VARCHAR DATA |
+ *  ------------------------------------------------------------------------------------------------
+ *                                                                                   ^
+ *                                                                                   varchar pointer
+ *
+ *  Header format (size in bytes):
+ *  -----------------------------------------------------------------------------------------------------
+ *  | NextPageId (4) | NumTuples (2) | NumDeletedTuples (2) | Capacity (2) | VarcharPointer (2) | Reserved (4) |
+ *  -----------------------------------------------------------------------------------------------------
+ *
+ * The header starts like the one of `TablePage`, so that the page chain and the number of tuples read the same in
+ * both formats.
+ *
+ * A page is made for `Capacity` tuples, and every minipage has room for that many values: a fixed-length column keeps
+ * its values inline, a VARCHAR column the 2-byte offset of each value in the varchar data, which grows from the end of
+ * the page. The page is full once either runs out. Tuples are never moved, so deleted ones keep their room.
+ */
+class PaxPage {
+ public:
+  /**
+   * @return the number of tuples a page of `schema` is made for, assuming a VARCHAR value takes at most
+   * `PAX_VARCHAR_ESTIMATE` bytes on average
+   */
+  static auto Capacity(const Schema &schema) -> uint16_t;
+
+  /** @return whether an empty page made for `capacity` tuples can take `tuple` */
+  static auto FitsEmptyPage(const Schema &schema, uint16_t capacity, const Tuple &tuple) -> bool;
+
+  /** Initialize an empty page, made for `capacity` tuples. */
+  void Init(uint16_t capacity);
+
+  /** @return number of tuples in this page */
+  auto GetNumTuples() const -> uint32_t { return num_tuples_; }
+
+  /** @return the page ID of the next table page */
+  auto GetNextPageId() const -> page_id_t { return next_page_id_; }
+
+  /** Set the page id of the next page in the table. */
+  void SetNextPageId(page_id_t next_page_id) { next_page_id_ = next_page_id; }
+
+  /**
+   * Insert a tuple, splitting it into the minipages.
+   * @return the slot of the tuple, or std::nullopt if the page is full
+   */
+  auto InsertTuple(const Schema &schema, const TupleMeta &meta, const Tuple &tuple) -> std::optional<uint16_t>;
+
+  /** Update a tuple meta. */
+  void UpdateTupleMeta(const TupleMeta &meta, const RID &rid);
+
+  /** Read a tuple meta. */
+  auto GetTupleMeta(const RID &rid) const -> TupleMeta;
+
+  /** Read a tuple, gathering its values from every minipage. */
+  auto GetTuple(const Schema &schema, const RID &rid) const -> std::pair<TupleMeta, Tuple>;
+
+  /**
+   * Read one column of every tuple in the page from its minipage alone.
+   * @param count the number of leading tuples to read
+   * @param[out] values the values, appended in slot order
+   */
+  void GetColumn(const Schema &schema, uint32_t column_idx, uint32_t count, std::vector<Value> *values) const;
+
+ private:
+  /** The number of bytes a VARCHAR value is assumed to take when sizing a page */
+  static constexpr uint32_t PAX_VARCHAR_ESTIMATE = 32;
+
+  /** @return the size of an entry in the minipage of `column` */
+  static auto EntrySize(const Column &column) -> uint32_t;
+
+  /** @return the offset of the minipage of each column, followed by the end of the last one */
+  static auto MinipageOffsets(const Schema &schema, uint16_t capacity) -> std::vector<uint32_t>;
+
+  /** @return the bytes of varchar data `tuple` needs */
+  static auto VarcharSize(const Schema &schema, const Tuple &tuple) -> uint32_t;
+
+  auto ReadValue(const Column &column, uint32_t minipage_offset, uint32_t slot) const -> Value;
+
+  char page_start_[0];
+  page_id_t next_page_id_;
+  uint16_t num_tuples_;
+  uint16_t num_deleted_tuples_;
+  uint16_t capacity_;
+  uint16_t varchar_pointer_;
+  uint32_t reserved_;
+  TupleMeta tuple_metas_[0];
+};
+
+static_assert(sizeof(PaxPage) == PAX_PAGE_HEADER_SIZE);
+
+}  // namespace bustub
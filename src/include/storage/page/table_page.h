@@ -27,7 +27,7 @@
 
 namespace bustub {
 
-static constexpr uint64_t TABLE_PAGE_HEADER_SIZE = 8;
+static constexpr uint64_t TABLE_PAGE_HEADER_SIZE = 16;
 
 /**
  * Slotted page format:
@@ -39,7 +39,10 @@ static constexpr uint64_t TABLE_PAGE_HEADER_SIZE = 8;
  *
  *  Header format (size in bytes):
  *  ----------------------------------------------------------------------------
- *  | NextPageId (4)| NumTuples(2) | NumDeletedTuples(2) |
+ *  | NextPageId (4)| NumTuples(2) | NumDeletedTuples(2) | FreeSpacePointer(2) |
+ *  ----------------------------------------------------------------------------
+ *  ----------------------------------------------------------------------------
+ *  | DeletedBytes(2) | NumFreeSlots(2) | Reserved(2) |
  *  ----------------------------------------------------------------------------
  *  ----------------------------------------------------------------
  *  | Tuple_1 offset+size (4) | Tuple_2 offset+size (4) | ... |
@@ -47,6 +50,10 @@ static constexpr uint64_t TABLE_PAGE_HEADER_SIZE = 8;
  *
  * Tuple format:
  * | meta | data |
+ *
+ * The bytes of deleted tuples stay in place until `Compact` packs the live tuples together at the end of the page.
+ * The slots of the compacted tuples are then free, and later inserts take them before growing the slot array, so the
+ * RID of a live tuple never changes.
  */
 
 class TablePage {
@@ -68,6 +75,19 @@ class TablePage {
   /** Get the next offset to insert, return nullopt if this tuple cannot fit in this page */
   auto GetNextTupleOffset(const TupleMeta &meta, const Tuple &tuple) const -> std::optional<uint16_t>;
 
+  /** @return the number of bytes an insert can use without compacting, the deleted tuples still taking theirs */
+  auto GetFreeSpace() const -> size_t;
+
+  /** @return the number of free bytes a page needs to take `tuple` */
+  static auto RequiredSpace(const Tuple &tuple) -> size_t { return tuple.GetLength() + TUPLE_INFO_SIZE; }
+
+  /**
+   * Move the live tuples together at the end of the page, giving back the bytes of the deleted ones. A deleted tuple
+   * must not be revived once it is compacted.
+   * @return whether any bytes were given back
+   */
+  auto Compact() -> bool;
+
   /**
    * Insert a tuple into the table.
    * @param tuple tuple to insert
@@ -85,6 +105,11 @@ class TablePage {
    */
   auto GetTuple(const RID &rid) const -> std::pair<TupleMeta, Tuple>;
 
+  /**
+   * Read a tuple from a table in place, without copying it. The view is only valid while the page stays latched.
+   */
+  auto GetTupleView(const RID &rid) const -> std::pair<TupleMeta, TupleView>;
+
   /**
    * Read a tuple meta from a table.
    */
@@ -99,10 +124,18 @@ class TablePage {
 
  private:
   using TupleInfo = std::tuple<uint16_t, uint16_t, TupleMeta>;
+
+  /** Count a tuple of `size` bytes in or out of the deleted ones, as its meta goes from `old_meta` to `meta`. */
+  void AccountDelete(const TupleMeta &old_meta, const TupleMeta &meta, uint16_t size);
+
   char page_start_[0];
   page_id_t next_page_id_;
   uint16_t num_tuples_;
   uint16_t num_deleted_tuples_;
+  uint16_t free_space_pointer_;
+  uint16_t deleted_bytes_;
+  uint16_t num_free_slots_;
+  uint16_t reserved_;
   TupleInfo tuple_info_[0];
 
   static constexpr size_t TUPLE_INFO_SIZE = 16;
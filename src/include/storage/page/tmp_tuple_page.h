@@ -1,16 +1,19 @@
 #pragma once
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include "storage/page/page.h"
 #include "storage/table/tmp_tuple.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
 
-// To pass the test cases for this class, you must follow the existing TmpTuplePage format and implement the
-// existing functions exactly as they are! It may be helpful to look at TablePage.
-// Remember that this task is optional, you get full credit if you finish the next task.
-
 /**
+ * A TmpTuplePage holds tuples an executor spills to disk while it runs, e.g. a partition of a hash join that does not
+ * fit in the memory budget of the query. It is never logged.
+ *
  * TmpTuplePage format:
  *
  * Sizes are in bytes.
@@ -22,15 +25,55 @@ class TmpTuplePage : public Page {
  public:
   void Init(page_id_t page_id, uint32_t page_size) {
     memcpy(GetData(), &page_id, sizeof(page_id_t));
-    memcpy(GetData() + sizeof(page_id_t), &page_size, sizeof(uint32_t));
+    SetFreeSpacePointer(page_size);
+  }
+
+  auto GetTablePageId() -> page_id_t { return *reinterpret_cast<page_id_t *>(GetData()); }
+
+  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool {
+    auto size = sizeof(uint32_t) + tuple.GetLength();
+    auto free_space_pointer = GetFreeSpacePointer();
+    if (free_space_pointer < SIZE_HEADER + size) {
+      return false;
+    }
+    free_space_pointer -= size;
+    tuple.SerializeTo(GetData() + free_space_pointer);
+    SetFreeSpacePointer(free_space_pointer);
+    *out = TmpTuple(GetTablePageId(), free_space_pointer);
+    return true;
   }
 
-  auto GetTablePageId() -> page_id_t { return INVALID_PAGE_ID; }
+  /**
+   * Read back the tuples of a page, in the order they were inserted.
+   * @param page_size the size the page was initialized with
+   * @param[out] tuples the tuples of the page, appended to it
+   */
+  void GetTuples(uint32_t page_size, std::vector<Tuple> *tuples) {
+    // the last tuple inserted is at the free space pointer, and each tuple is right below the one inserted before it
+    auto first = tuples->size();
+    for (auto offset = GetFreeSpacePointer(); offset < page_size;) {
+      tuples->emplace_back().DeserializeFrom(GetData() + offset);
+      offset += sizeof(uint32_t) + tuples->back().GetLength();
+    }
+    std::reverse(tuples->begin() + first, tuples->end());
+  }
 
-  auto Insert(const Tuple &tuple, TmpTuple *out) -> bool { return false; }
+  /** @return the largest tuple a page of `page_size` holds */
+  static constexpr auto MaxTupleSize(uint32_t page_size) -> uint32_t {
+    return page_size - SIZE_HEADER - sizeof(uint32_t);
+  }
 
  private:
   static_assert(sizeof(page_id_t) == 4);
+
+  static constexpr size_t OFFSET_FREE_SPACE = 8;
+  static constexpr size_t SIZE_HEADER = 12;
+
+  auto GetFreeSpacePointer() -> uint32_t { return *reinterpret_cast<uint32_t *>(GetData() + OFFSET_FREE_SPACE); }
+
+  void SetFreeSpacePointer(uint32_t free_space_pointer) {
+    memcpy(GetData() + OFFSET_FREE_SPACE, &free_space_pointer, sizeof(uint32_t));
+  }
 };
 
 }  // namespace bustub
@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map.h
+//
+// Identification: src/include/storage/table/free_space_map.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <mutex>  // NOLINT
+#include <optional>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/config.h"
+#include "storage/page/free_space_map_directory_page.h"
+#include "storage/page/free_space_map_page.h"
+#include "storage/page/page_guard.h"
+
+namespace bustub {
+
+/**
+ * FreeSpaceMap keeps how many bytes each page of a table heap has left, so that an insert can find a page with room
+ * without visiting the table.
+ *
+ * Free space is kept in buckets of `FSM_BUCKET_BYTES`, rounded down: a page returned by `FindPage(size)` is
+ * guaranteed to have `size` bytes free as of its last `Update`. The buckets live in `FreeSpaceMapPage`s, each covering
+ * a range of page ids, and a chain of `FreeSpaceMapDirectoryPage`s keeps the largest bucket of each. An update or a
+ * lookup thus reads the directory and at most one map page, as long as the table spans fewer ranges than one
+ * directory page holds.
+ */
+class FreeSpaceMap {
+ public:
+  /**
+   * Create an empty free-space map.
+   * @param bpm the buffer pool manager holding the map pages
+   */
+  explicit FreeSpaceMap(BufferPoolManager *bpm);
+
+  /** @return the id of the first directory page of the map */
+  auto GetFirstPageId() const -> page_id_t { return first_page_id_; }
+
+  /**
+   * Record how many bytes are free in a table page, adding the page to the map if it is not there yet.
+   * @param page_id the table page
+   * @param free_bytes the free bytes in that page
+   */
+  void Update(page_id_t page_id, size_t free_bytes);
+
+  /** Forget a table page, e.g. once it has been released. */
+  void Remove(page_id_t page_id);
+
+  /**
+   * Find a page with enough room.
+   * @param size the number of bytes needed
+   * @return a table page with at least `size` bytes free, if any
+   */
+  auto FindPage(size_t size) -> std::optional<page_id_t>;
+
+ private:
+  static auto BucketOf(size_t free_bytes) -> uint8_t;
+
+  /** Allocate a page, latched for writing. */
+  auto NewMapPage(page_id_t *page_id) -> WritePageGuard;
+
+  /** Set the bucket of a table page, adding a map page for its range if `create` and there is none yet. */
+  void SetBucket(page_id_t page_id, uint8_t bucket, bool create);
+
+  BufferPoolManager *bpm_;
+  page_id_t first_page_id_{INVALID_PAGE_ID};
+
+  std::mutex latch_;
+};
+
+}  // namespace bustub
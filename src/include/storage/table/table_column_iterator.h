@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_column_iterator.h
+//
+// Identification: src/include/storage/table/table_column_iterator.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "common/config.h"
+#include "common/macros.h"
+#include "common/rid.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+class TableHeap;
+
+/**
+ * TableColumnIterator scans some columns of a PAX table. Each page is read once, taking the tuple metas and the
+ * minipages of the scanned columns only, so the other columns are never touched.
+ */
+class TableColumnIterator {
+ public:
+  DISALLOW_COPY(TableColumnIterator);
+
+  /**
+   * @param page_filter if set, the pages it returns false for are skipped without reading their tuples
+   */
+  TableColumnIterator(TableHeap *table_heap, std::vector<uint32_t> column_ids, RID stop_at_rid,
+                      std::function<bool(page_id_t)> page_filter = nullptr);
+  TableColumnIterator(TableColumnIterator &&) = default;
+
+  ~TableColumnIterator() = default;
+
+  auto GetRID() const -> RID { return RID{page_id_, slot_}; }
+
+  auto GetTupleMeta() const -> const TupleMeta & { return metas_[slot_]; }
+
+  /** @return the value of the `i`-th scanned column of the current tuple */
+  auto GetValue(size_t i) const -> const Value & { return columns_[i][slot_]; }
+
+  auto IsEnd() const -> bool { return page_id_ == INVALID_PAGE_ID; }
+
+  auto operator++() -> TableColumnIterator &;
+
+ private:
+  /** Read the page `page_id`, or the first page with tuples after it. */
+  void LoadPage(page_id_t page_id);
+
+  TableHeap *table_heap_;
+  std::vector<uint32_t> column_ids_;
+  /** As in `TableIterator`, the scan stops at the tuples that were there when it began */
+  RID stop_at_rid_;
+  std::function<bool(page_id_t)> page_filter_;
+
+  page_id_t page_id_{INVALID_PAGE_ID};
+  page_id_t next_page_id_{INVALID_PAGE_ID};
+  uint32_t slot_{0};
+  /** The metas of the tuples of the current page, and the values of each scanned column */
+  std::vector<TupleMeta> metas_;
+  std::vector<std::vector<Value>> columns_;
+};
+
+}  // namespace bustub
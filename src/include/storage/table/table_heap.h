@@ -12,27 +12,56 @@
 
 #pragma once
 
+#include <array>
+#include <functional>
+#include <memory>
 #include <mutex>  // NOLINT
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include "buffer/buffer_pool_manager.h"
+#include "catalog/schema.h"
 #include "common/config.h"
+#include "common/enums/table_layout.h"
 #include "concurrency/lock_manager.h"
 #include "concurrency/transaction.h"
 #include "recovery/log_manager.h"
 #include "storage/page/table_page.h"
+#include "storage/table/free_space_map.h"
+#include "storage/table/table_column_iterator.h"
 #include "storage/table/table_iterator.h"
 #include "storage/table/tuple.h"
+#include "storage/table/zone_map.h"
 
 namespace bustub {
 
+class TablePage;
+
+/** A VARCHAR value longer than this, in bytes, is stored out of line by a table of the row layout */
+static constexpr uint32_t OUT_OF_LINE_THRESHOLD = BUSTUB_PAGE_SIZE / 16;
+
+/** The number of leading bytes of a value stored out of line that the tuple keeps */
+static constexpr uint32_t OUT_OF_LINE_PREFIX_SIZE = 32;
+
 /**
  * TableHeap represents a physical table on disk.
  * This is just a doubly-linked list of pages.
+ *
+ * The pages are `TablePage`s, or `PaxPage`s for a table with the PAX layout. A PAX table only appends to its last page:
+ * it keeps no free-space map and is not vacuumed.
+ *
+ * A table heap made with a schema also keeps a zone map of its pages, widened by every insert.
+ *
+ * A table of the row layout made with a schema stores large VARCHAR values out of line: each value longer than
+ * `OUT_OF_LINE_THRESHOLD` goes to a chain of overflow pages, and the tuple only keeps its first
+ * `OUT_OF_LINE_PREFIX_SIZE` bytes and the first page of the chain. A tuple read from the table has them read back in,
+ * except for the columns a scan was told it does not read, so that such a scan never touches the overflow pages. The
+ * overflow pages of a deleted tuple are released when its page is compacted.
  */
 class TableHeap {
   friend class TableIterator;
+  friend class TableColumnIterator;
 
  public:
   ~TableHeap() = default;
@@ -44,8 +73,26 @@ class TableHeap {
    */
   explicit TableHeap(BufferPoolManager *bpm);
 
+  /**
+   * Create a table heap whose pages use the given layout.
+   * @param buffer_pool_manager the buffer pool manager
+   * @param layout the page layout
+   * @param schema the schema of the tuples, which a PAX page needs to split them by column and the zone map to
+   * summarize them
+   */
+  TableHeap(BufferPoolManager *bpm, TableLayout layout, const Schema &schema);
+
+  /** @return the page layout of this table */
+  auto GetLayout() const -> TableLayout { return layout_; }
+
+  /** @return the zone map of this table, or nullptr if it was made without a schema */
+  auto GetZoneMap() const -> const ZoneMap * { return zone_map_.get(); }
+
   /**
    * Insert a tuple into the table. If the tuple is too large (>= page_size), return std::nullopt.
+   *
+   * Each thread inserts into its own target page while it has room, then into any page the free-space map finds room
+   * in, and only then into a new page, appended to the table once it holds the tuple.
    * @param meta tuple meta
    * @param tuple tuple to insert
    * @return rid of the inserted tuple
@@ -53,6 +100,15 @@ class TableHeap {
   auto InsertTuple(const TupleMeta &meta, const Tuple &tuple, LockManager *lock_mgr = nullptr,
                    Transaction *txn = nullptr, table_oid_t oid = 0) -> std::optional<RID>;
 
+  /**
+   * Insert many tuples at once. Tuples that fill more than a page are laid out page by page in local memory, each page
+   * copied into the buffer pool once full, and the new pages are linked to the table in one step.
+   * @param meta tuple meta, shared by all tuples
+   * @param tuples tuples to insert
+   * @return rids of the inserted tuples, in the order of `tuples`
+   */
+  auto InsertTuples(const TupleMeta &meta, const std::vector<Tuple> &tuples) -> std::vector<RID>;
+
   /**
    * Insert a tuple into the table. If the tuple is too large (>= page_size), return false.
    * @param meta new tuple meta
@@ -67,6 +123,13 @@ class TableHeap {
    */
   auto GetTuple(RID rid) -> std::pair<TupleMeta, Tuple>;
 
+  /**
+   * Read several tuples of one page, fetching the page only once.
+   * @param rids rids of the tuples to read, all on the same page
+   * @param[out] tuples the meta and tuple of each rid, appended in order
+   */
+  void GetTuples(const std::vector<RID> &rids, std::vector<std::pair<TupleMeta, Tuple>> *tuples);
+
   /**
    * Read a tuple meta from the table. Note: if you want to get tuple and meta together, use `GetTuple` insead
    * to ensure atomicity.
@@ -81,9 +144,34 @@ class TableHeap {
   /** @return the iterator of this table, use this for project 4 except updates */
   auto MakeEagerIterator() -> TableIterator;
 
+  /**
+   * Split the table into morsels, ranges of consecutive pages that can be scanned apart, e.g. by different threads.
+   * Together they scan what `MakeIterator` would.
+   * @param pages_per_morsel the number of pages of each morsel, except maybe the last one
+   * @return an iterator over each morsel, in the order of the pages
+   */
+  auto MakeMorselIterators(size_t pages_per_morsel) -> std::vector<TableIterator>;
+
+  /**
+   * Make an iterator over some columns only, which reads nothing of the other columns. Only for PAX tables.
+   * @param column_ids the columns to read
+   * @param page_filter if set, the pages it returns false for are skipped without reading their tuples
+   */
+  auto MakeColumnIterator(std::vector<uint32_t> column_ids, std::function<bool(page_id_t)> page_filter = nullptr)
+      -> TableColumnIterator;
+
   /** @return the id of the first page of this table */
   inline auto GetFirstPageId() const -> page_id_t { return first_page_id_; }
 
+  /**
+   * Give back the space of deleted tuples and move the tuples of the last pages into the room of earlier ones,
+   * releasing the pages that end up empty. No other operation may run on the table meanwhile. A PAX table is left as
+   * is.
+   * @param on_move called for every tuple moved, with its old and new rid, e.g. to update the indexes
+   * @return the number of pages released
+   */
+  auto Vacuum(const std::function<void(const Tuple &tuple, RID old_rid, RID new_rid)> &on_move) -> size_t;
+
   /**
    * Update a tuple in place. SHOULD NOT BE USED UNLESS YOU WANT TO OPTIMIZE FOR PROJECT 4.
    * @param meta new tuple meta
@@ -93,9 +181,82 @@ class TableHeap {
   void UpdateTupleInPlaceUnsafe(const TupleMeta &meta, const Tuple &tuple, RID rid);
 
  private:
+  /** Initialize the first page of the table. */
+  void InitFirstPage();
+
+  /** Insert into the last page of a PAX table, appending a new one if it is full. */
+  auto InsertPaxTuple(const TupleMeta &meta, const Tuple &tuple) -> std::pair<page_id_t, uint16_t>;
+
+  /** Widen the zone of a page to cover `tuple`, if the table keeps a zone map. */
+  void AddToZone(page_id_t page_id, const Tuple &tuple);
+
+  /**
+   * Insert into the page of `page_guard`, and record what is left. The page is never compacted here: a deleted tuple
+   * may still be revived by the abort of its transaction, so its room is only given back by a vacuum.
+   * @param stored the tuple as it is stored, its large values out of line
+   * @param tuple the tuple with all its values in line, which the zone of the page has to cover
+   */
+  auto InsertIntoPage(WritePageGuard *page_guard, const TupleMeta &meta, const Tuple &stored, const Tuple &tuple)
+      -> std::optional<uint16_t>;
+
+  /** Give back the room of the deleted tuples of a page, releasing their overflow pages. */
+  auto CompactPage(page_id_t page_id, TablePage *page) -> bool;
+
+  /** Read a tuple from a page of the table, its values stored out of line read back in. */
+  auto ReadTuple(ReadPageGuard *page_guard, RID rid) -> std::pair<TupleMeta, Tuple>;
+
+  /**
+   * Store the large values of `tuple` out of line, in new chains of overflow pages.
+   * @return the tuple to store instead, or std::nullopt if `tuple` is stored as it is
+   */
+  auto StoreOutOfLine(const Tuple &tuple) -> std::optional<Tuple>;
+
+  /** @return whether `view` stores a value out of line, among `column_ids` if given */
+  auto HasOutOfLineValues(const TupleView &view, const std::vector<uint32_t> *column_ids) const -> bool;
+
+  /**
+   * Copy the tuple of `view` out of its page, reading back in the values it stores out of line. The page must stay
+   * latched meanwhile, so that the overflow pages are not released.
+   * @param column_ids if given, only the values of these columns are read back in, the others keeping their prefix
+   */
+  auto FetchOutOfLine(const TupleView &view, const std::vector<uint32_t> *column_ids = nullptr) -> Tuple;
+
+  /** @return the first overflow page of each value `view` stores out of line */
+  auto OutOfLinePageIds(const TupleView &view) const -> std::vector<page_id_t>;
+
+  /**
+   * Write `size` bytes of `data` to a new chain of overflow pages.
+   * @return the first page of the chain
+   */
+  auto WriteOverflowPages(const char *data, uint32_t size) -> page_id_t;
+
+  /** Release chains of overflow pages, given the first page of each. */
+  void ReleaseOverflowPages(const std::vector<page_id_t> &first_page_ids);
+
+  /** Link a chain of new pages, from `first_page_id` to `last_page_id`, at the end of the table. */
+  void AppendPages(page_id_t first_page_id, page_id_t last_page_id);
+
+  /** The number of pages inserts go to at the same time, each thread always using the same one */
+  static constexpr size_t INSERT_TARGET_COUNT = 16;
+
+  struct InsertTarget {
+    std::mutex latch_;
+    page_id_t page_id_{INVALID_PAGE_ID}; /* protected by latch_ */
+  };
+
   BufferPoolManager *bpm_;
   page_id_t first_page_id_{INVALID_PAGE_ID};
+  TableLayout layout_{TableLayout::ROW};
+  /** The schema of the tuples, if the table was made with one */
+  std::optional<Schema> schema_;
+  std::unique_ptr<ZoneMap> zone_map_;
+  /** The number of tuples a PAX page is made for */
+  uint16_t pax_capacity_{0};
+  FreeSpaceMap free_space_map_;
+
+  std::array<InsertTarget, INSERT_TARGET_COUNT> insert_targets_;
 
+  /** Taken after the latch of an insert target, if both are needed */
   std::mutex latch_;
   page_id_t last_page_id_{INVALID_PAGE_ID}; /* protected by latch_ */
 };
@@ -13,8 +13,11 @@
 #pragma once
 
 #include <cassert>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include "common/macros.h"
 #include "common/rid.h"
@@ -36,6 +39,7 @@ class TableIterator {
 
   TableIterator(TableHeap *table_heap, RID rid, RID stop_at_rid);
   TableIterator(TableIterator &&) = default;
+  auto operator=(TableIterator &&) -> TableIterator & = default;
 
   ~TableIterator() = default;
 
@@ -47,7 +51,27 @@ class TableIterator {
 
   auto operator++() -> TableIterator &;
 
+  /**
+   * Only read back in the values stored out of line of some columns: the tuples keep the inline prefix of the values of
+   * the others, and the scan never touches their overflow pages.
+   */
+  void ReadColumns(std::vector<uint32_t> column_ids) { column_ids_ = std::move(column_ids); }
+
+  /** Move on to the first tuple of the next page, without reading the rest of the current one. */
+  auto SkipPage() -> TableIterator &;
+
+  /**
+   * Read the tuples of the current page in place, from the current one on, until `accept` takes one. Only the tuple
+   * taken is copied out of the page; the page is latched meanwhile, so `accept` must not touch the table.
+   * @return the tuple taken, or std::nullopt if `accept` took none of the page; either way the iterator is left on the
+   * tuple after the last one read
+   */
+  auto NextInPage(const std::function<bool(const TupleMeta &, const TupleView &)> &accept) -> std::optional<Tuple>;
+
  private:
+  /** Move to the first tuple of `next_page_id`, the page after the current one, unless the scan stops first. */
+  void MoveToNextPage(page_id_t next_page_id);
+
   TableHeap *table_heap_;
   RID rid_;
 
@@ -55,6 +79,9 @@ class TableIterator {
   // Otherwise we will have dead loops when updating while scanning. (In project 4, update should be implemented as
   // deletion + insertion.)
   RID stop_at_rid_;
+
+  /** The columns whose values stored out of line are read, if not all of them */
+  std::optional<std::vector<uint32_t>> column_ids_;
 };
 
 }  // namespace bustub
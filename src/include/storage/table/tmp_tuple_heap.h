@@ -0,0 +1,66 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_heap.h
+//
+// Identification: src/include/storage/table/tmp_tuple_heap.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "common/config.h"
+#include "common/macros.h"
+#include "storage/table/tuple.h"
+
+namespace bustub {
+
+/**
+ * TmpTupleHeap is a run of tuples an executor spills to disk, e.g. a partition of a hash table over its memory budget.
+ * The tuples are appended to temporary pages of the buffer pool, read back a page at a time in the order they were
+ * appended, and the pages are deleted along with the heap.
+ *
+ * No page stays pinned between calls, so that an executor may write to many heaps at once, e.g. one per partition.
+ */
+class TmpTupleHeap {
+ public:
+  explicit TmpTupleHeap(BufferPoolManager *bpm) : bpm_(bpm) {}
+
+  /** Delete the pages of the heap */
+  ~TmpTupleHeap();
+
+  DISALLOW_COPY_AND_MOVE(TmpTupleHeap);
+
+  /**
+   * Append a tuple to the heap.
+   * @throw ExecutionException if the tuple is too large for a page, or there is no frame left to spill to
+   */
+  void Append(const Tuple &tuple);
+
+  /** @return the number of pages of the heap */
+  auto GetPageCount() const -> size_t { return page_ids_.size(); }
+
+  /** @return the number of tuples of the heap */
+  auto GetTupleCount() const -> size_t { return tuple_count_; }
+
+  /**
+   * Read back the tuples of a page of the heap.
+   * @param page_idx the index of the page, in the order they were written
+   * @param[out] tuples the tuples of the page, in the order they were appended
+   */
+  void ReadPage(size_t page_idx, std::vector<Tuple> *tuples) const;
+
+ private:
+  BufferPoolManager *bpm_;
+  /** The pages of the heap, the last one being appended to */
+  std::vector<page_id_t> page_ids_;
+  size_t tuple_count_{0};
+};
+
+}  // namespace bustub
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "catalog/schema.h"
+#include "common/arena.h"
 #include "common/rid.h"
 #include "type/value.h"
 
@@ -42,6 +43,12 @@ struct TupleMeta {
 
 static_assert(sizeof(TupleMeta) == TUPLE_META_SIZE);
 
+/**
+ * Set in the offset of a varied-sized field whose payload is stored out of line by the table heap: the payload in the
+ * tuple is then a prefix of the value, followed by where the value is.
+ */
+static constexpr uint32_t TUPLE_OUT_OF_LINE_FLAG = 1U << 31;
+
 /**
  * Tuple format:
  * ---------------------------------------------------------------------
@@ -52,6 +59,8 @@ class Tuple {
   friend class TablePage;
   friend class TableHeap;
   friend class TableIterator;
+  friend class TupleView;
+  friend class TupleBatch;
 
  public:
   // Default constructor (to create a dummy tuple)
@@ -60,18 +69,22 @@ class Tuple {
   // constructor for table heap tuple
   explicit Tuple(RID rid) : rid_(rid) {}
 
-  // constructor for creating a new tuple based on input value
-  Tuple(std::vector<Value> values, const Schema *schema);
+  // constructor for creating a new tuple based on input value, its data allocated from `arena` if given
+  Tuple(std::vector<Value> values, const Schema *schema, Arena *arena = nullptr);
 
+  // copy constructor, the copy allocated from the heap whichever memory the original is in
   Tuple(const Tuple &other) = default;
 
-  // move constructor
+  // copy constructor, the copy allocated from `arena`
+  Tuple(const Tuple &other, Arena *arena) : rid_(other.rid_), data_(other.data_, ArenaAllocator<char>(arena)) {}
+
+  // move constructor, taking over the memory of the original
   Tuple(Tuple &&other) noexcept = default;
 
-  // assign operator, deep copy
+  // assign operator, deep copy; the tuple keeps allocating from where it did
   auto operator=(const Tuple &other) -> Tuple & = default;
 
-  // move assignment
+  // move assignment, which copies if the two tuples allocate from different places
   auto operator=(Tuple &&other) noexcept -> Tuple & = default;
 
   // serialize tuple data
@@ -94,7 +107,8 @@ class Tuple {
   auto GetValue(const Schema *schema, uint32_t column_idx) const -> Value;
 
   // Generates a key tuple given schemas and attributes
-  auto KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs) -> Tuple;
+  auto KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs) const
+      -> Tuple;
 
   // Is the column value null ?
   inline auto IsNull(const Schema *schema, uint32_t column_idx) const -> bool {
@@ -109,7 +123,43 @@ class Tuple {
   auto GetDataPtr(const Schema *schema, uint32_t column_idx) const -> const char *;
 
   RID rid_{};  // if pointing to the table heap, the rid is valid
-  std::vector<char> data_;
+  std::vector<char, ArenaAllocator<char>> data_;
+};
+
+/**
+ * TupleView reads a tuple where it lies, e.g. in a page, without copying it. It does not own the bytes it points to,
+ * so it must not outlive them: for a view into a page, the page has to stay pinned and latched. `Materialize` copies
+ * the tuple out once it has to live longer than that.
+ */
+class TupleView {
+ public:
+  TupleView(const char *data, uint32_t size, RID rid) : data_(data), size_(size), rid_(rid) {}
+
+  // a view of a tuple that is already materialized
+  explicit TupleView(const Tuple &tuple) : data_(tuple.GetData()), size_(tuple.GetLength()), rid_(tuple.GetRid()) {}
+
+  inline auto GetRid() const -> RID { return rid_; }
+
+  inline auto GetData() const -> const char * { return data_; }
+
+  inline auto GetLength() const -> uint32_t { return size_; }
+
+  // Get the value of a specified column, as `Tuple::GetValue` does
+  auto GetValue(const Schema *schema, uint32_t column_idx) const -> Value;
+
+  // Get the starting address of a specified column in the viewed data
+  auto GetDataPtr(const Schema *schema, uint32_t column_idx) const -> const char *;
+
+  // Is the value of a specified column stored out of line? Its value then only holds a prefix.
+  auto IsOutOfLine(const Schema *schema, uint32_t column_idx) const -> bool;
+
+  // Copy the tuple out of the memory it views
+  auto Materialize() const -> Tuple;
+
+ private:
+  const char *data_;
+  uint32_t size_;
+  RID rid_;
 };
 
 }  // namespace bustub
@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// zone_map.h
+//
+// Identification: src/include/storage/table/zone_map.h
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <mutex>  // NOLINT
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "common/config.h"
+#include "storage/table/tuple.h"
+#include "type/value.h"
+
+namespace bustub {
+
+/** The summary of one column over the tuples of a page */
+struct ColumnZone {
+  /** The smallest and largest non-null values, only meaningful if some value is not null */
+  Value min_;
+  Value max_;
+  uint32_t null_count_{0};
+};
+
+/** The summary of every column over the tuples of a page */
+struct PageZone {
+  uint32_t tuple_count_{0};
+  std::vector<ColumnZone> columns_;
+
+  /** @return whether every value of column `column_idx` in the page is null */
+  auto AllNull(uint32_t column_idx) const -> bool { return columns_[column_idx].null_count_ == tuple_count_; }
+};
+
+/**
+ * ZoneMap keeps, for each page of a table heap, the min and max value and the number of nulls of every column, so that
+ * a scan can skip the pages a predicate cannot match without reading their tuples.
+ *
+ * A zone only ever widens as tuples are added: deleted tuples stay in it until the page is summarized again from
+ * scratch, e.g. by vacuum. A zone is therefore a superset of the values in its page, never a subset. Zones are kept in
+ * memory only, like the catalog.
+ */
+class ZoneMap {
+ public:
+  explicit ZoneMap(const Schema &schema) : schema_(schema) {}
+
+  /** Widen the zone of a page to cover `tuple`. */
+  void Add(page_id_t page_id, const Tuple &tuple);
+
+  /** Forget a page, e.g. before summarizing it again or once it has been released. */
+  void Remove(page_id_t page_id);
+
+  /** @return a copy of the zone of a page, or std::nullopt if the page holds no tuple yet */
+  auto Get(page_id_t page_id) const -> std::optional<PageZone>;
+
+ private:
+  const Schema schema_;
+
+  mutable std::mutex latch_;
+  std::unordered_map<page_id_t, PageZone> zones_; /* protected by latch_ */
+};
+
+}  // namespace bustub
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+#include "catalog/catalog.h"
+#include "common/macros.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+auto Optimizer::OptimizeColumnarScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeColumnarScan(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  // the columns read above the scan have to be known, so only look below a projection or an aggregation
+  std::unordered_set<uint32_t> columns;
+  if (optimized_plan->GetType() == PlanType::Projection) {
+    for (const auto &expr : dynamic_cast<const ProjectionPlanNode &>(*optimized_plan).GetExpressions()) {
+      CollectColumns(expr, &columns);
+    }
+  } else if (optimized_plan->GetType() == PlanType::Aggregation) {
+    const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(*optimized_plan);
+    for (const auto &expr : agg_plan.GetGroupBys()) {
+      CollectColumns(expr, &columns);
+    }
+    for (const auto &expr : agg_plan.GetAggregates()) {
+      CollectColumns(expr, &columns);
+    }
+  } else {
+    return optimized_plan;
+  }
+  BUSTUB_ENSURE(optimized_plan->children_.size() == 1, "Projection and aggregation have exactly 1 child.");
+
+  // a filter passes the tuples of the scan on as they are, only reading some more columns
+  auto child = optimized_plan->children_[0];
+  const FilterPlanNode *filter_plan = nullptr;
+  if (child->GetType() == PlanType::Filter) {
+    filter_plan = dynamic_cast<const FilterPlanNode *>(child.get());
+    CollectColumns(filter_plan->GetPredicate(), &columns);
+    child = child->children_[0];
+  }
+  if (child->GetType() != PlanType::SeqScan) {
+    return optimized_plan;
+  }
+  const auto &scan_plan = dynamic_cast<const SeqScanPlanNode &>(*child);
+  const auto *table_info = catalog_.GetTable(scan_plan.GetTableOid());
+  if (scan_plan.columns_.has_value() || table_info->table_ == nullptr) {
+    return optimized_plan;
+  }
+  if (scan_plan.filter_predicate_ != nullptr) {
+    CollectColumns(scan_plan.filter_predicate_, &columns);
+  }
+  // a table of the row layout only gains when a column whose values may be stored out of line goes unread
+  const auto &unlined_columns = table_info->schema_.GetUnlinedColumns();
+  if (table_info->table_->GetLayout() != TableLayout::PAX &&
+      std::all_of(unlined_columns.begin(), unlined_columns.end(),
+                  [&columns](uint32_t column_idx) { return columns.count(column_idx) > 0; })) {
+    return optimized_plan;
+  }
+
+  std::vector<uint32_t> column_ids(columns.begin(), columns.end());
+  std::sort(column_ids.begin(), column_ids.end());
+  AbstractPlanNodeRef columnar_scan =
+      std::make_shared<SeqScanPlanNode>(scan_plan.output_schema_, scan_plan.table_oid_, scan_plan.table_name_,
+                                        scan_plan.filter_predicate_, std::move(column_ids));
+  if (filter_plan != nullptr) {
+    columnar_scan = filter_plan->CloneWithChildren({std::move(columnar_scan)});
+  }
+  return optimized_plan->CloneWithChildren({std::move(columnar_scan)});
+}
+
+}  // namespace bustub
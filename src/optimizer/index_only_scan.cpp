@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+#include "catalog/catalog.h"
+#include "common/macros.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/aggregation_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/projection_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+auto Optimizer::OptimizeIndexOnlyScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeIndexOnlyScan(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  // the columns read above the scan have to be known, so only look below a projection or an aggregation
+  std::unordered_set<uint32_t> columns;
+  if (optimized_plan->GetType() == PlanType::Projection) {
+    for (const auto &expr : dynamic_cast<const ProjectionPlanNode &>(*optimized_plan).GetExpressions()) {
+      CollectColumns(expr, &columns);
+    }
+  } else if (optimized_plan->GetType() == PlanType::Aggregation) {
+    const auto &agg_plan = dynamic_cast<const AggregationPlanNode &>(*optimized_plan);
+    for (const auto &expr : agg_plan.GetGroupBys()) {
+      CollectColumns(expr, &columns);
+    }
+    for (const auto &expr : agg_plan.GetAggregates()) {
+      CollectColumns(expr, &columns);
+    }
+  } else {
+    return optimized_plan;
+  }
+  BUSTUB_ENSURE(optimized_plan->children_.size() == 1, "Projection and aggregation have exactly 1 child.");
+  if (optimized_plan->children_[0]->GetType() != PlanType::IndexScan) {
+    return optimized_plan;
+  }
+  const auto &scan_plan = dynamic_cast<const IndexScanPlanNode &>(*optimized_plan->children_[0]);
+  if (scan_plan.index_only_) {
+    return optimized_plan;
+  }
+  if (scan_plan.filter_predicate_ != nullptr) {
+    CollectColumns(scan_plan.filter_predicate_, &columns);
+  }
+
+  // Any B+ tree index searched on the same columns gives the same entries in the same order; use the first one that
+  // also stores every column that is read, the scan's own index if possible.
+  const auto *scan_index = catalog_.GetIndex(scan_plan.GetIndexOid());
+  const auto &scan_attrs = scan_index->index_->GetKeyAttrs();
+  const std::vector<uint32_t> search_attrs(scan_attrs.begin(),
+                                           scan_attrs.end() - scan_index->index_->GetIncludeCount());
+  auto candidates = catalog_.GetTableIndexes(scan_index->table_name_);
+  std::stable_partition(candidates.begin(), candidates.end(),
+                        [&](const IndexInfo *index) { return index == scan_index; });
+  for (const auto *index : candidates) {
+    const auto &key_attrs = index->index_->GetKeyAttrs();
+    if (index->index_type_ != IndexType::BPlusTreeIndex ||
+        key_attrs.size() - index->index_->GetIncludeCount() != search_attrs.size() ||
+        !std::equal(search_attrs.begin(), search_attrs.end(), key_attrs.begin())) {
+      continue;
+    }
+    if (std::all_of(columns.begin(), columns.end(), [&](uint32_t column) {
+          return std::find(key_attrs.begin(), key_attrs.end(), column) != key_attrs.end();
+        })) {
+      auto index_only_scan = std::make_shared<IndexScanPlanNode>(
+          scan_plan.output_schema_, index->index_oid_, index->index_type_, scan_plan.pred_key_,
+          scan_plan.filter_predicate_, true);
+      return optimized_plan->CloneWithChildren({std::move(index_only_scan)});
+    }
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
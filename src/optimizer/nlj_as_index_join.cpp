@@ -22,14 +22,19 @@
 namespace bustub {
 
 auto Optimizer::MatchIndex(const std::string &table_name, uint32_t index_key_idx)
-    -> std::optional<std::tuple<index_oid_t, std::string>> {
-  const auto key_attrs = std::vector{index_key_idx};
+    -> std::optional<std::tuple<index_oid_t, std::string, IndexType>> {
+  std::optional<std::tuple<index_oid_t, std::string, IndexType>> matched = std::nullopt;
   for (const auto *index_info : catalog_.GetTableIndexes(table_name)) {
-    if (key_attrs == index_info->index_->GetKeyAttrs()) {
-      return std::make_optional(std::make_tuple(index_info->index_oid_, index_info->name_));
+    // only the searched columns matter, included ones are carried along
+    const auto &key_attrs = index_info->index_->GetKeyAttrs();
+    if (key_attrs.size() - index_info->index_->GetIncludeCount() == 1 && key_attrs[0] == index_key_idx) {
+      matched = std::make_optional(std::make_tuple(index_info->index_oid_, index_info->name_, index_info->index_type_));
+      if (index_info->index_type_ == IndexType::HashTableIndex) {
+        break;
+      }
     }
   }
-  return std::nullopt;
+  return matched;
 }
 
 auto Optimizer::OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
@@ -60,24 +65,29 @@ auto Optimizer::OptimizeNLJAsIndexJoin(const AbstractPlanNodeRef &plan) -> Abstr
             // Ensure right child is table scan
             if (nlj_plan.GetRightPlan()->GetType() == PlanType::SeqScan) {
               const auto &right_seq_scan = dynamic_cast<const SeqScanPlanNode &>(*nlj_plan.GetRightPlan());
+              // the outer column is encoded with the index key schema, so the types have to agree
+              if (right_seq_scan.filter_predicate_ != nullptr ||
+                  left_expr->GetReturnType() != right_expr->GetReturnType()) {
+                return optimized_plan;
+              }
               if (left_expr->GetTupleIdx() == 0 && right_expr->GetTupleIdx() == 1) {
                 if (auto index = MatchIndex(right_seq_scan.table_name_, right_expr->GetColIdx());
                     index != std::nullopt) {
-                  auto [index_oid, index_name] = *index;
+                  auto [index_oid, index_name, index_type] = *index;
                   return std::make_shared<NestedIndexJoinPlanNode>(
                       nlj_plan.output_schema_, nlj_plan.GetLeftPlan(), std::move(left_expr_tuple_0),
                       right_seq_scan.GetTableOid(), index_oid, std::move(index_name), right_seq_scan.table_name_,
-                      right_seq_scan.output_schema_, nlj_plan.GetJoinType());
+                      right_seq_scan.output_schema_, nlj_plan.GetJoinType(), index_type);
                 }
               }
               if (left_expr->GetTupleIdx() == 1 && right_expr->GetTupleIdx() == 0) {
                 if (auto index = MatchIndex(right_seq_scan.table_name_, left_expr->GetColIdx());
                     index != std::nullopt) {
-                  auto [index_oid, index_name] = *index;
+                  auto [index_oid, index_name, index_type] = *index;
                   return std::make_shared<NestedIndexJoinPlanNode>(
                       nlj_plan.output_schema_, nlj_plan.GetLeftPlan(), std::move(right_expr_tuple_0),
                       right_seq_scan.GetTableOid(), index_oid, std::move(index_name), right_seq_scan.table_name_,
-                      right_seq_scan.output_schema_, nlj_plan.GetJoinType());
+                      right_seq_scan.output_schema_, nlj_plan.GetJoinType(), index_type);
                 }
               }
             }
@@ -11,8 +11,13 @@ auto Optimizer::OptimizeCustom(const AbstractPlanNodeRef &plan) -> AbstractPlanN
   auto p = plan;
   p = OptimizeMergeProjection(p);
   p = OptimizeMergeFilterNLJ(p);
+  p = OptimizeNLJAsIndexJoin(p);
   p = OptimizeNLJAsHashJoin(p);
   p = OptimizeOrderByAsIndexScan(p);
+  p = OptimizeSeqScanAsIndexScan(p);
+  p = OptimizeIndexOnlyScan(p);
+  p = OptimizeMergeFilterScan(p);
+  p = OptimizeColumnarScan(p);
   p = OptimizeSortLimitAsTopN(p);
   return p;
 }
@@ -1,5 +1,19 @@
+#include <unordered_set>
+
+#include "execution/expressions/column_value_expression.h"
+#include "optimizer/optimizer.h"
+
 namespace bustub {
 
 void OptimizerHelperFunction() {}
 
+void Optimizer::CollectColumns(const AbstractExpressionRef &expr, std::unordered_set<uint32_t> *columns) {
+  if (const auto *column_expr = dynamic_cast<const ColumnValueExpression *>(expr.get()); column_expr != nullptr) {
+    columns->insert(column_expr->GetColIdx());
+  }
+  for (const auto &child : expr->GetChildren()) {
+    CollectColumns(child, columns);
+  }
+}
+
 }  // namespace bustub
@@ -58,7 +58,11 @@ auto Optimizer::OptimizeOrderByAsIndexScan(const AbstractPlanNodeRef &plan) -> A
       const auto indices = catalog_.GetTableIndexes(table_info->name_);
 
       for (const auto *index : indices) {
-        const auto &columns = index->key_schema_.GetColumns();
+        // hash indexes keep no key order
+        if (index->index_type_ != IndexType::BPlusTreeIndex) {
+          continue;
+        }
+        const auto &columns = index->index_->GetSearchKeySchema()->GetColumns();
         // check index key schema == order by columns
         bool valid = true;
         if (columns.size() == order_by_column_ids.size()) {
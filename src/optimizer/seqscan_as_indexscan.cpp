@@ -0,0 +1,100 @@
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "catalog/catalog.h"
+#include "common/macros.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/expressions/logic_expression.h"
+#include "execution/plans/abstract_plan.h"
+#include "execution/plans/filter_plan.h"
+#include "execution/plans/index_scan_plan.h"
+#include "execution/plans/seq_scan_plan.h"
+#include "optimizer/optimizer.h"
+
+namespace bustub {
+
+/** Collect the conjuncts of `expr`, i.e. `a AND (b AND c)` gives `a, b, c`. */
+static void CollectConjuncts(const AbstractExpressionRef &expr, std::vector<AbstractExpressionRef> *conjuncts) {
+  if (const auto *logic = dynamic_cast<const LogicExpression *>(expr.get());
+      logic != nullptr && logic->logic_type_ == LogicType::And) {
+    CollectConjuncts(logic->children_[0], conjuncts);
+    CollectConjuncts(logic->children_[1], conjuncts);
+    return;
+  }
+  conjuncts->push_back(expr);
+}
+
+/** The selectivity of an equality predicate on a column without statistics, as in System R */
+static constexpr double EQUALITY_SELECTIVITY = 0.1;
+
+/** Fetching the matching tuples in page order pays off once a probe is expected to return this many */
+static constexpr double SORTED_FETCH_MIN_ROWS = 64;
+
+auto Optimizer::OptimizeSeqScanAsIndexScan(const AbstractPlanNodeRef &plan) -> AbstractPlanNodeRef {
+  std::vector<AbstractPlanNodeRef> children;
+  for (const auto &child : plan->GetChildren()) {
+    children.emplace_back(OptimizeSeqScanAsIndexScan(child));
+  }
+  auto optimized_plan = plan->CloneWithChildren(std::move(children));
+
+  // the predicate may still sit in a filter above the scan, or already be merged into it
+  const SeqScanPlanNode *seq_scan = nullptr;
+  AbstractExpressionRef predicate;
+  if (optimized_plan->GetType() == PlanType::Filter) {
+    const auto &filter_plan = dynamic_cast<const FilterPlanNode &>(*optimized_plan);
+    BUSTUB_ENSURE(filter_plan.children_.size() == 1, "Filter should have exactly 1 child.");
+    if (filter_plan.GetChildPlan()->GetType() == PlanType::SeqScan) {
+      seq_scan = dynamic_cast<const SeqScanPlanNode *>(filter_plan.GetChildPlan().get());
+      if (seq_scan->filter_predicate_ != nullptr) {
+        return optimized_plan;
+      }
+      predicate = filter_plan.GetPredicate();
+    }
+  } else if (optimized_plan->GetType() == PlanType::SeqScan) {
+    seq_scan = dynamic_cast<const SeqScanPlanNode *>(optimized_plan.get());
+    predicate = seq_scan->filter_predicate_;
+  }
+  if (seq_scan == nullptr || predicate == nullptr) {
+    return optimized_plan;
+  }
+
+  // look for a `<column expr> = <constant>` conjunct with a matching index
+  std::vector<AbstractExpressionRef> conjuncts;
+  CollectConjuncts(predicate, &conjuncts);
+  for (const auto &conjunct : conjuncts) {
+    const auto *expr = dynamic_cast<const ComparisonExpression *>(conjunct.get());
+    if (expr == nullptr || expr->comp_type_ != ComparisonType::Equal) {
+      continue;
+    }
+    const auto *column_expr = dynamic_cast<const ColumnValueExpression *>(expr->children_[0].get());
+    auto constant_expr = std::dynamic_pointer_cast<ConstantValueExpression>(expr->children_[1]);
+    if (column_expr == nullptr || constant_expr == nullptr) {
+      column_expr = dynamic_cast<const ColumnValueExpression *>(expr->children_[1].get());
+      constant_expr = std::dynamic_pointer_cast<ConstantValueExpression>(expr->children_[0]);
+    }
+    if (column_expr == nullptr || constant_expr == nullptr || constant_expr->val_.IsNull() ||
+        constant_expr->GetReturnType() != column_expr->GetReturnType()) {
+      continue;
+    }
+    if (auto index = MatchIndex(seq_scan->table_name_, column_expr->GetColIdx()); index != std::nullopt) {
+      auto [index_oid, index_name, index_type] = *index;
+      // the fetched tuples only need re-checking when the equality is not the whole predicate, or when the index may
+      // hold a truncated prefix of the value
+      auto filter_predicate =
+          conjuncts.size() == 1 && column_expr->GetReturnType() != TypeId::VARCHAR ? nullptr : predicate;
+      // guess how many rows match from the table size; with no guess, keep the key order
+      auto cardinality = EstimatedCardinality(seq_scan->table_name_);
+      bool sorted_fetch = cardinality.has_value() && *cardinality * EQUALITY_SELECTIVITY >= SORTED_FETCH_MIN_ROWS;
+      return std::make_shared<IndexScanPlanNode>(optimized_plan->output_schema_, index_oid, index_type,
+                                                 std::move(constant_expr), std::move(filter_predicate), false,
+                                                 sorted_fetch);
+    }
+  }
+
+  return optimized_plan;
+}
+
+}  // namespace bustub
@@ -13,6 +13,7 @@
 #include "common/rid.h"
 #include "fmt/core.h"
 #include "storage/index/b_plus_tree.h"
+#include "storage/index/memcmp_key.h"
 #include "storage/page/b_plus_tree_header_page.h"
 #include "storage/page/b_plus_tree_internal_page.h"
 #include "storage/page/b_plus_tree_leaf_page.h"
@@ -24,13 +25,15 @@ namespace bustub {
 #define P2_DEBUG
 INDEX_TEMPLATE_ARGUMENTS
 BPLUSTREE_TYPE::BPlusTree(std::string name, page_id_t header_page_id, BufferPoolManager *buffer_pool_manager,
-                          const KeyComparator &comparator, int leaf_max_size, int internal_max_size)
+                          const KeyComparator &comparator, int leaf_max_size, int internal_max_size,
+                          int path_cache_levels)
     : index_name_(std::move(name)),
       bpm_(buffer_pool_manager),
       comparator_(std::move(comparator)),
       leaf_max_size_(leaf_max_size),
       internal_max_size_(internal_max_size),
-      header_page_id_(header_page_id) {
+      header_page_id_(header_page_id),
+      path_cache_levels_(path_cache_levels) {
   WritePageGuard guard = bpm_->FetchPageWrite(header_page_id_);
   auto root_page = guard.AsMut<BPlusTreeHeaderPage>();
   root_page->root_page_id_ = INVALID_PAGE_ID;
@@ -70,15 +73,7 @@ auto BPLUSTREE_TYPE::GetPageLeaf(const KeyType &key, Context &ctx) -> page_id_t
   ctx.write_set_.push_back(std::move(guard));
   /*找到叶子节点*/
   while (!page->IsLeafPage()) {
-    auto page2 = reinterpret_cast<const InternalPage *>(page);
-    int index = 1;
-    while (comparator_(page2->KeyAt(index), key) <= 0 && index < page2->GetSize()) {
-      ++index;
-    }
-    if (index > 0) {
-      --index;
-    }
-    page_id = page2->ValueAt(index);
+    page_id = LookupChild(reinterpret_cast<const InternalPage *>(page), key);
     guard = bpm_->FetchPageWrite(page_id);
     page = guard.As<BPlusTreePage>();
     ctx.write_set_.push_back(std::move(guard));
@@ -93,20 +88,112 @@ auto BPLUSTREE_TYPE::GetPageLeaf2(const KeyType &key) -> page_id_t {
   auto page = guard.As<BPlusTreePage>();
   /*找到叶子节点*/
   while (!page->IsLeafPage()) {
-    auto page2 = reinterpret_cast<const InternalPage *>(page);
-    int index = 1;
-    while (comparator_(page2->KeyAt(index), key) <= 0 && index < page2->GetSize()) {
-      ++index;
-    }
-    if (index > 0) {
-      --index;
-    }
-    page_id = page2->ValueAt(index);
+    page_id = LookupChild(reinterpret_cast<const InternalPage *>(page), key);
     guard = bpm_->FetchPageWrite(page_id);
     page = guard.As<BPlusTreePage>();
   }
   return page_id;
 };
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::LookupChild(const InternalPage *page, const KeyType &key) -> page_id_t {
+  int index = 1;
+  while (index < page->GetSize() && comparator_(page->KeyAt(index), key) <= 0) {
+    ++index;
+  }
+  return page->ValueAt(index - 1);
+}
+
+/*****************************************************************************
+ * PATH CACHE
+ *****************************************************************************/
+/*
+ * The top path_cache_levels_ levels of internal pages are copied into memory the first time a lookup passes
+ * through them. The copies are only valid for the structure version they were taken at: every writer that may
+ * touch an internal page or the root page id holds a StructureChangeGuard, which drops the whole cache.
+ */
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::DescendPathCache(const KeyType &key, uint64_t version, int *level) -> page_id_t {
+  std::shared_lock lock(path_cache_latch_);
+  if (path_cache_.version_ != version) {
+    return INVALID_PAGE_ID;
+  }
+  page_id_t page_id = path_cache_.root_page_id_;
+  *level = 0;
+  while (*level < path_cache_levels_) {
+    auto it = path_cache_.pages_.find(page_id);
+    if (it == path_cache_.pages_.end()) {
+      break;
+    }
+    page_id = LookupChild(reinterpret_cast<const InternalPage *>(it->second.get()), key);
+    ++*level;
+  }
+  return page_id;
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::ResetPathCache(uint64_t version, page_id_t root_page_id) {
+  std::unique_lock lock(path_cache_latch_);
+  if (path_cache_.version_ == version) {
+    return;
+  }
+  path_cache_.version_ = version;
+  path_cache_.root_page_id_ = root_page_id;
+  path_cache_.pages_.clear();
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+void BPLUSTREE_TYPE::CachePathPage(uint64_t version, page_id_t page_id, const char *data) {
+  std::unique_lock lock(path_cache_latch_);
+  if (path_cache_.version_ != version || path_cache_.pages_.count(page_id) != 0) {
+    return;
+  }
+  auto copy = std::make_unique<char[]>(BUSTUB_PAGE_SIZE);
+  memcpy(copy.get(), data, BUSTUB_PAGE_SIZE);
+  path_cache_.pages_.emplace(page_id, std::move(copy));
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_TYPE::GetValueThroughPathCache(const KeyType &key, std::vector<ValueType> *result)
+    -> std::optional<bool> {
+  uint64_t version = structure_version_.load();
+  if ((version & 1) != 0) {
+    return std::nullopt;
+  }
+  int level = 0;
+  page_id_t page_id = DescendPathCache(key, version, &level);
+  if (page_id == INVALID_PAGE_ID) {
+    page_id = GetRootPageId();
+    if (page_id == INVALID_PAGE_ID || structure_version_.load() != version) {
+      return std::nullopt;
+    }
+    ResetPathCache(version, page_id);
+    level = 0;
+  }
+  auto guard = bpm_->FetchPageRead(page_id);
+  auto page = guard.template As<BPlusTreePage>();
+  /*持有读锁后再检查版本，保证页面内容属于同一个版本*/
+  while (structure_version_.load() == version && !page->IsLeafPage()) {
+    if (level < path_cache_levels_) {
+      CachePathPage(version, page_id, guard.GetData());
+    }
+    page_id = LookupChild(reinterpret_cast<const InternalPage *>(page), key);
+    guard = bpm_->FetchPageRead(page_id);
+    page = guard.template As<BPlusTreePage>();
+    ++level;
+  }
+  if (structure_version_.load() != version) {
+    return std::nullopt;
+  }
+  auto leaf = guard.template As<LeafPage>();
+  int index = leaf->FindKeyIndex(key, comparator_);
+  if (index == -1) {
+    return false;
+  }
+  result->push_back(leaf->ValueAt(index));
+  return true;
+}
+
 /*****************************************************************************
  * SEARCH
  *****************************************************************************/
@@ -117,7 +204,12 @@ auto BPLUSTREE_TYPE::GetPageLeaf2(const KeyType &key) -> page_id_t {
  */
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result, Transaction *txn) -> bool {
-  Context ctx;
+  if (path_cache_levels_ > 0) {
+    auto found = GetValueThroughPathCache(key, result);
+    if (found.has_value()) {
+      return *found;
+    }
+  }
   auto page_id = GetPageLeaf2(key);
   auto guard = bpm_->FetchPageRead(page_id);
   auto page = guard.template As<LeafPage>();
@@ -131,6 +223,7 @@ auto BPLUSTREE_TYPE::GetValue(const KeyType &key, std::vector<ValueType> *result
 
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_TYPE::StartNewTree(const KeyType &key, const ValueType &value) {
+  StructureChangeGuard structure_change(&structure_version_);
   page_id_t page_id;
   auto page = bpm_->NewPageGuarded(&page_id);
   if (page.GetData() == nullptr) {
@@ -185,6 +278,7 @@ auto BPLUSTREE_TYPE::Insert(const KeyType &key, const ValueType &value, Transact
   }
   /*分页*/
   if (page_tmp->GetSize() >= leaf_max_size_ - 1) {
+    StructureChangeGuard structure_change(&structure_version_);
     page_tmp->InsertAt(key, value, comparator_);
     /*create new page*/
     page_id_t page_id{};
@@ -424,6 +518,11 @@ void BPLUSTREE_TYPE::Remove(const KeyType &key, Transaction *txn) {
   auto parent = ctx.write_set_.back().AsMut<InternalPage>();
   int index = parent->FindKeyIndex(key_tmp, comparator_);
   index = (index == -1) ? 0 : index;
+  /*只修改叶子节点时不需要使缓存的上层路径失效*/
+  std::optional<StructureChangeGuard> structure_change;
+  if ((is_head && index != 0) || page->GetSize() < page->GetMinSize()) {
+    structure_change.emplace(&structure_version_);
+  }
   if (is_head && index != 0) {
     parent->SetKeyAt(index, page->KeyAt(0));
   }
@@ -517,8 +616,18 @@ auto BPLUSTREE_TYPE::Begin(const KeyType &key) -> INDEXITERATOR_TYPE {
 #endif
   Context ctx;
   page_id_t page_id = GetPageLeaf(key, ctx);
-  auto leaf_page = ctx.write_set_.back().AsMut<LeafPage>();
-  int index = leaf_page->FindKeyIndex(key, comparator_);
+  if (page_id == INVALID_PAGE_ID) {
+    return End();
+  }
+  // start at the first entry not less than `key`, which may be the first one of the next leaf
+  auto leaf_page = ctx.write_set_.back().As<LeafPage>();
+  int index = leaf_page->FindKeyIndex2(key, comparator_);
+  if (index == leaf_page->GetSize()) {
+    page_id = leaf_page->GetNextPageId();
+    index = 0;
+  }
+  ctx.write_set_.clear();
+  ctx.header_page_ = std::nullopt;
   return INDEXITERATOR_TYPE(bpm_, page_id, index);
 }
 
@@ -778,4 +887,9 @@ template class BPlusTree<GenericKey<32>, RID, GenericComparator<32>>;
 
 template class BPlusTree<GenericKey<64>, RID, GenericComparator<64>>;
 
+template class BPlusTree<MemcmpKey<8>, RID, MemcmpComparator<8>>;
+template class BPlusTree<MemcmpKey<16>, RID, MemcmpComparator<16>>;
+template class BPlusTree<MemcmpKey<32>, RID, MemcmpComparator<32>>;
+template class BPlusTree<MemcmpKey<64>, RID, MemcmpComparator<64>>;
+
 }  // namespace bustub
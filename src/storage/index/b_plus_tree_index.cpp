@@ -9,7 +9,12 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "storage/index/b_plus_tree_index.h"
+#include "storage/index/memcmp_key.h"
 
 namespace bustub {
 /*
@@ -18,35 +23,86 @@ namespace bustub {
 INDEX_TEMPLATE_ARGUMENTS
 BPLUSTREE_INDEX_TYPE::BPlusTreeIndex(std::unique_ptr<IndexMetadata> &&metadata, BufferPoolManager *buffer_pool_manager)
     : Index(std::move(metadata)), comparator_(GetMetadata()->GetKeySchema()) {
+  if constexpr (IsMemcmpKey<KeyType>::value) {
+    // the RID is encoded after the columns, and the included columns after the searched ones, so a lookup fixes a
+    // prefix of the key and walks the entries that share it
+    rid_offset_ = MemcmpKeyEncoder::EncodedSize(*GetKeySchema());
+    BUSTUB_ASSERT(rid_offset_ + MemcmpKeyEncoder::RID_SIZE <= sizeof(KeyType), "key type has no room for the RID");
+    search_prefix_size_ = MemcmpKeyEncoder::EncodedSize(*GetSearchKeySchema());
+  } else {
+    search_prefix_size_ = sizeof(KeyType);
+  }
   page_id_t header_page_id;
   buffer_pool_manager->NewPage(&header_page_id);
   container_ = std::make_shared<BPlusTree<KeyType, ValueType, KeyComparator>>(GetMetadata()->GetName(), header_page_id,
                                                                               buffer_pool_manager, comparator_);
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::MakeEntryKey(const Tuple &key, RID rid) -> KeyType {
+  KeyType index_key;
+  index_key.SetFromKey(key, *GetMetadata()->GetKeySchema());
+  if constexpr (IsMemcmpKey<KeyType>::value) {
+    index_key.SetRID(rid_offset_, rid);
+  }
+  return index_key;
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) -> bool {
   // construct insert index key
-  KeyType index_key;
-  index_key.SetFromKey(key);
+  auto index_key = MakeEntryKey(key, rid);
+  if (!KeyType::CanDecode(key, *GetMetadata()->GetKeySchema())) {
+    keys_decodable_ = false;
+  }
 
   return container_->Insert(index_key, rid, transaction);
 }
 
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::InsertEntries(const std::vector<std::pair<Tuple, RID>> &entries, Transaction *transaction)
+    -> size_t {
+  std::vector<std::pair<KeyType, RID>> index_entries(entries.size());
+  for (size_t i = 0; i < entries.size(); i++) {
+    index_entries[i].first = MakeEntryKey(entries[i].first, entries[i].second);
+    index_entries[i].second = entries[i].second;
+    if (!KeyType::CanDecode(entries[i].first, *GetMetadata()->GetKeySchema())) {
+      keys_decodable_ = false;
+    }
+  }
+  // In key order, consecutive inserts go down the same path and mostly land in the same leaf, which stays in the
+  // buffer pool. The sort is stable so that of equal keys, which only keys without a RID can be, the first one wins, as
+  // with one insert at a time.
+  std::stable_sort(index_entries.begin(), index_entries.end(),
+                   [this](const auto &lhs, const auto &rhs) { return comparator_(lhs.first, rhs.first) < 0; });
+  size_t count = 0;
+  for (const auto &[index_key, rid] : index_entries) {
+    count += static_cast<size_t>(container_->Insert(index_key, rid, transaction));
+  }
+  return count;
+}
+
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
-  // construct delete index key
-  KeyType index_key;
-  index_key.SetFromKey(key);
+  // construct delete index key, which only matches the entry of `rid` among those of equal columns
+  auto index_key = MakeEntryKey(key, rid);
 
   container_->Remove(index_key, transaction);
 }
 
 INDEX_TEMPLATE_ARGUMENTS
 void BPLUSTREE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
+  if (IsMemcmpKey<KeyType>::value || GetIncludeCount() > 0) {
+    // several entries may share the searched columns
+    for (auto cursor = MakeCursor(key); !cursor->IsEnd(); cursor->Next()) {
+      result->push_back(cursor->GetRID());
+    }
+    return;
+  }
+
   // construct scan index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  index_key.SetFromKey(key, *GetMetadata()->GetKeySchema());
 
   container_->GetValue(index_key, result, transaction);
 }
@@ -60,10 +116,30 @@ auto BPLUSTREE_INDEX_TYPE::GetBeginIterator(const KeyType &key) -> INDEXITERATOR
 INDEX_TEMPLATE_ARGUMENTS
 auto BPLUSTREE_INDEX_TYPE::GetEndIterator() -> INDEXITERATOR_TYPE { return container_->End(); }
 
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::MakeCursor() -> std::unique_ptr<IndexCursor> {
+  return std::make_unique<BPlusTreeIndexCursor<KeyType, ValueType, KeyComparator>>(container_.get(),
+                                                                                   GetMetadata()->GetKeySchema());
+}
+
+INDEX_TEMPLATE_ARGUMENTS
+auto BPLUSTREE_INDEX_TYPE::MakeCursor(const Tuple &key) -> std::unique_ptr<IndexCursor> {
+  // the included columns and the RID are left zeroed, which sorts before any value they can hold
+  KeyType index_key;
+  index_key.SetFromKey(key, *GetSearchKeySchema());
+  return std::make_unique<BPlusTreeIndexCursor<KeyType, ValueType, KeyComparator>>(
+      container_.get(), GetMetadata()->GetKeySchema(), index_key, search_prefix_size_);
+}
+
 template class BPlusTreeIndex<GenericKey<4>, RID, GenericComparator<4>>;
 template class BPlusTreeIndex<GenericKey<8>, RID, GenericComparator<8>>;
 template class BPlusTreeIndex<GenericKey<16>, RID, GenericComparator<16>>;
 template class BPlusTreeIndex<GenericKey<32>, RID, GenericComparator<32>>;
 template class BPlusTreeIndex<GenericKey<64>, RID, GenericComparator<64>>;
 
+template class BPlusTreeIndex<MemcmpKey<8>, RID, MemcmpComparator<8>>;
+template class BPlusTreeIndex<MemcmpKey<16>, RID, MemcmpComparator<16>>;
+template class BPlusTreeIndex<MemcmpKey<32>, RID, MemcmpComparator<32>>;
+template class BPlusTreeIndex<MemcmpKey<64>, RID, MemcmpComparator<64>>;
+
 }  // namespace bustub
@@ -1,6 +1,7 @@
 #include <vector>
 
 #include "storage/index/extendible_hash_table_index.h"
+#include "storage/index/memcmp_key.h"
 
 namespace bustub {
 /*
@@ -18,7 +19,7 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 auto HASH_TABLE_INDEX_TYPE::InsertEntry(const Tuple &key, RID rid, Transaction *transaction) -> bool {
   // construct insert index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  index_key.SetFromKey(key, *GetMetadata()->GetKeySchema());
 
   return container_.Insert(transaction, index_key, rid);
 }
@@ -27,7 +28,7 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 void HASH_TABLE_INDEX_TYPE::DeleteEntry(const Tuple &key, RID rid, Transaction *transaction) {
   // construct delete index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  index_key.SetFromKey(key, *GetMetadata()->GetKeySchema());
 
   container_.Remove(transaction, index_key, rid);
 }
@@ -36,7 +37,7 @@ template <typename KeyType, typename ValueType, typename KeyComparator>
 void HASH_TABLE_INDEX_TYPE::ScanKey(const Tuple &key, std::vector<RID> *result, Transaction *transaction) {
   // construct scan index key
   KeyType index_key;
-  index_key.SetFromKey(key);
+  index_key.SetFromKey(key, *GetMetadata()->GetKeySchema());
 
   container_.GetValue(transaction, index_key, result);
 }
@@ -46,4 +47,9 @@ template class ExtendibleHashTableIndex<GenericKey<16>, RID, GenericComparator<1
 template class ExtendibleHashTableIndex<GenericKey<32>, RID, GenericComparator<32>>;
 template class ExtendibleHashTableIndex<GenericKey<64>, RID, GenericComparator<64>>;
 
+template class ExtendibleHashTableIndex<MemcmpKey<8>, RID, MemcmpComparator<8>>;
+template class ExtendibleHashTableIndex<MemcmpKey<16>, RID, MemcmpComparator<16>>;
+template class ExtendibleHashTableIndex<MemcmpKey<32>, RID, MemcmpComparator<32>>;
+template class ExtendibleHashTableIndex<MemcmpKey<64>, RID, MemcmpComparator<64>>;
+
 }  // namespace bustub
@@ -5,6 +5,7 @@
 
 #include "common/config.h"
 #include "storage/index/index_iterator.h"
+#include "storage/index/memcmp_key.h"
 #include "storage/page/b_plus_tree_leaf_page.h"
 
 namespace bustub {
@@ -93,4 +94,9 @@ template class IndexIterator<GenericKey<32>, RID, GenericComparator<32>>;
 
 template class IndexIterator<GenericKey<64>, RID, GenericComparator<64>>;
 
+template class IndexIterator<MemcmpKey<8>, RID, MemcmpComparator<8>>;
+template class IndexIterator<MemcmpKey<16>, RID, MemcmpComparator<16>>;
+template class IndexIterator<MemcmpKey<32>, RID, MemcmpComparator<32>>;
+template class IndexIterator<MemcmpKey<64>, RID, MemcmpComparator<64>>;
+
 }  // namespace bustub
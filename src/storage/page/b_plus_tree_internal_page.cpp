@@ -14,6 +14,7 @@
 #include <sstream>
 
 #include "common/exception.h"
+#include "storage/index/memcmp_key.h"
 #include "storage/page/b_plus_tree_internal_page.h"
 #include "storage/page/b_plus_tree_page.h"
 
@@ -138,4 +139,9 @@ template class BPlusTreeInternalPage<GenericKey<8>, page_id_t, GenericComparator
 template class BPlusTreeInternalPage<GenericKey<16>, page_id_t, GenericComparator<16>>;
 template class BPlusTreeInternalPage<GenericKey<32>, page_id_t, GenericComparator<32>>;
 template class BPlusTreeInternalPage<GenericKey<64>, page_id_t, GenericComparator<64>>;
+
+template class BPlusTreeInternalPage<MemcmpKey<8>, page_id_t, MemcmpComparator<8>>;
+template class BPlusTreeInternalPage<MemcmpKey<16>, page_id_t, MemcmpComparator<16>>;
+template class BPlusTreeInternalPage<MemcmpKey<32>, page_id_t, MemcmpComparator<32>>;
+template class BPlusTreeInternalPage<MemcmpKey<64>, page_id_t, MemcmpComparator<64>>;
 }  // namespace bustub
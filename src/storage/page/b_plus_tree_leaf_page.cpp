@@ -19,6 +19,7 @@
 #include "common/exception.h"
 #include "common/logger.h"
 #include "common/rid.h"
+#include "storage/index/memcmp_key.h"
 #include "storage/page/b_plus_tree_leaf_page.h"
 #include "storage/page/b_plus_tree_page.h"
 
@@ -74,7 +75,7 @@ auto B_PLUS_TREE_LEAF_PAGE_TYPE::KeyValueAt(int index) -> const MappingType & {
 INDEX_TEMPLATE_ARGUMENTS
 auto B_PLUS_TREE_LEAF_PAGE_TYPE::FindKeyIndex2(const KeyType &key, const KeyComparator &comparator) const -> int {
   int index = 0;
-  while (comparator(KeyAt(index), key) < 0 && index < GetSize()) {
+  while (index < GetSize() && comparator(KeyAt(index), key) < 0) {
     ++index;
   }
   return index;
@@ -101,7 +102,7 @@ auto B_PLUS_TREE_LEAF_PAGE_TYPE::FindKeyIndex(const KeyType &key, const KeyCompa
 INDEX_TEMPLATE_ARGUMENTS
 auto B_PLUS_TREE_LEAF_PAGE_TYPE::Remove(const KeyType &key, const KeyComparator &comparator) -> bool {
   int index = 0;
-  while (comparator(KeyAt(index), key) < 0 && index < GetSize()) {
+  while (index < GetSize() && comparator(KeyAt(index), key) < 0) {
     ++index;
   }
   if (comparator(KeyAt(index), key) != 0) {
@@ -128,7 +129,7 @@ auto B_PLUS_TREE_LEAF_PAGE_TYPE::InsertAt(const KeyType &key, const ValueType &v
     return true;
   }
   int index = 0;
-  while (comparator(KeyAt(index), key) < 0 && index < GetSize()) {
+  while (index < GetSize() && comparator(KeyAt(index), key) < 0) {
     ++index;
   }
   std::move_backward(array_ + index, array_ + GetSize(), array_ + GetSize() + 1);
@@ -145,4 +146,9 @@ template class BPlusTreeLeafPage<GenericKey<8>, RID, GenericComparator<8>>;
 template class BPlusTreeLeafPage<GenericKey<16>, RID, GenericComparator<16>>;
 template class BPlusTreeLeafPage<GenericKey<32>, RID, GenericComparator<32>>;
 template class BPlusTreeLeafPage<GenericKey<64>, RID, GenericComparator<64>>;
+
+template class BPlusTreeLeafPage<MemcmpKey<8>, RID, MemcmpComparator<8>>;
+template class BPlusTreeLeafPage<MemcmpKey<16>, RID, MemcmpComparator<16>>;
+template class BPlusTreeLeafPage<MemcmpKey<32>, RID, MemcmpComparator<32>>;
+template class BPlusTreeLeafPage<MemcmpKey<64>, RID, MemcmpComparator<64>>;
 }  // namespace bustub
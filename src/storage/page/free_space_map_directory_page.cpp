@@ -0,0 +1,69 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map_directory_page.cpp
+//
+// Identification: src/storage/page/free_space_map_directory_page.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/free_space_map_directory_page.h"
+
+#include "common/macros.h"
+#include "storage/page/free_space_map_page.h"
+
+namespace bustub {
+
+void FreeSpaceMapDirectoryPage::Init() {
+  next_page_id_ = INVALID_PAGE_ID;
+  size_ = 0;
+}
+
+auto FreeSpaceMapDirectoryPage::FindRange(page_id_t first_page_id) const -> std::optional<uint32_t> {
+  for (uint32_t i = 0; i < size_; i++) {
+    if (first_page_ids_[i] == first_page_id) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+auto FreeSpaceMapDirectoryPage::MapPageIdAt(uint32_t index) const -> page_id_t {
+  BUSTUB_ASSERT(index < size_, "free-space map directory index out of range");
+  return map_page_ids_[index];
+}
+
+auto FreeSpaceMapDirectoryPage::MaxBucketAt(uint32_t index) const -> uint8_t {
+  BUSTUB_ASSERT(index < size_, "free-space map directory index out of range");
+  return max_buckets_[index];
+}
+
+void FreeSpaceMapDirectoryPage::SetMaxBucket(uint32_t index, uint8_t bucket) {
+  BUSTUB_ASSERT(index < size_, "free-space map directory index out of range");
+  BUSTUB_ASSERT(bucket < FSM_NUM_BUCKETS, "bucket out of range");
+  max_buckets_[index] = bucket;
+}
+
+auto FreeSpaceMapDirectoryPage::Append(page_id_t first_page_id, page_id_t map_page_id, uint8_t max_bucket)
+    -> uint32_t {
+  BUSTUB_ASSERT(!IsFull(), "free-space map directory page is full");
+  BUSTUB_ASSERT(max_bucket < FSM_NUM_BUCKETS, "bucket out of range");
+  first_page_ids_[size_] = first_page_id;
+  map_page_ids_[size_] = map_page_id;
+  max_buckets_[size_] = max_bucket;
+  return size_++;
+}
+
+auto FreeSpaceMapDirectoryPage::FindMaxBucketAtLeast(uint8_t bucket) const -> std::optional<uint32_t> {
+  for (uint32_t i = 0; i < size_; i++) {
+    if (max_buckets_[i] >= bucket) {
+      return i;
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace bustub
@@ -0,0 +1,63 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map_page.cpp
+//
+// Identification: src/storage/page/free_space_map_page.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/free_space_map_page.h"
+
+#include <cstring>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+void FreeSpaceMapPage::Init(page_id_t first_page_id) {
+  BUSTUB_ASSERT(RangeOf(first_page_id) == first_page_id, "a free-space map page starts at the start of a range");
+  first_page_id_ = first_page_id;
+  memset(bucket_counts_, 0, sizeof(bucket_counts_));
+  bucket_counts_[0] = FSM_PAGE_CAPACITY;
+  memset(buckets_, 0, sizeof(buckets_));
+}
+
+auto FreeSpaceMapPage::GetBucket(page_id_t page_id) const -> uint8_t {
+  BUSTUB_ASSERT(RangeOf(page_id) == first_page_id_, "page id out of the range of the free-space map page");
+  return buckets_[page_id - first_page_id_];
+}
+
+void FreeSpaceMapPage::SetBucket(page_id_t page_id, uint8_t bucket) {
+  BUSTUB_ASSERT(RangeOf(page_id) == first_page_id_, "page id out of the range of the free-space map page");
+  BUSTUB_ASSERT(bucket < FSM_NUM_BUCKETS, "bucket out of range");
+  auto &old_bucket = buckets_[page_id - first_page_id_];
+  bucket_counts_[old_bucket]--;
+  old_bucket = bucket;
+  bucket_counts_[bucket]++;
+}
+
+auto FreeSpaceMapPage::GetMaxBucket() const -> uint8_t {
+  uint8_t bucket = FSM_NUM_BUCKETS - 1;
+  while (bucket > 0 && bucket_counts_[bucket] == 0) {
+    bucket--;
+  }
+  return bucket;
+}
+
+auto FreeSpaceMapPage::FindBucketAtLeast(uint8_t bucket) const -> std::optional<page_id_t> {
+  if (GetMaxBucket() < bucket) {
+    return std::nullopt;
+  }
+  for (uint32_t i = 0; i < FSM_PAGE_CAPACITY; i++) {
+    if (buckets_[i] >= bucket) {
+      return first_page_id_ + static_cast<page_id_t>(i);
+    }
+  }
+  UNREACHABLE("bucket counts do not match the entries");
+}
+
+}  // namespace bustub
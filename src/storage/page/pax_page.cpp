@@ -0,0 +1,170 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// pax_page.cpp
+//
+// Identification: src/storage/page/pax_page.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/page/pax_page.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/exception.h"
+#include "common/macros.h"
+
+namespace bustub {
+
+/** Minipages start at a multiple of this, so that their values are aligned */
+static constexpr uint32_t PAX_MINIPAGE_ALIGNMENT = 8;
+
+/** @return the bytes a VARCHAR value takes once serialized: its length, then its data */
+static auto SerializedSize(const Value &value) -> uint32_t {
+  auto len = value.GetLength();
+  return sizeof(uint32_t) + (len == BUSTUB_VALUE_NULL ? 0 : len);
+}
+
+auto PaxPage::EntrySize(const Column &column) -> uint32_t {
+  return column.IsInlined() ? column.GetFixedLength() : sizeof(uint16_t);
+}
+
+auto PaxPage::Capacity(const Schema &schema) -> uint16_t {
+  size_t tuple_size = TUPLE_META_SIZE;
+  for (const auto &column : schema.GetColumns()) {
+    tuple_size += EntrySize(column);
+    if (!column.IsInlined()) {
+      tuple_size += sizeof(uint32_t) + std::min(column.GetVariableLength(), PAX_VARCHAR_ESTIMATE);
+    }
+  }
+  auto alignment_slack = PAX_MINIPAGE_ALIGNMENT * (schema.GetColumnCount() + 1);
+  if (PAX_PAGE_HEADER_SIZE + alignment_slack >= BUSTUB_PAGE_SIZE) {
+    return 0;
+  }
+  return static_cast<uint16_t>((BUSTUB_PAGE_SIZE - PAX_PAGE_HEADER_SIZE - alignment_slack) / tuple_size);
+}
+
+auto PaxPage::MinipageOffsets(const Schema &schema, uint16_t capacity) -> std::vector<uint32_t> {
+  std::vector<uint32_t> offsets;
+  offsets.reserve(schema.GetColumnCount() + 1);
+  uint32_t offset = PAX_PAGE_HEADER_SIZE + TUPLE_META_SIZE * capacity;
+  for (const auto &column : schema.GetColumns()) {
+    offset = (offset + PAX_MINIPAGE_ALIGNMENT - 1) / PAX_MINIPAGE_ALIGNMENT * PAX_MINIPAGE_ALIGNMENT;
+    offsets.push_back(offset);
+    offset += EntrySize(column) * capacity;
+  }
+  offsets.push_back(offset);
+  return offsets;
+}
+
+auto PaxPage::VarcharSize(const Schema &schema, const Tuple &tuple) -> uint32_t {
+  uint32_t size = 0;
+  for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+    if (!schema.GetColumn(i).IsInlined()) {
+      size += SerializedSize(tuple.GetValue(&schema, i));
+    }
+  }
+  return size;
+}
+
+auto PaxPage::FitsEmptyPage(const Schema &schema, uint16_t capacity, const Tuple &tuple) -> bool {
+  return MinipageOffsets(schema, capacity).back() + VarcharSize(schema, tuple) <= BUSTUB_PAGE_SIZE;
+}
+
+void PaxPage::Init(uint16_t capacity) {
+  next_page_id_ = INVALID_PAGE_ID;
+  num_tuples_ = 0;
+  num_deleted_tuples_ = 0;
+  capacity_ = capacity;
+  varchar_pointer_ = BUSTUB_PAGE_SIZE;
+  reserved_ = 0;
+}
+
+auto PaxPage::InsertTuple(const Schema &schema, const TupleMeta &meta, const Tuple &tuple) -> std::optional<uint16_t> {
+  if (num_tuples_ == capacity_) {
+    return std::nullopt;
+  }
+  auto offsets = MinipageOffsets(schema, capacity_);
+  if (offsets.back() + VarcharSize(schema, tuple) > varchar_pointer_) {
+    return std::nullopt;
+  }
+
+  auto slot_id = num_tuples_;
+  for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+    const auto &column = schema.GetColumn(i);
+    auto value = tuple.GetValue(&schema, i);
+    char *entry = page_start_ + offsets[i] + EntrySize(column) * slot_id;
+    if (column.IsInlined()) {
+      value.SerializeTo(entry);
+    } else {
+      varchar_pointer_ -= SerializedSize(value);
+      value.SerializeTo(page_start_ + varchar_pointer_);
+      memcpy(entry, &varchar_pointer_, sizeof(uint16_t));
+    }
+  }
+  tuple_metas_[slot_id] = meta;
+  if (meta.is_deleted_) {
+    num_deleted_tuples_++;
+  }
+  num_tuples_++;
+  return slot_id;
+}
+
+void PaxPage::UpdateTupleMeta(const TupleMeta &meta, const RID &rid) {
+  auto slot_id = rid.GetSlotNum();
+  if (slot_id >= num_tuples_) {
+    throw bustub::Exception("Tuple ID out of range");
+  }
+  if (!tuple_metas_[slot_id].is_deleted_ && meta.is_deleted_) {
+    num_deleted_tuples_++;
+  }
+  tuple_metas_[slot_id] = meta;
+}
+
+auto PaxPage::GetTupleMeta(const RID &rid) const -> TupleMeta {
+  auto slot_id = rid.GetSlotNum();
+  if (slot_id >= num_tuples_) {
+    throw bustub::Exception("Tuple ID out of range");
+  }
+  return tuple_metas_[slot_id];
+}
+
+auto PaxPage::ReadValue(const Column &column, uint32_t minipage_offset, uint32_t slot) const -> Value {
+  const char *entry = page_start_ + minipage_offset + EntrySize(column) * slot;
+  if (column.IsInlined()) {
+    return Value::DeserializeFrom(entry, column.GetType());
+  }
+  uint16_t varchar_offset;
+  memcpy(&varchar_offset, entry, sizeof(uint16_t));
+  return Value::DeserializeFrom(page_start_ + varchar_offset, column.GetType());
+}
+
+auto PaxPage::GetTuple(const Schema &schema, const RID &rid) const -> std::pair<TupleMeta, Tuple> {
+  auto slot_id = rid.GetSlotNum();
+  if (slot_id >= num_tuples_) {
+    throw bustub::Exception("Tuple ID out of range");
+  }
+  auto offsets = MinipageOffsets(schema, capacity_);
+  std::vector<Value> values;
+  values.reserve(schema.GetColumnCount());
+  for (uint32_t i = 0; i < schema.GetColumnCount(); i++) {
+    values.push_back(ReadValue(schema.GetColumn(i), offsets[i], slot_id));
+  }
+  Tuple tuple(std::move(values), &schema);
+  return std::make_pair(tuple_metas_[slot_id], std::move(tuple));
+}
+
+void PaxPage::GetColumn(const Schema &schema, uint32_t column_idx, uint32_t count, std::vector<Value> *values) const {
+  BUSTUB_ASSERT(count <= num_tuples_, "Tuple ID out of range");
+  const auto &column = schema.GetColumn(column_idx);
+  auto minipage_offset = MinipageOffsets(schema, capacity_)[column_idx];
+  for (uint32_t slot = 0; slot < count; slot++) {
+    values->push_back(ReadValue(column, minipage_offset, slot));
+  }
+}
+
+}  // namespace bustub
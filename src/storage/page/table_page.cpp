@@ -12,12 +12,15 @@
 
 #include "storage/page/table_page.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <optional>
 #include <tuple>
+#include <vector>
 #include "common/config.h"
 #include "common/exception.h"
+#include "common/macros.h"
 #include "storage/table/tuple.h"
 
 namespace bustub {
@@ -26,22 +29,28 @@ void TablePage::Init() {
   next_page_id_ = INVALID_PAGE_ID;
   num_tuples_ = 0;
   num_deleted_tuples_ = 0;
+  free_space_pointer_ = BUSTUB_PAGE_SIZE;
+  deleted_bytes_ = 0;
+  num_free_slots_ = 0;
 }
 
 auto TablePage::GetNextTupleOffset(const TupleMeta &meta, const Tuple &tuple) const -> std::optional<uint16_t> {
-  size_t slot_end_offset;
-  if (num_tuples_ > 0) {
-    auto &[offset, size, meta] = tuple_info_[num_tuples_ - 1];
-    slot_end_offset = offset;
-  } else {
-    slot_end_offset = BUSTUB_PAGE_SIZE;
-  }
-  auto tuple_offset = slot_end_offset - tuple.GetLength();
-  auto offset_size = TABLE_PAGE_HEADER_SIZE + TUPLE_INFO_SIZE * (num_tuples_ + 1);
-  if (tuple_offset < offset_size) {
+  // a free slot is taken before the slot array grows
+  auto num_slots = num_free_slots_ > 0 ? num_tuples_ : num_tuples_ + 1;
+  auto offset_size = TABLE_PAGE_HEADER_SIZE + TUPLE_INFO_SIZE * num_slots;
+  if (free_space_pointer_ < offset_size + tuple.GetLength()) {
     return std::nullopt;
   }
-  return tuple_offset;
+  return free_space_pointer_ - tuple.GetLength();
+}
+
+auto TablePage::GetFreeSpace() const -> size_t {
+  auto free_space = free_space_pointer_ - TABLE_PAGE_HEADER_SIZE - TUPLE_INFO_SIZE * num_tuples_;
+  // the next insert may take a free slot
+  if (num_free_slots_ > 0) {
+    free_space += TUPLE_INFO_SIZE;
+  }
+  return free_space;
 }
 
 auto TablePage::InsertTuple(const TupleMeta &meta, const Tuple &tuple) -> std::optional<uint16_t> {
@@ -49,25 +58,86 @@ auto TablePage::InsertTuple(const TupleMeta &meta, const Tuple &tuple) -> std::o
   if (tuple_offset == std::nullopt) {
     return std::nullopt;
   }
-  auto tuple_id = num_tuples_;
+  uint16_t tuple_id = num_tuples_;
+  if (num_free_slots_ > 0) {
+    for (tuple_id = 0; tuple_id < num_tuples_; tuple_id++) {
+      auto &[offset, size, old_meta] = tuple_info_[tuple_id];
+      if (old_meta.is_deleted_ && size == 0) {
+        break;
+      }
+    }
+    BUSTUB_ASSERT(tuple_id < num_tuples_, "free slot count does not match the slots");
+    num_free_slots_--;
+    num_deleted_tuples_--;
+  } else {
+    num_tuples_++;
+  }
   tuple_info_[tuple_id] = std::make_tuple(*tuple_offset, tuple.GetLength(), meta);
-  num_tuples_++;
+  free_space_pointer_ = *tuple_offset;
   memcpy(page_start_ + *tuple_offset, tuple.data_.data(), tuple.GetLength());
   return tuple_id;
 }
 
+auto TablePage::Compact() -> bool {
+  if (deleted_bytes_ == 0) {
+    return false;
+  }
+  // move the tuples nearest to the end first, so that a tuple never overwrites one that has not moved yet
+  std::vector<uint16_t> live_tuples;
+  for (uint16_t tuple_id = 0; tuple_id < num_tuples_; tuple_id++) {
+    auto &[offset, size, meta] = tuple_info_[tuple_id];
+    if (!meta.is_deleted_) {
+      live_tuples.push_back(tuple_id);
+    } else if (size > 0) {
+      size = 0;
+      num_free_slots_++;
+    }
+  }
+  std::sort(live_tuples.begin(), live_tuples.end(),
+            [this](uint16_t a, uint16_t b) { return std::get<0>(tuple_info_[a]) > std::get<0>(tuple_info_[b]); });
+  size_t free_space_pointer = BUSTUB_PAGE_SIZE;
+  for (auto tuple_id : live_tuples) {
+    auto &[offset, size, meta] = tuple_info_[tuple_id];
+    free_space_pointer -= size;
+    memmove(page_start_ + free_space_pointer, page_start_ + offset, size);
+    offset = free_space_pointer;
+  }
+  free_space_pointer_ = free_space_pointer;
+  deleted_bytes_ = 0;
+  return true;
+}
+
+void TablePage::AccountDelete(const TupleMeta &old_meta, const TupleMeta &meta, uint16_t size) {
+  BUSTUB_ENSURE(!(old_meta.is_deleted_ && size == 0 && !meta.is_deleted_), "a compacted tuple cannot be revived");
+  if (!old_meta.is_deleted_ && meta.is_deleted_) {
+    num_deleted_tuples_++;
+    deleted_bytes_ += size;
+  } else if (old_meta.is_deleted_ && !meta.is_deleted_) {
+    // an aborted delete gives the tuple back its bytes
+    num_deleted_tuples_--;
+    deleted_bytes_ -= size;
+  }
+}
+
 void TablePage::UpdateTupleMeta(const TupleMeta &meta, const RID &rid) {
   auto tuple_id = rid.GetSlotNum();
   if (tuple_id >= num_tuples_) {
     throw bustub::Exception("Tuple ID out of range");
   }
   auto &[offset, size, old_meta] = tuple_info_[tuple_id];
-  if (!old_meta.is_deleted_ && meta.is_deleted_) {
-    num_deleted_tuples_++;
-  }
+  AccountDelete(old_meta, meta, size);
   tuple_info_[tuple_id] = std::make_tuple(offset, size, meta);
 }
 
+auto TablePage::GetTupleView(const RID &rid) const -> std::pair<TupleMeta, TupleView> {
+  auto tuple_id = rid.GetSlotNum();
+  if (tuple_id >= num_tuples_) {
+    throw bustub::Exception("Tuple ID out of range");
+  }
+  const auto &[offset, size, meta] = tuple_info_[tuple_id];
+  return std::make_pair(meta, TupleView(page_start_ + offset, size, rid));
+}
+
 auto TablePage::GetTuple(const RID &rid) const -> std::pair<TupleMeta, Tuple> {
   auto tuple_id = rid.GetSlotNum();
   if (tuple_id >= num_tuples_) {
@@ -99,9 +169,7 @@ void TablePage::UpdateTupleInPlaceUnsafe(const TupleMeta &meta, const Tuple &tup
   if (size != tuple.GetLength()) {
     throw bustub::Exception("Tuple size mismatch");
   }
-  if (!old_meta.is_deleted_ && meta.is_deleted_) {
-    num_deleted_tuples_++;
-  }
+  AccountDelete(old_meta, meta, size);
   tuple_info_[tuple_id] = std::make_tuple(offset, size, meta);
   memcpy(page_start_ + offset, tuple.data_.data(), tuple.GetLength());
 }
@@ -0,0 +1,112 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// free_space_map.cpp
+//
+// Identification: src/storage/table/free_space_map.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/free_space_map.h"
+
+#include <algorithm>
+
+#include "common/macros.h"
+
+namespace bustub {
+
+FreeSpaceMap::FreeSpaceMap(BufferPoolManager *bpm) : bpm_(bpm) {
+  NewMapPage(&first_page_id_).AsMut<FreeSpaceMapDirectoryPage>()->Init();
+}
+
+auto FreeSpaceMap::BucketOf(size_t free_bytes) -> uint8_t {
+  return std::min<size_t>(free_bytes / FSM_BUCKET_BYTES, FSM_NUM_BUCKETS - 1);
+}
+
+auto FreeSpaceMap::NewMapPage(page_id_t *page_id) -> WritePageGuard {
+  auto *page = bpm_->NewPage(page_id);
+  BUSTUB_ENSURE(*page_id != INVALID_PAGE_ID, "cannot allocate page");
+  page->WLatch();
+  return WritePageGuard{bpm_, page};
+}
+
+void FreeSpaceMap::Update(page_id_t page_id, size_t free_bytes) { SetBucket(page_id, BucketOf(free_bytes), true); }
+
+void FreeSpaceMap::Remove(page_id_t page_id) {
+  // a page id that is not in the table is in bucket 0, like a full page
+  SetBucket(page_id, 0, false);
+}
+
+void FreeSpaceMap::SetBucket(page_id_t page_id, uint8_t bucket, bool create) {
+  auto first_page_id = FreeSpaceMapPage::RangeOf(page_id);
+  std::scoped_lock guard(latch_);
+  auto dir_guard = bpm_->FetchPageWrite(first_page_id_);
+  std::optional<uint32_t> index;
+  while (true) {
+    index = dir_guard.As<FreeSpaceMapDirectoryPage>()->FindRange(first_page_id);
+    auto next_page_id = dir_guard.As<FreeSpaceMapDirectoryPage>()->GetNextPageId();
+    if (index.has_value() || next_page_id == INVALID_PAGE_ID) {
+      break;
+    }
+    dir_guard = bpm_->FetchPageWrite(next_page_id);
+  }
+
+  if (!index.has_value()) {
+    if (!create || bucket == 0) {
+      return;
+    }
+    // the range gets its map page, recorded in the last directory page
+    if (dir_guard.As<FreeSpaceMapDirectoryPage>()->IsFull()) {
+      page_id_t next_page_id = INVALID_PAGE_ID;
+      auto next_guard = NewMapPage(&next_page_id);
+      next_guard.AsMut<FreeSpaceMapDirectoryPage>()->Init();
+      dir_guard.AsMut<FreeSpaceMapDirectoryPage>()->SetNextPageId(next_page_id);
+      dir_guard = std::move(next_guard);
+    }
+    page_id_t map_page_id = INVALID_PAGE_ID;
+    auto map_guard = NewMapPage(&map_page_id);
+    auto map_page = map_guard.AsMut<FreeSpaceMapPage>();
+    map_page->Init(first_page_id);
+    map_page->SetBucket(page_id, bucket);
+    dir_guard.AsMut<FreeSpaceMapDirectoryPage>()->Append(first_page_id, map_page_id, bucket);
+    return;
+  }
+
+  auto map_guard = bpm_->FetchPageWrite(dir_guard.As<FreeSpaceMapDirectoryPage>()->MapPageIdAt(*index));
+  if (map_guard.As<FreeSpaceMapPage>()->GetBucket(page_id) == bucket) {
+    return;
+  }
+  auto map_page = map_guard.AsMut<FreeSpaceMapPage>();
+  map_page->SetBucket(page_id, bucket);
+  auto max_bucket = map_page->GetMaxBucket();
+  if (dir_guard.As<FreeSpaceMapDirectoryPage>()->MaxBucketAt(*index) != max_bucket) {
+    dir_guard.AsMut<FreeSpaceMapDirectoryPage>()->SetMaxBucket(*index, max_bucket);
+  }
+}
+
+auto FreeSpaceMap::FindPage(size_t size) -> std::optional<page_id_t> {
+  // round up, so that every page of the bucket surely has `size` bytes
+  auto bucket = (size + FSM_BUCKET_BYTES - 1) / FSM_BUCKET_BYTES;
+  if (bucket >= FSM_NUM_BUCKETS) {
+    return std::nullopt;
+  }
+  std::scoped_lock guard(latch_);
+  for (auto dir_page_id = first_page_id_; dir_page_id != INVALID_PAGE_ID;) {
+    auto dir_guard = bpm_->FetchPageRead(dir_page_id);
+    const auto *dir_page = dir_guard.As<FreeSpaceMapDirectoryPage>();
+    // the directory knows the largest bucket of each map page, so only one that surely has a match is read
+    if (auto index = dir_page->FindMaxBucketAtLeast(bucket); index.has_value()) {
+      auto map_guard = bpm_->FetchPageRead(dir_page->MapPageIdAt(*index));
+      auto page_id = map_guard.As<FreeSpaceMapPage>()->FindBucketAtLeast(bucket);
+      BUSTUB_ASSERT(page_id.has_value(), "the directory does not match the map page");
+      return page_id;
+    }
+    dir_page_id = dir_page->GetNextPageId();
+  }
+  return std::nullopt;
+}
+
+}  // namespace bustub
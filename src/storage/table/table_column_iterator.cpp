@@ -0,0 +1,75 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_column_iterator.cpp
+//
+// Identification: src/storage/table/table_column_iterator.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/table_column_iterator.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "storage/page/page_guard.h"
+#include "storage/page/pax_page.h"
+#include "storage/table/table_heap.h"
+
+namespace bustub {
+
+TableColumnIterator::TableColumnIterator(TableHeap *table_heap, std::vector<uint32_t> column_ids, RID stop_at_rid,
+                                         std::function<bool(page_id_t)> page_filter)
+    : table_heap_(table_heap),
+      column_ids_(std::move(column_ids)),
+      stop_at_rid_(stop_at_rid),
+      page_filter_(std::move(page_filter)),
+      columns_(column_ids_.size()) {
+  LoadPage(table_heap_->first_page_id_);
+}
+
+auto TableColumnIterator::operator++() -> TableColumnIterator & {
+  slot_++;
+  if (slot_ == metas_.size()) {
+    LoadPage(next_page_id_);
+  }
+  return *this;
+}
+
+void TableColumnIterator::LoadPage(page_id_t page_id) {
+  metas_.clear();
+  for (auto &column : columns_) {
+    column.clear();
+  }
+  slot_ = 0;
+
+  // pages may be empty, e.g. the first one of an empty table, or filtered out
+  while (page_id != INVALID_PAGE_ID) {
+    auto page_guard = table_heap_->bpm_->FetchPageRead(page_id);
+    const auto *page = page_guard.As<PaxPage>();
+    auto count = page->GetNumTuples();
+    if (page_id == stop_at_rid_.GetPageId()) {
+      count = std::min(count, stop_at_rid_.GetSlotNum());
+      next_page_id_ = INVALID_PAGE_ID;
+    } else {
+      next_page_id_ = page->GetNextPageId();
+    }
+    if (count > 0 && (page_filter_ == nullptr || page_filter_(page_id))) {
+      for (uint32_t slot = 0; slot < count; slot++) {
+        metas_.push_back(page->GetTupleMeta(RID{page_id, slot}));
+      }
+      for (size_t i = 0; i < column_ids_.size(); i++) {
+        page->GetColumn(*table_heap_->schema_, column_ids_[i], count, &columns_[i]);
+      }
+      page_id_ = page_id;
+      return;
+    }
+    page_id = next_page_id_;
+  }
+  page_id_ = INVALID_PAGE_ID;
+}
+
+}  // namespace bustub
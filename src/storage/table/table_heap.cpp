@@ -10,9 +10,15 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <functional>
+#include <memory>
 #include <mutex>  // NOLINT
+#include <thread>  // NOLINT
 #include <utility>
+#include <vector>
 
 #include "common/config.h"
 #include "common/exception.h"
@@ -20,89 +26,322 @@
 #include "common/macros.h"
 #include "concurrency/transaction.h"
 #include "fmt/format.h"
+#include "storage/page/overflow_page.h"
 #include "storage/page/page_guard.h"
+#include "storage/page/pax_page.h"
 #include "storage/page/table_page.h"
 #include "storage/table/table_heap.h"
+#include "type/value_factory.h"
 
 namespace bustub {
 
-TableHeap::TableHeap(BufferPoolManager *bpm) : bpm_(bpm) {
-  // Initialize the first table page.
-  auto guard = bpm->NewPageGuarded(&first_page_id_);
+/** @return whether `column_ids` holds `column_idx`, or is not given */
+static auto Reads(const std::vector<uint32_t> *column_ids, uint32_t column_idx) -> bool {
+  return column_ids == nullptr || std::find(column_ids->begin(), column_ids->end(), column_idx) != column_ids->end();
+}
+
+/** @return the pointer kept after the prefix of a value stored out of line, which starts at `value` */
+static auto ReadPointer(const char *value) -> OutOfLinePointer {
+  uint32_t prefix_size;
+  memcpy(&prefix_size, value, sizeof(uint32_t));
+  OutOfLinePointer pointer;
+  memcpy(&pointer, value + sizeof(uint32_t) + prefix_size, sizeof(OutOfLinePointer));
+  return pointer;
+}
+
+TableHeap::TableHeap(BufferPoolManager *bpm) : bpm_(bpm), free_space_map_(bpm) { InitFirstPage(); }
+
+TableHeap::TableHeap(BufferPoolManager *bpm, TableLayout layout, const Schema &schema)
+    : bpm_(bpm),
+      layout_(layout),
+      schema_(schema),
+      zone_map_(std::make_unique<ZoneMap>(schema)),
+      free_space_map_(bpm) {
+  if (layout_ == TableLayout::PAX) {
+    pax_capacity_ = PaxPage::Capacity(schema);
+    BUSTUB_ENSURE(pax_capacity_ > 0, "too many columns for the PAX layout");
+  }
+  InitFirstPage();
+}
+
+void TableHeap::InitFirstPage() {
+  auto guard = bpm_->NewPageGuarded(&first_page_id_);
   last_page_id_ = first_page_id_;
-  auto first_page = guard.AsMut<TablePage>();
-  BUSTUB_ASSERT(first_page != nullptr,
+  BUSTUB_ASSERT(first_page_id_ != INVALID_PAGE_ID,
                 "Couldn't create a page for the table heap. Have you completed the buffer pool manager project?");
+  if (layout_ == TableLayout::PAX) {
+    guard.AsMut<PaxPage>()->Init(pax_capacity_);
+    return;
+  }
+  auto first_page = guard.AsMut<TablePage>();
   first_page->Init();
+  free_space_map_.Update(first_page_id_, first_page->GetFreeSpace());
+}
+
+void TableHeap::AddToZone(page_id_t page_id, const Tuple &tuple) {
+  if (zone_map_ != nullptr) {
+    zone_map_->Add(page_id, tuple);
+  }
+}
+
+auto TableHeap::InsertIntoPage(WritePageGuard *page_guard, const TupleMeta &meta, const Tuple &stored,
+                               const Tuple &tuple) -> std::optional<uint16_t> {
+  auto page = page_guard->AsMut<TablePage>();
+  auto slot_id = page->InsertTuple(meta, stored);
+  // widen the zone while the page is still latched, before a scan can meet the tuple
+  if (slot_id != std::nullopt) {
+    AddToZone(page_guard->PageId(), tuple);
+  }
+  free_space_map_.Update(page_guard->PageId(), page->GetFreeSpace());
+  return slot_id;
+}
+
+auto TableHeap::CompactPage(page_id_t page_id, TablePage *page) -> bool {
+  // the deleted tuples that are still in the page go, and the values they store out of line with them
+  std::vector<page_id_t> released_page_ids;
+  if (schema_.has_value() && !schema_->GetUnlinedColumns().empty()) {
+    for (uint32_t slot_id = 0; slot_id < page->GetNumTuples(); slot_id++) {
+      auto [meta, view] = page->GetTupleView(RID{page_id, slot_id});
+      if (meta.is_deleted_) {
+        auto page_ids = OutOfLinePageIds(view);
+        released_page_ids.insert(released_page_ids.end(), page_ids.begin(), page_ids.end());
+      }
+    }
+  }
+  if (!page->Compact()) {
+    return false;
+  }
+  ReleaseOverflowPages(released_page_ids);
+  return true;
 }
 
 auto TableHeap::InsertTuple(const TupleMeta &meta, const Tuple &tuple, LockManager *lock_mgr, Transaction *txn,
                             table_oid_t oid) -> std::optional<RID> {
-  std::unique_lock<std::mutex> guard(latch_);
-  auto page_guard = bpm_->FetchPageWrite(last_page_id_);
-  while (true) {
-    auto page = page_guard.AsMut<TablePage>();
-    if (page->GetNextTupleOffset(meta, tuple) != std::nullopt) {
-      break;
+  if (layout_ == TableLayout::PAX) {
+    auto [page_id, slot_id] = InsertPaxTuple(meta, tuple);
+    if (lock_mgr != nullptr) {
+      BUSTUB_ENSURE(lock_mgr->LockRow(txn, LockManager::LockMode::EXCLUSIVE, oid, RID{page_id, slot_id}),
+                    "failed to lock when inserting new tuple");
     }
+    return RID(page_id, slot_id);
+  }
+
+  auto out_of_line = StoreOutOfLine(tuple);
+  const auto &stored = out_of_line.has_value() ? *out_of_line : tuple;
+  // even an empty page cannot take this tuple
+  auto fits = TABLE_PAGE_HEADER_SIZE + TablePage::RequiredSpace(stored) <= BUSTUB_PAGE_SIZE;
+  if (!fits) {
+    ReleaseOverflowPages(OutOfLinePageIds(TupleView(stored)));
+  }
+  BUSTUB_ENSURE(fits, "tuple is too large, cannot insert");
+
+  // each thread keeps inserting into the page of its own target, so that concurrent inserts rarely meet
+  auto &target = insert_targets_[std::hash<std::thread::id>{}(std::this_thread::get_id()) % INSERT_TARGET_COUNT];
+  std::unique_lock<std::mutex> target_guard(target.latch_);
 
-    // if there's no tuple in the page, and we can't insert the tuple, then this tuple is too large.
-    BUSTUB_ENSURE(page->GetNumTuples() != 0, "tuple is too large, cannot insert");
+  WritePageGuard page_guard;
+  std::optional<uint16_t> slot_id;
+  if (target.page_id_ != INVALID_PAGE_ID) {
+    page_guard = bpm_->FetchPageWrite(target.page_id_);
+    slot_id = InsertIntoPage(&page_guard, meta, stored, tuple);
+  }
 
+  // reuse the room left in another page before growing the table
+  while (slot_id == std::nullopt) {
+    auto free_page_id = free_space_map_.FindPage(TablePage::RequiredSpace(stored));
+    if (free_page_id == std::nullopt) {
+      break;
+    }
+    page_guard.Drop();
+    page_guard = bpm_->FetchPageWrite(*free_page_id);
+    target.page_id_ = *free_page_id;
+    slot_id = InsertIntoPage(&page_guard, meta, stored, tuple);
+  }
+
+  if (slot_id == std::nullopt) {
+    page_guard.Drop();
     page_id_t next_page_id = INVALID_PAGE_ID;
     auto npg = bpm_->NewPage(&next_page_id);
     BUSTUB_ENSURE(next_page_id != INVALID_PAGE_ID, "cannot allocate page");
+    reinterpret_cast<TablePage *>(npg->GetData())->Init();
+    npg->WLatch();
+    page_guard = WritePageGuard{bpm_, npg};
+    slot_id = InsertIntoPage(&page_guard, meta, stored, tuple);
+    BUSTUB_ASSERT(slot_id != std::nullopt, "an empty page should take the tuple");
+    target.page_id_ = next_page_id;
+    // Link the page only once it holds the tuple, so that a scan never meets an empty page. The chain is the only
+    // thing all inserts share.
+    page_guard.Drop();
+    AppendPages(next_page_id, next_page_id);
+  }
+  auto page_id = target.page_id_;
+  page_guard.Drop();
+  target_guard.unlock();
 
-    page->SetNextPageId(next_page_id);
+  if (lock_mgr != nullptr) {
+    BUSTUB_ENSURE(lock_mgr->LockRow(txn, LockManager::LockMode::EXCLUSIVE, oid, RID{page_id, *slot_id}),
+                  "failed to lock when inserting new tuple");
+  }
 
-    auto next_page = reinterpret_cast<TablePage *>(npg->GetData());
-    next_page->Init();
+  return RID(page_id, *slot_id);
+}
 
-    page_guard.Drop();
+auto TableHeap::InsertPaxTuple(const TupleMeta &meta, const Tuple &tuple) -> std::pair<page_id_t, uint16_t> {
+  BUSTUB_ENSURE(PaxPage::FitsEmptyPage(*schema_, pax_capacity_, tuple), "tuple is too large, cannot insert");
+  std::scoped_lock guard(latch_);
+  auto page_guard = bpm_->FetchPageWrite(last_page_id_);
+  auto slot_id = page_guard.AsMut<PaxPage>()->InsertTuple(*schema_, meta, tuple);
+  if (slot_id != std::nullopt) {
+    AddToZone(last_page_id_, tuple);
+    return {last_page_id_, *slot_id};
+  }
 
-    // acquire latch here as TSAN complains. Given we only have one insertion thread, this is fine.
-    npg->WLatch();
-    auto next_page_guard = WritePageGuard{bpm_, npg};
+  page_id_t next_page_id = INVALID_PAGE_ID;
+  auto npg = bpm_->NewPage(&next_page_id);
+  BUSTUB_ENSURE(next_page_id != INVALID_PAGE_ID, "cannot allocate page");
+  npg->WLatch();
+  WritePageGuard next_page_guard{bpm_, npg};
+  auto next_page = next_page_guard.AsMut<PaxPage>();
+  next_page->Init(pax_capacity_);
+  slot_id = next_page->InsertTuple(*schema_, meta, tuple);
+  BUSTUB_ASSERT(slot_id != std::nullopt, "an empty page should take the tuple");
+  AddToZone(next_page_id, tuple);
+  next_page_guard.Drop();
+  page_guard.AsMut<PaxPage>()->SetNextPageId(next_page_id);
+  last_page_id_ = next_page_id;
+  return {next_page_id, *slot_id};
+}
 
-    last_page_id_ = next_page_id;
-    page_guard = std::move(next_page_guard);
+void TableHeap::AppendPages(page_id_t first_page_id, page_id_t last_page_id) {
+  std::scoped_lock guard(latch_);
+  auto last_page_guard = bpm_->FetchPageWrite(last_page_id_);
+  last_page_guard.AsMut<TablePage>()->SetNextPageId(first_page_id);
+  last_page_id_ = last_page_id;
+}
+
+auto TableHeap::InsertTuples(const TupleMeta &meta, const std::vector<Tuple> &tuples) -> std::vector<RID> {
+  std::vector<RID> rids;
+  rids.reserve(tuples.size());
+  if (layout_ == TableLayout::PAX) {
+    // a PAX table only ever appends to its last page, which stays in the buffer pool
+    for (const auto &tuple : tuples) {
+      rids.push_back(*InsertTuple(meta, tuple));
+    }
+    return rids;
+  }
+  size_t required_space = 0;
+  for (const auto &tuple : tuples) {
+    required_space += TablePage::RequiredSpace(tuple);
+  }
+  // not worth new pages: fill the room left in the existing ones
+  if (TABLE_PAGE_HEADER_SIZE + required_space <= BUSTUB_PAGE_SIZE) {
+    for (const auto &tuple : tuples) {
+      rids.push_back(*InsertTuple(meta, tuple));
+    }
+    return rids;
   }
-  auto last_page_id = last_page_id_;
 
-  auto page = page_guard.AsMut<TablePage>();
-  auto slot_id = *page->InsertTuple(meta, tuple);
+  // the large values go out of line first, so that the tuples are sized as they are stored
+  std::vector<std::optional<Tuple>> out_of_line;
+  out_of_line.reserve(tuples.size());
+  bool fits = true;
+  for (const auto &tuple : tuples) {
+    out_of_line.push_back(StoreOutOfLine(tuple));
+    const auto &stored = out_of_line.back().has_value() ? *out_of_line.back() : tuple;
+    fits = fits && TABLE_PAGE_HEADER_SIZE + TablePage::RequiredSpace(stored) <= BUSTUB_PAGE_SIZE;
+  }
+  for (size_t i = 0; i < out_of_line.size() && !fits; i++) {
+    if (out_of_line[i].has_value()) {
+      ReleaseOverflowPages(OutOfLinePageIds(TupleView(*out_of_line[i])));
+    }
+  }
+  BUSTUB_ENSURE(fits, "tuple is too large, cannot insert");
 
-  // only allow one insertion at a time, otherwise it will deadlock.
-  guard.unlock();
+  auto buffer = std::make_unique<char[]>(BUSTUB_PAGE_SIZE);
+  auto local_page = reinterpret_cast<TablePage *>(buffer.get());
+  local_page->Init();
+  page_id_t page_id = INVALID_PAGE_ID;
+  auto page_guard = bpm_->NewPageGuarded(&page_id);
+  BUSTUB_ENSURE(page_id != INVALID_PAGE_ID, "cannot allocate page");
+  const page_id_t first_page_id = page_id;
+  std::vector<std::pair<page_id_t, size_t>> free_spaces;
 
-  if (lock_mgr != nullptr) {
-    BUSTUB_ENSURE(lock_mgr->LockRow(txn, LockManager::LockMode::EXCLUSIVE, oid, RID{last_page_id, slot_id}),
-                  "failed to lock when inserting new tuple");
+  for (size_t i = 0; i < tuples.size(); i++) {
+    const auto &tuple = tuples[i];
+    const auto &stored = out_of_line[i].has_value() ? *out_of_line[i] : tuple;
+    auto slot_id = local_page->InsertTuple(meta, stored);
+    if (slot_id == std::nullopt) {
+      // the local page is full: write it out, chained to the next one, and start over
+      page_id_t next_page_id = INVALID_PAGE_ID;
+      auto next_page_guard = bpm_->NewPageGuarded(&next_page_id);
+      BUSTUB_ENSURE(next_page_id != INVALID_PAGE_ID, "cannot allocate page");
+      local_page->SetNextPageId(next_page_id);
+      memcpy(page_guard.GetDataMut(), buffer.get(), BUSTUB_PAGE_SIZE);
+      free_spaces.emplace_back(page_id, local_page->GetFreeSpace());
+      page_guard = std::move(next_page_guard);
+      page_id = next_page_id;
+      local_page->Init();
+      slot_id = local_page->InsertTuple(meta, stored);
+      BUSTUB_ASSERT(slot_id != std::nullopt, "an empty page should take the tuple");
+    }
+    rids.emplace_back(page_id, *slot_id);
+    AddToZone(page_id, tuple);
   }
-
+  memcpy(page_guard.GetDataMut(), buffer.get(), BUSTUB_PAGE_SIZE);
+  free_spaces.emplace_back(page_id, local_page->GetFreeSpace());
   page_guard.Drop();
 
-  return RID(last_page_id, slot_id);
+  AppendPages(first_page_id, page_id);
+  // only now may other inserts find the new pages
+  for (const auto &[free_page_id, free_space] : free_spaces) {
+    free_space_map_.Update(free_page_id, free_space);
+  }
+  return rids;
 }
 
 void TableHeap::UpdateTupleMeta(const TupleMeta &meta, RID rid) {
   auto page_guard = bpm_->FetchPageWrite(rid.GetPageId());
+  if (layout_ == TableLayout::PAX) {
+    page_guard.AsMut<PaxPage>()->UpdateTupleMeta(meta, rid);
+    return;
+  }
   auto page = page_guard.AsMut<TablePage>();
   page->UpdateTupleMeta(meta, rid);
+  free_space_map_.Update(rid.GetPageId(), page->GetFreeSpace());
+}
+
+auto TableHeap::ReadTuple(ReadPageGuard *page_guard, RID rid) -> std::pair<TupleMeta, Tuple> {
+  if (layout_ == TableLayout::PAX) {
+    auto [meta, tuple] = page_guard->As<PaxPage>()->GetTuple(*schema_, rid);
+    tuple.rid_ = rid;
+    return std::make_pair(meta, std::move(tuple));
+  }
+  auto [meta, view] = page_guard->As<TablePage>()->GetTupleView(rid);
+  return std::make_pair(meta, FetchOutOfLine(view));
 }
 
 auto TableHeap::GetTuple(RID rid) -> std::pair<TupleMeta, Tuple> {
   auto page_guard = bpm_->FetchPageRead(rid.GetPageId());
-  auto page = page_guard.As<TablePage>();
-  auto [meta, tuple] = page->GetTuple(rid);
-  tuple.rid_ = rid;
-  return std::make_pair(meta, std::move(tuple));
+  return ReadTuple(&page_guard, rid);
+}
+
+void TableHeap::GetTuples(const std::vector<RID> &rids, std::vector<std::pair<TupleMeta, Tuple>> *tuples) {
+  if (rids.empty()) {
+    return;
+  }
+  auto page_guard = bpm_->FetchPageRead(rids[0].GetPageId());
+  for (const auto &rid : rids) {
+    BUSTUB_ASSERT(rid.GetPageId() == rids[0].GetPageId(), "rids should all be on the same page");
+    tuples->push_back(ReadTuple(&page_guard, rid));
+  }
 }
 
 auto TableHeap::GetTupleMeta(RID rid) -> TupleMeta {
   auto page_guard = bpm_->FetchPageRead(rid.GetPageId());
-  auto page = page_guard.As<TablePage>();
-  return page->GetTupleMeta(rid);
+  if (layout_ == TableLayout::PAX) {
+    return page_guard.As<PaxPage>()->GetTupleMeta(rid);
+  }
+  return page_guard.As<TablePage>()->GetTupleMeta(rid);
 }
 
 auto TableHeap::MakeIterator() -> TableIterator {
@@ -117,10 +356,288 @@ auto TableHeap::MakeIterator() -> TableIterator {
 
 auto TableHeap::MakeEagerIterator() -> TableIterator { return {this, {first_page_id_, 0}, {INVALID_PAGE_ID, 0}}; }
 
+auto TableHeap::MakeMorselIterators(size_t pages_per_morsel) -> std::vector<TableIterator> {
+  BUSTUB_ASSERT(pages_per_morsel > 0, "a morsel has at least one page");
+  std::unique_lock<std::mutex> guard(latch_);
+  auto last_page_id = last_page_id_;
+  guard.unlock();
+
+  // the page chain is walked once; each morsel stops after the last tuple its last page has now, like MakeIterator
+  std::vector<TableIterator> morsels;
+  auto morsel_first_page_id = first_page_id_;
+  size_t page_count = 0;
+  for (auto page_id = first_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page_guard = bpm_->FetchPageRead(page_id);
+    const auto *page = page_guard.As<TablePage>();
+    auto num_tuples = page->GetNumTuples();
+    auto next_page_id = page_id == last_page_id ? INVALID_PAGE_ID : page->GetNextPageId();
+    page_guard.Drop();
+    if (++page_count == pages_per_morsel || next_page_id == INVALID_PAGE_ID) {
+      morsels.emplace_back(this, RID{morsel_first_page_id, 0}, RID{page_id, num_tuples});
+      morsel_first_page_id = next_page_id;
+      page_count = 0;
+    }
+    page_id = next_page_id;
+  }
+  return morsels;
+}
+
+auto TableHeap::MakeColumnIterator(std::vector<uint32_t> column_ids, std::function<bool(page_id_t)> page_filter)
+    -> TableColumnIterator {
+  BUSTUB_ENSURE(layout_ == TableLayout::PAX, "only a PAX table can be scanned by column");
+  std::unique_lock<std::mutex> guard(latch_);
+  auto last_page_id = last_page_id_;
+  guard.unlock();
+
+  auto page_guard = bpm_->FetchPageRead(last_page_id);
+  auto page = page_guard.As<PaxPage>();
+  RID stop_at_rid{last_page_id, page->GetNumTuples()};
+  page_guard.Drop();
+  return {this, std::move(column_ids), stop_at_rid, std::move(page_filter)};
+}
+
 void TableHeap::UpdateTupleInPlaceUnsafe(const TupleMeta &meta, const Tuple &tuple, RID rid) {
+  BUSTUB_ENSURE(layout_ == TableLayout::ROW, "a PAX table cannot update in place");
+  auto out_of_line = StoreOutOfLine(tuple);
   auto page_guard = bpm_->FetchPageWrite(rid.GetPageId());
   auto page = page_guard.AsMut<TablePage>();
-  page->UpdateTupleInPlaceUnsafe(meta, tuple, rid);
+  // the values the old tuple stores out of line are released once it is overwritten
+  auto old_page_ids = OutOfLinePageIds(page->GetTupleView(rid).second);
+  page->UpdateTupleInPlaceUnsafe(meta, out_of_line.has_value() ? *out_of_line : tuple, rid);
+  AddToZone(rid.GetPageId(), tuple);
+  free_space_map_.Update(rid.GetPageId(), page->GetFreeSpace());
+  ReleaseOverflowPages(old_page_ids);
+}
+
+auto TableHeap::Vacuum(const std::function<void(const Tuple &tuple, RID old_rid, RID new_rid)> &on_move) -> size_t {
+  if (layout_ == TableLayout::PAX) {
+    return 0;
+  }
+  std::vector<std::unique_lock<std::mutex>> target_guards;
+  for (auto &target : insert_targets_) {
+    target_guards.emplace_back(target.latch_);
+    // the page may be released below
+    target.page_id_ = INVALID_PAGE_ID;
+  }
+  std::scoped_lock guard(latch_);
+
+  std::vector<page_id_t> page_ids;
+  for (auto page_id = first_page_id_; page_id != INVALID_PAGE_ID;) {
+    auto page_guard = bpm_->FetchPageWrite(page_id);
+    auto page = page_guard.AsMut<TablePage>();
+    CompactPage(page_id, page);
+    free_space_map_.Update(page_id, page->GetFreeSpace());
+    // the deleted tuples are gone, so the zone can be narrowed to the live ones
+    if (zone_map_ != nullptr) {
+      zone_map_->Remove(page_id);
+      for (uint32_t slot_id = 0; slot_id < page->GetNumTuples(); slot_id++) {
+        auto [meta, view] = page->GetTupleView(RID{page_id, slot_id});
+        if (!meta.is_deleted_) {
+          zone_map_->Add(page_id, FetchOutOfLine(view));
+        }
+      }
+    }
+    page_ids.push_back(page_id);
+    page_id = page->GetNextPageId();
+  }
+
+  // Empty the pages from the back into the room of the pages from the front, until the two meet. The first page is
+  // never released, as the catalog refers to it.
+  size_t last = page_ids.size() - 1;
+  size_t target = 0;
+  WritePageGuard target_guard;
+  page_id_t target_page_id = INVALID_PAGE_ID;
+  while (target < last) {
+    auto page_guard = bpm_->FetchPageWrite(page_ids[last]);
+    auto page = page_guard.AsMut<TablePage>();
+    bool is_empty = true;
+    for (uint32_t slot_id = 0; slot_id < page->GetNumTuples(); slot_id++) {
+      RID old_rid{page_ids[last], slot_id};
+      auto [meta, view] = page->GetTupleView(old_rid);
+      if (meta.is_deleted_) {
+        continue;
+      }
+      // the tuple moves as it is stored, its values out of line staying where they are
+      auto stored = view.Materialize();
+      auto tuple = HasOutOfLineValues(view, nullptr) ? FetchOutOfLine(view) : stored;
+      std::optional<uint16_t> new_slot_id;
+      while (new_slot_id == std::nullopt && target < last) {
+        if (target_page_id != page_ids[target]) {
+          target_guard.Drop();
+          target_guard = bpm_->FetchPageWrite(page_ids[target]);
+          target_page_id = page_ids[target];
+        }
+        new_slot_id = InsertIntoPage(&target_guard, meta, stored, tuple);
+        if (new_slot_id == std::nullopt) {
+          target++;
+        }
+      }
+      if (new_slot_id == std::nullopt) {
+        is_empty = false;
+        break;
+      }
+      meta.is_deleted_ = true;
+      page->UpdateTupleMeta(meta, old_rid);
+      on_move(tuple, old_rid, RID{page_ids[target], *new_slot_id});
+    }
+    if (!is_empty) {
+      // the overflow pages of the tuples moved away now belong to their new copies
+      page->Compact();
+      free_space_map_.Update(page_ids[last], page->GetFreeSpace());
+      break;
+    }
+    last--;
+  }
+  target_guard.Drop();
+
+  if (last + 1 == page_ids.size()) {
+    return 0;
+  }
+  {
+    auto page_guard = bpm_->FetchPageWrite(page_ids[last]);
+    page_guard.AsMut<TablePage>()->SetNextPageId(INVALID_PAGE_ID);
+  }
+  last_page_id_ = page_ids[last];
+  for (auto i = last + 1; i < page_ids.size(); i++) {
+    free_space_map_.Remove(page_ids[i]);
+    if (zone_map_ != nullptr) {
+      zone_map_->Remove(page_ids[i]);
+    }
+    bpm_->DeletePage(page_ids[i]);
+  }
+  return page_ids.size() - last - 1;
+}
+
+auto TableHeap::StoreOutOfLine(const Tuple &tuple) -> std::optional<Tuple> {
+  if (layout_ != TableLayout::ROW || !schema_.has_value()) {
+    return std::nullopt;
+  }
+  const auto &schema = *schema_;
+  TupleView view(tuple);
+  auto is_large = [&](uint32_t column_idx) {
+    uint32_t size;
+    memcpy(&size, view.GetDataPtr(&schema, column_idx), sizeof(uint32_t));
+    return size != BUSTUB_VALUE_NULL && size > OUT_OF_LINE_THRESHOLD && !view.IsOutOfLine(&schema, column_idx);
+  };
+  const auto &columns = schema.GetUnlinedColumns();
+  if (std::none_of(columns.begin(), columns.end(), is_large)) {
+    return std::nullopt;
+  }
+
+  // the fixed-size part stays as it is, and the varied-sized payloads are laid out again after it
+  Tuple stored(tuple.GetRid());
+  stored.data_.assign(tuple.GetData(), tuple.GetData() + schema.GetLength());
+  for (auto column_idx : columns) {
+    const char *value = view.GetDataPtr(&schema, column_idx);
+    uint32_t size;
+    memcpy(&size, value, sizeof(uint32_t));
+    uint32_t offset = stored.data_.size();
+    if (is_large(column_idx)) {
+      OutOfLinePointer pointer{WriteOverflowPages(value + sizeof(uint32_t), size), size};
+      // the prefix reads as a VARCHAR value of its own
+      uint32_t prefix_size = OUT_OF_LINE_PREFIX_SIZE + 1;
+      stored.data_.insert(stored.data_.end(), reinterpret_cast<const char *>(&prefix_size),
+                          reinterpret_cast<const char *>(&prefix_size) + sizeof(uint32_t));
+      stored.data_.insert(stored.data_.end(), value + sizeof(uint32_t),
+                          value + sizeof(uint32_t) + OUT_OF_LINE_PREFIX_SIZE);
+      stored.data_.push_back('\0');
+      stored.data_.insert(stored.data_.end(), reinterpret_cast<const char *>(&pointer),
+                          reinterpret_cast<const char *>(&pointer) + sizeof(OutOfLinePointer));
+      offset |= TUPLE_OUT_OF_LINE_FLAG;
+    } else if (view.IsOutOfLine(&schema, column_idx)) {
+      stored.data_.insert(stored.data_.end(), value, value + sizeof(uint32_t) + size + sizeof(OutOfLinePointer));
+      offset |= TUPLE_OUT_OF_LINE_FLAG;
+    } else {
+      stored.data_.insert(stored.data_.end(), value, value + sizeof(uint32_t) + (size == BUSTUB_VALUE_NULL ? 0 : size));
+    }
+    memcpy(stored.data_.data() + schema.GetColumn(column_idx).GetOffset(), &offset, sizeof(uint32_t));
+  }
+  return stored;
+}
+
+auto TableHeap::HasOutOfLineValues(const TupleView &view, const std::vector<uint32_t> *column_ids) const -> bool {
+  // the slot of a compacted tuple has no data left
+  if (!schema_.has_value() || view.GetLength() < schema_->GetLength()) {
+    return false;
+  }
+  for (auto column_idx : schema_->GetUnlinedColumns()) {
+    if (view.IsOutOfLine(&*schema_, column_idx) && Reads(column_ids, column_idx)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+auto TableHeap::FetchOutOfLine(const TupleView &view, const std::vector<uint32_t> *column_ids) -> Tuple {
+  if (!HasOutOfLineValues(view, column_ids)) {
+    return view.Materialize();
+  }
+  const auto &schema = *schema_;
+  std::vector<Value> values;
+  values.reserve(schema.GetColumnCount());
+  for (uint32_t column_idx = 0; column_idx < schema.GetColumnCount(); column_idx++) {
+    if (!view.IsOutOfLine(&schema, column_idx) || !Reads(column_ids, column_idx)) {
+      values.push_back(view.GetValue(&schema, column_idx));
+      continue;
+    }
+    auto pointer = ReadPointer(view.GetDataPtr(&schema, column_idx));
+    std::vector<char> data;
+    data.reserve(pointer.size_);
+    for (auto page_id = pointer.first_page_id_; page_id != INVALID_PAGE_ID;) {
+      auto page_guard = bpm_->FetchPageRead(page_id);
+      const auto *page = page_guard.As<OverflowPage>();
+      data.insert(data.end(), page->GetData(), page->GetData() + page->GetSize());
+      page_id = page->GetNextPageId();
+    }
+    BUSTUB_ASSERT(data.size() == pointer.size_, "the chain should hold the whole value");
+    values.push_back(ValueFactory::GetVarcharValue(data.data(), pointer.size_, true));
+  }
+  Tuple tuple(std::move(values), &schema);
+  tuple.rid_ = view.GetRid();
+  return tuple;
+}
+
+auto TableHeap::OutOfLinePageIds(const TupleView &view) const -> std::vector<page_id_t> {
+  std::vector<page_id_t> page_ids;
+  if (!HasOutOfLineValues(view, nullptr)) {
+    return page_ids;
+  }
+  for (auto column_idx : schema_->GetUnlinedColumns()) {
+    if (view.IsOutOfLine(&*schema_, column_idx)) {
+      page_ids.push_back(ReadPointer(view.GetDataPtr(&*schema_, column_idx)).first_page_id_);
+    }
+  }
+  return page_ids;
+}
+
+auto TableHeap::WriteOverflowPages(const char *data, uint32_t size) -> page_id_t {
+  page_id_t first_page_id = INVALID_PAGE_ID;
+  BasicPageGuard last_page_guard;
+  for (uint32_t offset = 0; offset < size; offset += OverflowPage::CAPACITY) {
+    page_id_t page_id = INVALID_PAGE_ID;
+    auto page_guard = bpm_->NewPageGuarded(&page_id);
+    BUSTUB_ENSURE(page_id != INVALID_PAGE_ID, "cannot allocate page");
+    page_guard.AsMut<OverflowPage>()->Init(data + offset, std::min(OverflowPage::CAPACITY, size - offset));
+    if (first_page_id == INVALID_PAGE_ID) {
+      first_page_id = page_id;
+    } else {
+      last_page_guard.AsMut<OverflowPage>()->SetNextPageId(page_id);
+    }
+    last_page_guard = std::move(page_guard);
+  }
+  return first_page_id;
+}
+
+void TableHeap::ReleaseOverflowPages(const std::vector<page_id_t> &first_page_ids) {
+  for (auto page_id : first_page_ids) {
+    while (page_id != INVALID_PAGE_ID) {
+      auto page_guard = bpm_->FetchPageRead(page_id);
+      auto next_page_id = page_guard.As<OverflowPage>()->GetNextPageId();
+      page_guard.Drop();
+      bpm_->DeletePage(page_id);
+      page_id = next_page_id;
+    }
+  }
 }
 
 }  // namespace bustub
@@ -10,25 +10,32 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cassert>
 #include <optional>
+#include <utility>
 
 #include "common/config.h"
 #include "common/exception.h"
 #include "concurrency/transaction.h"
+#include "storage/page/pax_page.h"
 #include "storage/table/table_heap.h"
 
 namespace bustub {
 
 TableIterator::TableIterator(TableHeap *table_heap, RID rid, RID stop_at_rid)
     : table_heap_(table_heap), rid_(rid), stop_at_rid_(stop_at_rid) {
-  // If the rid doesn't correspond to a tuple (i.e., the table has just been initialized), then
-  // we set rid_ to invalid.
-  auto page_guard = table_heap_->bpm_->FetchPageRead(rid_.GetPageId());
-  auto page = page_guard.As<TablePage>();
-  if (rid_.GetSlotNum() >= page->GetNumTuples()) {
-    rid_ = RID{INVALID_PAGE_ID, 0};
+  // If the rid doesn't correspond to a tuple (i.e., the table has just been initialized, or its first page was left
+  // empty by a bulk insert into new pages), then we move on to the next page, or set rid_ to invalid.
+  while (rid_.GetPageId() != INVALID_PAGE_ID && !(rid_ == stop_at_rid_)) {
+    auto page_guard = table_heap_->bpm_->FetchPageRead(rid_.GetPageId());
+    auto page = page_guard.As<TablePage>();
+    if (rid_.GetSlotNum() < page->GetNumTuples()) {
+      return;
+    }
+    rid_ = RID{page->GetNextPageId(), 0};
   }
+  rid_ = RID{INVALID_PAGE_ID, 0};
 }
 
 auto TableIterator::GetTuple() -> std::pair<TupleMeta, Tuple> { return table_heap_->GetTuple(rid_); }
@@ -43,10 +50,11 @@ auto TableIterator::operator++() -> TableIterator & {
   auto next_tuple_id = rid_.GetSlotNum() + 1;
 
   if (stop_at_rid_.GetPageId() != INVALID_PAGE_ID) {
+    // Concurrent inserts may link pages out of page id order, so only the page of the stop tuple can be checked.
     BUSTUB_ASSERT(
-        /* case 1: cursor before the page of the stop tuple */ rid_.GetPageId() < stop_at_rid_.GetPageId() ||
+        /* case 1: cursor on another page than the stop tuple */ rid_.GetPageId() != stop_at_rid_.GetPageId() ||
             /* case 2: cursor at the page before the tuple */
-            (rid_.GetPageId() == stop_at_rid_.GetPageId() && next_tuple_id <= stop_at_rid_.GetSlotNum()),
+            next_tuple_id <= stop_at_rid_.GetSlotNum(),
         "iterate out of bound");
   }
 
@@ -67,4 +75,67 @@ auto TableIterator::operator++() -> TableIterator & {
   return *this;
 }
 
+auto TableIterator::SkipPage() -> TableIterator & {
+  auto page_guard = table_heap_->bpm_->FetchPageRead(rid_.GetPageId());
+  MoveToNextPage(page_guard.As<TablePage>()->GetNextPageId());
+  return *this;
+}
+
+auto TableIterator::NextInPage(const std::function<bool(const TupleMeta &, const TupleView &)> &accept)
+    -> std::optional<Tuple> {
+  auto page_id = rid_.GetPageId();
+  auto page_guard = table_heap_->bpm_->FetchPageRead(page_id);
+  const auto *page = page_guard.As<TablePage>();
+  uint32_t end = page->GetNumTuples();
+  if (page_id == stop_at_rid_.GetPageId()) {
+    end = std::min(end, stop_at_rid_.GetSlotNum());
+  }
+
+  std::optional<Tuple> result;
+  auto slot_id = rid_.GetSlotNum();
+  for (; slot_id < end && result == std::nullopt; slot_id++) {
+    RID rid{page_id, slot_id};
+    if (table_heap_->layout_ == TableLayout::PAX) {
+      // a PAX page has no tuple to view in place, so it is gathered first
+      auto [meta, tuple] = page_guard.As<PaxPage>()->GetTuple(*table_heap_->schema_, rid);
+      tuple.rid_ = rid;
+      if (accept(meta, TupleView(tuple))) {
+        result = std::move(tuple);
+      }
+      continue;
+    }
+    auto [meta, view] = page->GetTupleView(rid);
+    const auto *column_ids = column_ids_.has_value() ? &*column_ids_ : nullptr;
+    if (!meta.is_deleted_ && table_heap_->HasOutOfLineValues(view, column_ids)) {
+      // the values stored out of line are read back in before `accept` sees the tuple
+      auto tuple = table_heap_->FetchOutOfLine(view, column_ids);
+      if (accept(meta, TupleView(tuple))) {
+        result = std::move(tuple);
+      }
+      continue;
+    }
+    if (accept(meta, view)) {
+      result = view.Materialize();
+    }
+  }
+
+  if (slot_id < end) {
+    rid_ = RID{page_id, slot_id};
+  } else {
+    MoveToNextPage(page->GetNextPageId());
+  }
+  return result;
+}
+
+void TableIterator::MoveToNextPage(page_id_t next_page_id) {
+  if (rid_.GetPageId() == stop_at_rid_.GetPageId()) {
+    rid_ = RID{INVALID_PAGE_ID, 0};
+    return;
+  }
+  rid_ = RID{next_page_id, 0};
+  if (rid_ == stop_at_rid_) {
+    rid_ = RID{INVALID_PAGE_ID, 0};
+  }
+}
+
 }  // namespace bustub
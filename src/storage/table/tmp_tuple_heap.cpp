@@ -0,0 +1,66 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tmp_tuple_heap.cpp
+//
+// Identification: src/storage/table/tmp_tuple_heap.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/tmp_tuple_heap.h"
+
+#include "common/exception.h"
+#include "storage/page/tmp_tuple_page.h"
+
+namespace bustub {
+
+TmpTupleHeap::~TmpTupleHeap() {
+  for (auto page_id : page_ids_) {
+    bpm_->DeletePage(page_id);
+  }
+}
+
+void TmpTupleHeap::Append(const Tuple &tuple) {
+  if (tuple.GetLength() > TmpTuplePage::MaxTupleSize(BUSTUB_PAGE_SIZE)) {
+    throw ExecutionException("tuple too large to be spilled");
+  }
+  TmpTuple tmp_tuple(INVALID_PAGE_ID, 0);
+  if (!page_ids_.empty()) {
+    auto *page = bpm_->FetchPage(page_ids_.back());
+    if (page == nullptr) {
+      throw ExecutionException("no frame left to spill to");
+    }
+    bool inserted = reinterpret_cast<TmpTuplePage *>(page)->Insert(tuple, &tmp_tuple);
+    bpm_->UnpinPage(page_ids_.back(), inserted);
+    if (inserted) {
+      tuple_count_++;
+      return;
+    }
+  }
+  page_id_t page_id;
+  auto *page = bpm_->NewPage(&page_id);
+  if (page == nullptr) {
+    throw ExecutionException("no frame left to spill to");
+  }
+  page_ids_.push_back(page_id);
+  auto *tmp_page = reinterpret_cast<TmpTuplePage *>(page);
+  tmp_page->Init(page_id, BUSTUB_PAGE_SIZE);
+  BUSTUB_ENSURE(tmp_page->Insert(tuple, &tmp_tuple), "a tuple no larger than MaxTupleSize fits in an empty page");
+  bpm_->UnpinPage(page_id, true);
+  tuple_count_++;
+}
+
+void TmpTupleHeap::ReadPage(size_t page_idx, std::vector<Tuple> *tuples) const {
+  auto page_id = page_ids_[page_idx];
+  auto *page = bpm_->FetchPage(page_id);
+  if (page == nullptr) {
+    throw ExecutionException("no frame left to read spilled tuples back");
+  }
+  reinterpret_cast<TmpTuplePage *>(page)->GetTuples(BUSTUB_PAGE_SIZE, tuples);
+  bpm_->UnpinPage(page_id, false);
+}
+
+}  // namespace bustub
@@ -20,8 +20,23 @@
 
 namespace bustub {
 
+/** @return the starting address of a column in the tuple data starting at `data` */
+static auto ColumnDataPtr(const char *data, const Schema *schema, const uint32_t column_idx) -> const char * {
+  assert(schema);
+  const auto &col = schema->GetColumn(column_idx);
+  bool is_inlined = col.IsInlined();
+  // For inline type, data is stored where it is.
+  if (is_inlined) {
+    return (data + col.GetOffset());
+  }
+  // We read the relative offset from the tuple data.
+  uint32_t offset = *reinterpret_cast<const uint32_t *>(data + col.GetOffset()) & ~TUPLE_OUT_OF_LINE_FLAG;
+  // And return the beginning address of the real data for the VARCHAR type.
+  return (data + offset);
+}
+
 // TODO(Amadou): It does not look like nulls are supported. Add a null bitmap?
-Tuple::Tuple(std::vector<Value> values, const Schema *schema) {
+Tuple::Tuple(std::vector<Value> values, const Schema *schema, Arena *arena) : data_(ArenaAllocator<char>(arena)) {
   assert(values.size() == schema->GetColumnCount());
 
   // 1. Calculate the size of the tuple.
@@ -68,7 +83,7 @@ auto Tuple::GetValue(const Schema *schema, const uint32_t column_idx) const -> V
   return Value::DeserializeFrom(data_ptr, column_type);
 }
 
-auto Tuple::KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs)
+auto Tuple::KeyFromTuple(const Schema &schema, const Schema &key_schema, const std::vector<uint32_t> &key_attrs) const
     -> Tuple {
   std::vector<Value> values;
   values.reserve(key_attrs.size());
@@ -79,17 +94,7 @@ auto Tuple::KeyFromTuple(const Schema &schema, const Schema &key_schema, const s
 }
 
 auto Tuple::GetDataPtr(const Schema *schema, const uint32_t column_idx) const -> const char * {
-  assert(schema);
-  const auto &col = schema->GetColumn(column_idx);
-  bool is_inlined = col.IsInlined();
-  // For inline type, data is stored where it is.
-  if (is_inlined) {
-    return (data_.data() + col.GetOffset());
-  }
-  // We read the relative offset from the tuple data.
-  int32_t offset = *reinterpret_cast<const int32_t *>(data_.data() + col.GetOffset());
-  // And return the beginning address of the real data for the VARCHAR type.
-  return (data_.data() + offset);
+  return ColumnDataPtr(data_.data(), schema, column_idx);
 }
 
 auto Tuple::ToString(const Schema *schema) const -> std::string {
@@ -129,4 +134,27 @@ void Tuple::DeserializeFrom(const char *storage) {
   memcpy(this->data_.data(), storage + sizeof(int32_t), size);
 }
 
+auto TupleView::GetValue(const Schema *schema, const uint32_t column_idx) const -> Value {
+  const TypeId column_type = schema->GetColumn(column_idx).GetType();
+  return Value::DeserializeFrom(ColumnDataPtr(data_, schema, column_idx), column_type);
+}
+
+auto TupleView::GetDataPtr(const Schema *schema, const uint32_t column_idx) const -> const char * {
+  return ColumnDataPtr(data_, schema, column_idx);
+}
+
+auto TupleView::IsOutOfLine(const Schema *schema, const uint32_t column_idx) const -> bool {
+  const auto &col = schema->GetColumn(column_idx);
+  if (col.IsInlined()) {
+    return false;
+  }
+  return (*reinterpret_cast<const uint32_t *>(data_ + col.GetOffset()) & TUPLE_OUT_OF_LINE_FLAG) != 0;
+}
+
+auto TupleView::Materialize() const -> Tuple {
+  Tuple tuple(rid_);
+  tuple.data_.assign(data_, data_ + size_);
+  return tuple;
+}
+
 }  // namespace bustub
@@ -0,0 +1,58 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// zone_map.cpp
+//
+// Identification: src/storage/table/zone_map.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/table/zone_map.h"
+
+namespace bustub {
+
+void ZoneMap::Add(page_id_t page_id, const Tuple &tuple) {
+  std::vector<Value> values;
+  values.reserve(schema_.GetColumnCount());
+  for (uint32_t i = 0; i < schema_.GetColumnCount(); i++) {
+    values.push_back(tuple.GetValue(&schema_, i));
+  }
+
+  std::scoped_lock guard(latch_);
+  auto &zone = zones_[page_id];
+  zone.columns_.resize(schema_.GetColumnCount());
+  for (uint32_t i = 0; i < values.size(); i++) {
+    auto &column = zone.columns_[i];
+    const auto &value = values[i];
+    if (value.IsNull()) {
+      column.null_count_++;
+    } else if (zone.AllNull(i)) {
+      column.min_ = value;
+      column.max_ = value;
+    } else if (value.CompareLessThan(column.min_) == CmpBool::CmpTrue) {
+      column.min_ = value;
+    } else if (value.CompareGreaterThan(column.max_) == CmpBool::CmpTrue) {
+      column.max_ = value;
+    }
+  }
+  zone.tuple_count_++;
+}
+
+void ZoneMap::Remove(page_id_t page_id) {
+  std::scoped_lock guard(latch_);
+  zones_.erase(page_id);
+}
+
+auto ZoneMap::Get(page_id_t page_id) const -> std::optional<PageZone> {
+  std::scoped_lock guard(latch_);
+  auto iter = zones_.find(page_id);
+  if (iter == zones_.end()) {
+    return std::nullopt;
+  }
+  return iter->second;
+}
+
+}  // namespace bustub
@@ -147,6 +147,17 @@ TEST(BinderTest, BindInsert) { TryBind("INSERT INTO y VALUES (1,2,3,4,5), (6,7,8
 
 TEST(BinderTest, BindInsertSelect) { TryBind("INSERT INTO y SELECT * FROM y WHERE x < 500"); }
 
+TEST(BinderTest, BindCopy) {
+  TryBind("COPY y FROM 'y.csv'");
+  TryBind("COPY c FROM 'c.csv' (FORMAT csv, DELIMITER '|', HEADER)");
+  TryBind("COPY c FROM 'c.csv' WITH CSV HEADER");
+  EXPECT_THROW(TryBind("COPY y TO 'y.csv'"), Exception);
+  EXPECT_THROW(TryBind("COPY y (x, z) FROM 'y.csv'"), Exception);
+  EXPECT_THROW(TryBind("COPY y FROM 'y.csv' (FORMAT binary)"), Exception);
+  EXPECT_THROW(TryBind("COPY y FROM 'y.csv' (DELIMITER '||')"), Exception);
+  EXPECT_THROW(TryBind("COPY zzzz FROM 'y.csv'"), Exception);
+}
+
 TEST(BinderTest, BindVarchar) {
   TryBind(R"(INSERT INTO c VALUES ('1', '2'))");
   TryBind(R"(INSERT INTO c VALUES ('', ''))");
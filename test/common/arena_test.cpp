@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// arena_test.cpp
+//
+// Identification: test/common/arena_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/arena.h"
+#include "common/bustub_instance.h"
+#include "gtest/gtest.h"
+#include "storage/table/tuple.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(ArenaTest, AllocateTest) {
+  Arena arena;
+  EXPECT_EQ(0, arena.GetBlockCount());
+
+  // small allocations share a block and respect their alignment
+  auto *a = static_cast<char *>(arena.Allocate(3, 1));
+  auto *b = arena.Allocate(8, 8);
+  EXPECT_EQ(0, reinterpret_cast<uintptr_t>(b) % 8);
+  EXPECT_LE(a + 3, static_cast<char *>(b));
+  EXPECT_EQ(1, arena.GetBlockCount());
+
+  // a large allocation gets a block of its own, and the current one keeps serving small ones
+  auto *large = static_cast<char *>(arena.Allocate(ARENA_BLOCK_SIZE * 2));
+  large[ARENA_BLOCK_SIZE * 2 - 1] = 'x';
+  EXPECT_EQ(2, arena.GetBlockCount());
+  arena.Allocate(8);
+  EXPECT_EQ(2, arena.GetBlockCount());
+
+  for (int i = 0; i < 1000; i++) {
+    arena.Allocate(1024);
+  }
+  EXPECT_EQ(1004, arena.GetAllocationCount());
+  EXPECT_LT(arena.GetBlockCount(), 20);
+}
+
+// NOLINTNEXTLINE
+TEST(ArenaTest, TupleTest) {
+  Arena arena;
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 32}});
+  std::vector<Value> values{ValueFactory::GetIntegerValue(42), ValueFactory::GetVarcharValue("arena")};
+
+  Tuple tuple(values, &schema, &arena);
+  EXPECT_EQ(1, arena.GetAllocationCount());
+  EXPECT_EQ(42, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+  EXPECT_EQ("arena", tuple.GetValue(&schema, 1).ToString());
+
+  // a copy outlives the arena, unless it is asked to allocate from one
+  auto copy = std::make_unique<Tuple>(tuple);
+  Tuple arena_copy(tuple, &arena);
+  EXPECT_EQ(2, arena.GetAllocationCount());
+  EXPECT_EQ("arena", arena_copy.GetValue(&schema, 1).ToString());
+
+  // assigning copies into the memory the tuple already has
+  Tuple heap_tuple(std::vector<Value>{ValueFactory::GetIntegerValue(1), ValueFactory::GetVarcharValue("x")}, &schema);
+  heap_tuple = std::move(arena_copy);
+  EXPECT_EQ(2, arena.GetAllocationCount());
+  EXPECT_EQ(42, heap_tuple.GetValue(&schema, 0).GetAs<int32_t>());
+
+  Tuple heap_copy = *copy;
+  copy.reset();
+  EXPECT_EQ("arena", heap_copy.GetValue(&schema, 1).ToString());
+}
+
+// NOLINTNEXTLINE
+TEST(ArenaTest, QueryArenaTest) {
+  auto instance = std::make_unique<BustubInstance>();
+  NoopWriter noop;
+  instance->ExecuteSql("CREATE TABLE t1 (v1 INT, v2 VARCHAR(16))", noop);
+  instance->ExecuteSql("INSERT INTO t1 VALUES (3, 'c'), (1, 'a'), (2, 'b')", noop);
+  instance->ExecuteSql("CREATE TABLE t2 (v1 INT)", noop);
+  instance->ExecuteSql("INSERT INTO t2 VALUES (1), (2), (2)", noop);
+
+  // the results of the materializing executors outlive the arena of their query, with or without it
+  for (const auto *arena : {"true", "false"}) {
+    instance->ExecuteSql(std::string("set query_arena=") + arena, noop);
+    EXPECT_EQ(std::string(arena) == "true", instance->IsQueryArenaEnabled());
+    std::stringstream ss;
+    auto writer = SimpleStreamWriter(ss, true, ",");
+    instance->ExecuteSql("SELECT * FROM t1 ORDER BY v1", writer);
+    instance->ExecuteSql("SELECT t1.v2, count(*) FROM t1 INNER JOIN t2 ON t1.v1 = t2.v1 GROUP BY t1.v2 ORDER BY t1.v2",
+                         writer);
+    EXPECT_EQ("1,a,\n2,b,\n3,c,\na,1,\nb,2,\n", ss.str());
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,91 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// copy_test.cpp
+//
+// Identification: test/common/copy_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "common/bustub_instance.h"
+#include "common/exception.h"
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+static const char *const CSV_FILE = "copy_test.csv";
+
+static auto Execute(BustubInstance *instance, const std::string &sql) -> std::string {
+  std::stringstream ss;
+  auto writer = SimpleStreamWriter(ss, true, ",");
+  instance->ExecuteSql(sql, writer);
+  return ss.str();
+}
+
+static void WriteCsv(const std::string &content) {
+  std::ofstream file(CSV_FILE, std::ios::trunc);
+  file << content;
+}
+
+// NOLINTNEXTLINE
+TEST(CopyTest, CopyFromCsvTest) {
+  auto instance = std::make_unique<BustubInstance>();
+  Execute(instance.get(), "CREATE TABLE t1 (v1 INT, v2 VARCHAR(32), v3 INT)");
+  Execute(instance.get(), "CREATE INDEX t1v1 ON t1(v1)");
+
+  // quoted fields may hold the delimiter, quotes and line breaks; an empty field is NULL
+  WriteCsv(
+      "v1|v2|v3\n"
+      "1|one|1\n"
+      "2|\"a|b\"|0\r\n"
+      "3|\"say \"\"hi\"\"\"|\n"
+      "4||1\n"
+      "5|\"two\n"
+      "lines\"|0\n");
+  EXPECT_EQ("Copied 5 rows,\n",
+            Execute(instance.get(), fmt::format("COPY t1 FROM '{}' (DELIMITER '|', HEADER)", CSV_FILE)));
+  EXPECT_EQ("1,one,1,\n", Execute(instance.get(), "SELECT * FROM t1 WHERE v1 = 1"));
+  EXPECT_EQ("2,a|b,0,\n", Execute(instance.get(), "SELECT * FROM t1 WHERE v1 = 2"));
+  EXPECT_EQ("3,say \"hi\",integer_null,\n", Execute(instance.get(), "SELECT * FROM t1 WHERE v1 = 3"));
+  EXPECT_EQ("4,varlen_null,1,\n", Execute(instance.get(), "SELECT * FROM t1 WHERE v1 = 4"));
+  EXPECT_EQ("5,two\nlines,0,\n", Execute(instance.get(), "SELECT * FROM t1 WHERE v1 = 5"));
+
+  // enough rows for several batches, each filling new pages and adding sorted entries to the index
+  std::string content;
+  for (int i = 20000; i > 5; i--) {
+    content += fmt::format("{},row {},{}\n", i, i, i % 2);
+  }
+  WriteCsv(content);
+  EXPECT_EQ("Copied 19995 rows,\n", Execute(instance.get(), fmt::format("COPY t1 FROM '{}'", CSV_FILE)));
+  EXPECT_EQ("20000,\n", Execute(instance.get(), "SELECT count(*) FROM t1"));
+  EXPECT_EQ("12345,row 12345,1,\n", Execute(instance.get(), "SELECT * FROM t1 WHERE v1 = 12345"));
+
+  remove(CSV_FILE);
+}
+
+// NOLINTNEXTLINE
+TEST(CopyTest, CopyErrorTest) {
+  auto instance = std::make_unique<BustubInstance>();
+  Execute(instance.get(), "CREATE TABLE t1 (v1 INT, v2 INT)");
+
+  WriteCsv("1,2\n3\n");
+  EXPECT_THROW(Execute(instance.get(), fmt::format("COPY t1 FROM '{}'", CSV_FILE)), Exception);
+  WriteCsv("1,2\n3,x\n");
+  EXPECT_THROW(Execute(instance.get(), fmt::format("COPY t1 FROM '{}'", CSV_FILE)), Exception);
+  WriteCsv("1,\"2\n");
+  EXPECT_THROW(Execute(instance.get(), fmt::format("COPY t1 FROM '{}'", CSV_FILE)), Exception);
+  remove(CSV_FILE);
+  EXPECT_THROW(Execute(instance.get(), fmt::format("COPY t1 FROM '{}'", CSV_FILE)), Exception);
+}
+
+}  // namespace bustub
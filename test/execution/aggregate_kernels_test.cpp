@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// aggregate_kernels_test.cpp
+//
+// Identification: test/execution/aggregate_kernels_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/bustub_instance.h"
+#include "execution/aggregate_kernels.h"
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(AggregateKernelsTest, KernelsTest) {
+  std::vector<Value> column{ValueFactory::GetIntegerValue(3), ValueFactory::GetNullValueByType(TypeId::INTEGER),
+                            ValueFactory::GetIntegerValue(-7), ValueFactory::GetIntegerValue(BUSTUB_INT32_MAX),
+                            ValueFactory::GetIntegerValue(0)};
+  std::vector<int64_t> values;
+  std::vector<uint8_t> nulls;
+  ASSERT_TRUE(GatherIntegers(column, TypeId::INTEGER, &values, &nulls));
+  EXPECT_EQ(4, CountKernel(nulls.data(), nulls.size()));
+  EXPECT_EQ(int64_t{BUSTUB_INT32_MAX} - 4, SumKernel(values.data(), nulls.data(), values.size()));
+  EXPECT_EQ(-7, MinKernel(values.data(), nulls.data(), values.size()));
+  EXPECT_EQ(BUSTUB_INT32_MAX, MaxKernel(values.data(), nulls.data(), values.size()));
+
+  // a null is never the min or the max, whatever it is gathered as
+  std::vector<Value> all_null(3, ValueFactory::GetNullValueByType(TypeId::BIGINT));
+  ASSERT_TRUE(GatherIntegers(all_null, TypeId::BIGINT, &values, &nulls));
+  EXPECT_EQ(0, CountKernel(nulls.data(), nulls.size()));
+  EXPECT_EQ(std::numeric_limits<int64_t>::max(), MinKernel(values.data(), nulls.data(), values.size()));
+  EXPECT_EQ(std::numeric_limits<int64_t>::min(), MaxKernel(values.data(), nulls.data(), values.size()));
+
+  // a column with a value of another type than the plan expects is left to the Values
+  column.push_back(ValueFactory::GetBigIntValue(1));
+  EXPECT_FALSE(GatherIntegers(column, TypeId::INTEGER, &values, &nulls));
+  EXPECT_FALSE(IsKernelInteger(TypeId::DECIMAL));
+}
+
+// NOLINTNEXTLINE
+TEST(AggregateKernelsTest, SameAsGroupedTest) {
+  auto instance = std::make_unique<BustubInstance>();
+  NoopWriter noop;
+  instance->ExecuteSql("CREATE TABLE t1 (v1 INT, v2 INT, g INT)", noop);
+  std::string insert = "INSERT INTO t1 VALUES (NULL, NULL, 0)";
+  for (int i = 1; i < 5000; i++) {
+    // every seventh v1 is null
+    insert += i % 7 == 0 ? fmt::format(", (NULL, {}, 0)", i)
+                         : fmt::format(", ({}, {}, 0)", (i * 7919) % 5000 - 2500, i);
+  }
+  instance->ExecuteSql(insert, noop);
+
+  auto query = [&instance](const std::string &sql) {
+    std::stringstream ss;
+    auto writer = SimpleStreamWriter(ss, true, ",");
+    instance->ExecuteSql(sql, writer);
+    return ss.str();
+  };
+
+  // grouping by a column with a single value aggregates the same rows without the kernels
+  auto aggregates = "count(*), count(v1), sum(v1), min(v1), max(v1), sum(v1 + v2), min(v2), max(v2)";
+  auto kernels = query(fmt::format("SELECT {} FROM t1", aggregates));
+  EXPECT_EQ(query(fmt::format("SELECT {} FROM t1 GROUP BY g", aggregates)), kernels);
+  EXPECT_EQ("5000,", kernels.substr(0, 5));
+  EXPECT_EQ(query(fmt::format("SELECT {} FROM t1 WHERE v2 > 4990 GROUP BY g", aggregates)),
+            query(fmt::format("SELECT {} FROM t1 WHERE v2 > 4990", aggregates)));
+  EXPECT_EQ("0,\n", query("SELECT count(*) FROM t1 WHERE v2 < 0"));
+  EXPECT_EQ("integer_null,\n", query("SELECT max(v1) FROM t1 WHERE v2 < 0"));
+
+  // a sum out of the range of its type is still an error, though each batch is summed into an int64
+  instance->ExecuteSql(fmt::format("INSERT INTO t1 VALUES ({}, 0, 0), ({}, 0, 0)", BUSTUB_INT32_MAX, BUSTUB_INT32_MAX),
+                       noop);
+  EXPECT_ANY_THROW(query("SELECT sum(v1) FROM t1"));
+}
+
+}  // namespace bustub
@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// external_sort_test.cpp
+//
+// Identification: test/execution/external_sort_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/bustub_instance.h"
+#include "execution/loser_tree.h"
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(ExternalSortTest, LoserTreeTest) {
+  for (size_t run_count = 1; run_count <= 9; run_count++) {
+    // run i holds the multiples of run_count plus i, so that merged they are every number once
+    std::vector<std::vector<int>> runs(run_count);
+    for (int i = 0; i < 100; i++) {
+      runs[i % run_count].push_back(i);
+    }
+    std::vector<size_t> pos(run_count, 0);
+    auto less = [&](size_t a, size_t b) {
+      if (pos[a] == runs[a].size()) {
+        return false;
+      }
+      return pos[b] == runs[b].size() || runs[a][pos[a]] < runs[b][pos[b]];
+    };
+    LoserTree<decltype(less)> tree(run_count, less);
+    for (int i = 0; i < 100; i++) {
+      auto top = tree.Top();
+      ASSERT_LT(pos[top], runs[top].size());
+      ASSERT_EQ(i, runs[top][pos[top]++]);
+      tree.Pop();
+    }
+    ASSERT_EQ(runs[tree.Top()].size(), pos[tree.Top()]);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(ExternalSortTest, SpillTest) {
+  auto instance = std::make_unique<BustubInstance>();
+  NoopWriter noop;
+  instance->ExecuteSql("CREATE TABLE t1 (v1 INT, v2 VARCHAR(16), v3 INT)", noop);
+  std::string insert = "INSERT INTO t1 VALUES (0, 'v0', 0)";
+  for (int i = 1; i < 20000; i++) {
+    insert += fmt::format(", ({}, 'v{}', {})", (i * 7919) % 20000, i % 7, i % 100);
+  }
+  instance->ExecuteSql(insert, noop);
+
+  auto query = [&instance](const std::string &sql) {
+    std::stringstream ss;
+    auto writer = SimpleStreamWriter(ss, true, ",");
+    instance->ExecuteSql(sql, writer);
+    return ss.str();
+  };
+
+  std::vector<std::string> queries{
+      "SELECT v1, v2 FROM t1 ORDER BY v1",
+      "SELECT v2, v1 FROM t1 WHERE v3 < 50 ORDER BY v2 DESC, v1",
+  };
+  std::vector<std::string> in_memory;
+  for (const auto &sql : queries) {
+    in_memory.push_back(query(sql));
+  }
+  ASSERT_EQ(20000, std::count(in_memory[0].begin(), in_memory[0].end(), '\n'));
+  ASSERT_EQ("0,v0,\n1,v", in_memory[0].substr(0, 9));
+
+  // runs of a few hundred tuples, spilled and merged
+  query("SET memory_budget = 32");
+  for (size_t i = 0; i < queries.size(); i++) {
+    EXPECT_EQ(in_memory[i], query(queries[i])) << queries[i];
+  }
+
+  // a run per worker, merged
+  query("SET memory_budget = 0");
+  query("SET parallelism = 4");
+  for (size_t i = 0; i < queries.size(); i++) {
+    EXPECT_EQ(in_memory[i], query(queries[i])) << queries[i];
+  }
+}
+
+}  // namespace bustub
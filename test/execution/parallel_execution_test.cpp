@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// parallel_execution_test.cpp
+//
+// Identification: test/execution/parallel_execution_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/bustub_instance.h"
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(ParallelExecutionTest, SameAsSerialTest) {
+  auto instance = std::make_unique<BustubInstance>();
+  NoopWriter noop;
+  instance->ExecuteSql("CREATE TABLE t1 (v1 INT, v2 VARCHAR(16), v3 INT)", noop);
+  instance->ExecuteSql("CREATE TABLE t2 (v1 INT, v2 INT)", noop);
+  // enough pages for many morsels, and rows out of order so that their order is checked
+  std::string insert_t1 = "INSERT INTO t1 VALUES (0, 'v0', 0)";
+  std::string insert_t2 = "INSERT INTO t2 VALUES (0, 0)";
+  for (int i = 1; i < 20000; i++) {
+    insert_t1 += fmt::format(", ({}, 'v{}', {})", (i * 7919) % 20000, i % 5, i);
+    if (i % 3 == 0) {
+      insert_t2 += fmt::format(", ({}, {})", i, i * 2);
+    }
+  }
+  instance->ExecuteSql(insert_t1, noop);
+  instance->ExecuteSql(insert_t2, noop);
+
+  auto query = [&instance](const std::string &sql) {
+    std::stringstream ss;
+    auto writer = SimpleStreamWriter(ss, true, ",");
+    instance->ExecuteSql(sql, writer);
+    return ss.str();
+  };
+
+  std::vector<std::string> queries{
+      "SELECT v1 + 1, v2 FROM t1 WHERE v1 >= 1000",
+      "SELECT * FROM t1",
+      // a gather left before its pipeline is done stops it
+      "SELECT v1, v3 FROM t1 WHERE v3 > 100 LIMIT 5",
+      "SELECT count(*), sum(v1), min(v3), max(v3) FROM t1 WHERE v3 < 15000",
+      "SELECT v2, count(*), sum(v1) FROM t1 GROUP BY v2 ORDER BY v2",
+      // more groups than a worker pre-aggregates before it flushes, and an aggregation over no row
+      "SELECT v1, count(*), sum(v3), min(v2), max(v3) FROM t1 GROUP BY v1 ORDER BY v1",
+      "SELECT count(*), count(v1), sum(v1), max(v2) FROM t1 WHERE v3 < 0",
+      "SELECT t1.v1, t2.v2 FROM t1 INNER JOIN t2 ON t1.v1 = t2.v1",
+      "SELECT t1.v3, t2.v2 FROM t1 LEFT JOIN t2 ON t1.v1 = t2.v1 WHERE t1.v3 < 5000",
+      "SELECT count(*) FROM t2 INNER JOIN t1 ON t2.v1 = t1.v1 WHERE t1.v2 = 'v3'",
+  };
+  std::vector<std::string> serial;
+  for (const auto &sql : queries) {
+    serial.push_back(query(sql));
+  }
+  ASSERT_EQ(19000, std::count(serial[0].begin(), serial[0].end(), '\n'));
+
+  query("SET parallelism = 4");
+  for (size_t i = 0; i < queries.size(); i++) {
+    EXPECT_EQ(serial[i], query(queries[i])) << queries[i];
+  }
+
+  // a pipeline under a delete or an update runs on the workers too
+  query("DELETE FROM t1 WHERE v3 >= 10000");
+  query("UPDATE t1 SET v2 = 'x' WHERE v1 < 100");
+  EXPECT_EQ("10000,\n", query("SELECT count(*) FROM t1"));
+  query("SET parallelism = 1");
+  EXPECT_EQ("10000,\n", query("SELECT count(*) FROM t1"));
+  EXPECT_EQ(query("SELECT count(*) FROM t1 WHERE v1 < 100 AND v3 < 10000"),
+            query("SELECT count(*) FROM t1 WHERE v2 = 'x'"));
+}
+
+}  // namespace bustub
@@ -0,0 +1,86 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// push_pipeline_test.cpp
+//
+// Identification: test/execution/push_pipeline_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/bustub_instance.h"
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(PushPipelineTest, SameAsPullTest) {
+  auto instance = std::make_unique<BustubInstance>();
+  NoopWriter noop;
+  instance->ExecuteSql("CREATE TABLE t1 (v1 INT, v2 VARCHAR(16), v3 INT)", noop);
+  instance->ExecuteSql("CREATE TABLE t2 (v1 INT, v2 INT)", noop);
+  std::string insert_t1 = "INSERT INTO t1 VALUES (0, 'v0', 0)";
+  std::string insert_t2 = "INSERT INTO t2 VALUES (0, 0)";
+  for (int i = 1; i < 10000; i++) {
+    insert_t1 += fmt::format(", ({}, 'v{}', {})", (i * 7919) % 10000, i % 5, i);
+    if (i % 3 == 0) {
+      insert_t2 += fmt::format(", ({}, {})", i, i * 2);
+    }
+  }
+  instance->ExecuteSql(insert_t1, noop);
+  instance->ExecuteSql(insert_t2, noop);
+
+  auto query = [&instance](const std::string &sql) {
+    std::stringstream ss;
+    auto writer = SimpleStreamWriter(ss, true, ",");
+    instance->ExecuteSql(sql, writer);
+    return ss.str();
+  };
+
+  std::vector<std::string> queries{
+      "SELECT v1 + 1, v2 FROM t1 WHERE v1 >= 1000",
+      "SELECT v2, count(*), sum(v1) FROM t1 WHERE v3 < 5000 GROUP BY v2 ORDER BY v2",
+      "SELECT t1.v1, t2.v2 FROM t1 INNER JOIN t2 ON t1.v1 = t2.v1 WHERE t2.v2 > 100",
+      "SELECT t1.v3, t2.v2 + 1 FROM t1 LEFT JOIN t2 ON t1.v1 = t2.v1 WHERE t1.v3 < 5000",
+      "SELECT t2.v2, count(*) FROM t1 INNER JOIN t2 ON t1.v1 = t2.v1 GROUP BY t2.v2 ORDER BY t2.v2",
+      "SELECT * FROM t1 INNER JOIN t2 ON t1.v1 = t2.v1 INNER JOIN t2 AS t3 ON t2.v2 = t3.v1",
+      "SELECT v1, v3 FROM t1 WHERE v2 = 'v3' ORDER BY v3 DESC LIMIT 20",
+      "SELECT v1 FROM t1 WHERE v3 > 100 LIMIT 5",
+      "SELECT * FROM (SELECT v2, max(v3) AS m FROM t1 GROUP BY v2) AS a INNER JOIN t1 ON a.m = t1.v3",
+  };
+  auto run_all = [&query, &queries](bool push_based) {
+    query(fmt::format("SET push_pipelines = {}", push_based));
+    std::vector<std::string> results;
+    for (const auto &sql : queries) {
+      results.push_back(query(sql));
+    }
+    return results;
+  };
+
+  auto pulled = run_all(false);
+  ASSERT_EQ(9000, std::count(pulled[0].begin(), pulled[0].end(), '\n'));
+  ASSERT_EQ(5, std::count(pulled.back().begin(), pulled.back().end(), '\n'));
+  auto pushed = run_all(true);
+  for (size_t i = 0; i < queries.size(); i++) {
+    EXPECT_EQ(pulled[i], pushed[i]) << queries[i];
+  }
+
+  // the probe side of the partitions a hash join spills is pushed once the rest of the left side is
+  query("SET memory_budget = 16");
+  pulled = run_all(false);
+  pushed = run_all(true);
+  for (size_t i = 0; i < queries.size(); i++) {
+    EXPECT_EQ(pulled[i], pushed[i]) << queries[i];
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,78 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// sort_key_test.cpp
+//
+// Identification: test/execution/sort_key_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "execution/sort_key.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+/** Expect the sort keys of `values`, given in the order they sort in, to be in that order too, ASC and DESC */
+static void ExpectSorted(const std::vector<Value> &values) {
+  for (size_t i = 0; i + 1 < values.size(); i++) {
+    SortKey asc_a;
+    SortKey asc_b;
+    AppendSortKey(values[i], OrderByType::ASC, &asc_a);
+    AppendSortKey(values[i + 1], OrderByType::ASC, &asc_b);
+    EXPECT_LT(asc_a, asc_b) << values[i].ToString() << " < " << values[i + 1].ToString();
+
+    SortKey desc_a;
+    SortKey desc_b;
+    AppendSortKey(values[i], OrderByType::DESC, &desc_a);
+    AppendSortKey(values[i + 1], OrderByType::DESC, &desc_b);
+    EXPECT_GT(desc_a, desc_b) << values[i].ToString() << " > " << values[i + 1].ToString();
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(SortKeyTest, OrderTest) {
+  ExpectSorted({ValueFactory::GetNullValueByType(TypeId::INTEGER), ValueFactory::GetIntegerValue(BUSTUB_INT32_MIN),
+                ValueFactory::GetIntegerValue(-256), ValueFactory::GetIntegerValue(-1),
+                ValueFactory::GetIntegerValue(0), ValueFactory::GetIntegerValue(1), ValueFactory::GetIntegerValue(255),
+                ValueFactory::GetIntegerValue(256), ValueFactory::GetIntegerValue(BUSTUB_INT32_MAX)});
+  ExpectSorted({ValueFactory::GetNullValueByType(TypeId::BIGINT), ValueFactory::GetBigIntValue(BUSTUB_INT64_MIN),
+                ValueFactory::GetBigIntValue(-(int64_t{1} << 40)), ValueFactory::GetBigIntValue(-1),
+                ValueFactory::GetBigIntValue(0), ValueFactory::GetBigIntValue(int64_t{1} << 40)});
+  ExpectSorted({ValueFactory::GetNullValueByType(TypeId::DECIMAL), ValueFactory::GetDecimalValue(-1e300),
+                ValueFactory::GetDecimalValue(-2.5), ValueFactory::GetDecimalValue(-0.001),
+                ValueFactory::GetDecimalValue(0), ValueFactory::GetDecimalValue(0.001),
+                ValueFactory::GetDecimalValue(2.5), ValueFactory::GetDecimalValue(1e300)});
+  ExpectSorted({ValueFactory::GetNullValueByType(TypeId::VARCHAR), ValueFactory::GetVarcharValue(""),
+                ValueFactory::GetVarcharValue(std::string("\0", 1)), ValueFactory::GetVarcharValue(std::string("a")),
+                ValueFactory::GetVarcharValue(std::string("a\0", 2)), ValueFactory::GetVarcharValue("a\x01"),
+                ValueFactory::GetVarcharValue("ab"), ValueFactory::GetVarcharValue("b"),
+                ValueFactory::GetVarcharValue("\xff")});
+  ExpectSorted({ValueFactory::GetNullValueByType(TypeId::BOOLEAN), ValueFactory::GetBooleanValue(false),
+                ValueFactory::GetBooleanValue(true)});
+}
+
+// NOLINTNEXTLINE
+TEST(SortKeyTest, MultipleOrderBysTest) {
+  // the values of a key never run into each other: a varchar that is a prefix of another sorts first, whatever follows
+  auto make_key = [](const std::string &a, int32_t b, OrderByType b_type) {
+    SortKey key;
+    AppendSortKey(ValueFactory::GetVarcharValue(a), OrderByType::ASC, &key);
+    AppendSortKey(ValueFactory::GetIntegerValue(b), b_type, &key);
+    return key;
+  };
+  EXPECT_LT(make_key("a", BUSTUB_INT32_MAX, OrderByType::ASC), make_key("ab", BUSTUB_INT32_MIN, OrderByType::ASC));
+  EXPECT_LT(make_key("a", BUSTUB_INT32_MIN, OrderByType::DESC), make_key("ab", BUSTUB_INT32_MAX, OrderByType::DESC));
+  EXPECT_LT(make_key("a", 2, OrderByType::ASC), make_key("a", 3, OrderByType::ASC));
+  EXPECT_LT(make_key("a", 3, OrderByType::DESC), make_key("a", 2, OrderByType::DESC));
+  EXPECT_EQ(make_key("a", 3, OrderByType::DESC), make_key("a", 3, OrderByType::DESC));
+}
+
+}  // namespace bustub
@@ -0,0 +1,124 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// tuple_batch_test.cpp
+//
+// Identification: test/execution/tuple_batch_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/bustub_instance.h"
+#include "execution/expressions/arithmetic_expression.h"
+#include "execution/expressions/column_value_expression.h"
+#include "execution/expressions/comparison_expression.h"
+#include "execution/expressions/constant_value_expression.h"
+#include "execution/tuple_batch.h"
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+// NOLINTNEXTLINE
+TEST(TupleBatchTest, BatchTest) {
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 32}});
+  TupleBatch batch(&schema);
+  EXPECT_TRUE(batch.IsEmpty());
+
+  for (int i = 0; i < static_cast<int>(TUPLE_BATCH_SIZE); i++) {
+    std::vector<Value> values{ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::to_string(i))};
+    if (i % 2 == 0) {
+      batch.AppendTuple(Tuple(values, &schema), RID(0, i));
+    } else {
+      batch.AppendRow(values, RID(0, i));
+    }
+  }
+  EXPECT_TRUE(batch.IsFull());
+  EXPECT_EQ("7", batch.GetValue(7, 1).ToString());
+  auto tuple = batch.GetTuple(9);
+  EXPECT_EQ(9, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+  EXPECT_EQ(RID(0, 9), tuple.GetRid());
+
+  // (a + 1) > 1000, evaluated over the whole batch
+  auto a = std::make_shared<ColumnValueExpression>(0, 0, TypeId::INTEGER);
+  auto one = std::make_shared<ConstantValueExpression>(ValueFactory::GetIntegerValue(1));
+  auto plus = std::make_shared<ArithmeticExpression>(a, one, ArithmeticType::Plus);
+  auto thousand = std::make_shared<ConstantValueExpression>(ValueFactory::GetIntegerValue(1000));
+  ComparisonExpression predicate(plus, thousand, ComparisonType::GreaterThan);
+  std::vector<Value> values;
+  predicate.EvaluateBatch(batch, &values);
+  ASSERT_EQ(TUPLE_BATCH_SIZE, values.size());
+
+  // a bare column is read in place, and any other expression is evaluated into the vector given
+  std::vector<Value> unused;
+  EXPECT_EQ(&batch.GetColumn(0), &a->EvaluateBatchRef(batch, &unused));
+  EXPECT_TRUE(unused.empty());
+  EXPECT_EQ(&values, &predicate.EvaluateBatchRef(batch, &values));
+
+  batch.Select(values);
+  ASSERT_EQ(TUPLE_BATCH_SIZE - 1000, batch.Size());
+  EXPECT_EQ(1000, batch.GetValue(0, 0).GetAs<int32_t>());
+  EXPECT_EQ("1023", batch.GetValue(batch.Size() - 1, 1).ToString());
+  EXPECT_EQ(RID(0, 1001), batch.GetRid(1));
+
+  batch.Truncate(3);
+  EXPECT_EQ(3, batch.Size());
+  EXPECT_EQ(1002, batch.GetTuple(2).GetValue(&schema, 0).GetAs<int32_t>());
+  batch.Clear();
+  EXPECT_TRUE(batch.IsEmpty());
+}
+
+// NOLINTNEXTLINE
+TEST(TupleBatchTest, NextBatchTest) {
+  auto instance = std::make_unique<BustubInstance>();
+  NoopWriter noop;
+  instance->ExecuteSql("CREATE TABLE t1 (v1 INT, v2 VARCHAR(16))", noop);
+  instance->ExecuteSql("CREATE TABLE t2 (v1 INT)", noop);
+  // enough rows for the executors to go through several batches
+  std::string insert_t1 = "INSERT INTO t1 VALUES (0, 'v0')";
+  std::string insert_t2 = "INSERT INTO t2 VALUES (0)";
+  for (int i = 1; i < 3000; i++) {
+    insert_t1 += fmt::format(", ({}, 'v{}')", i, i % 3);
+    if (i % 2 == 0) {
+      insert_t2 += fmt::format(", ({})", i);
+    }
+  }
+  instance->ExecuteSql(insert_t1, noop);
+  instance->ExecuteSql(insert_t2, noop);
+
+  auto query = [&instance](const std::string &sql) {
+    std::stringstream ss;
+    auto writer = SimpleStreamWriter(ss, true, ",");
+    instance->ExecuteSql(sql, writer);
+    return ss.str();
+  };
+
+  // seq scan, filter and projection
+  auto result = query("SELECT v1 + 1, v2 FROM t1 WHERE v1 >= 1000");
+  EXPECT_EQ(2000, std::count(result.begin(), result.end(), '\n'));
+  EXPECT_EQ("1001,v1,\n", result.substr(0, 9));
+
+  // aggregation
+  EXPECT_EQ("2000,1999000,\n", query("SELECT count(*), sum(v1) FROM t1 WHERE v1 < 2000"));
+  EXPECT_EQ("v0,1000,0,2997,\nv1,1000,1,2998,\nv2,1000,2,2999,\n",
+            query("SELECT v2, count(*), min(v1), max(v1) FROM t1 GROUP BY v2 ORDER BY v2"));
+
+  // limit, across batches
+  result = query("SELECT v1 FROM t1 LIMIT 1500");
+  EXPECT_EQ(1500, std::count(result.begin(), result.end(), '\n'));
+
+  // hash join, inner and left
+  EXPECT_EQ("1500,\n", query("SELECT count(*) FROM t1 INNER JOIN t2 ON t1.v1 = t2.v1"));
+  EXPECT_EQ("3000,1500,\n", query("SELECT count(*), count(t2.v1) FROM t1 LEFT JOIN t2 ON t1.v1 = t2.v1"));
+}
+
+}  // namespace bustub
@@ -227,4 +227,57 @@ TEST(BPlusTreeTests, InsertTest3) {
   delete transaction;
   delete bpm;
 }
+TEST(BPlusTreeTests, PathCacheLookupTest) {
+  // create KeyComparator and index schema
+  auto key_schema = ParseCreateStatement("a bigint");
+  GenericComparator<8> comparator(key_schema.get());
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto *bpm = new BufferPoolManager(50, disk_manager.get());
+  // create and fetch header_page
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  // create b+ tree, caching the top two levels
+  BPlusTree<GenericKey<8>, RID, GenericComparator<8>> tree("foo_pk", header_page->GetPageId(), bpm, comparator, 2, 3,
+                                                           2);
+  GenericKey<8> index_key;
+  RID rid;
+  // create transaction
+  auto *transaction = new Transaction(0);
+
+  std::vector<int64_t> keys;
+  for (int64_t i = 1; i <= 250; ++i) {
+    keys.emplace_back(2 * i);
+    keys.emplace_back(2 * i - 1);
+  }
+  std::vector<RID> rids;
+  // lookups in between inserts must see every structure change
+  for (size_t i = 0; i < keys.size(); ++i) {
+    rid.Set(static_cast<int32_t>(keys[i] >> 32), keys[i] & 0xFFFFFFFF);
+    index_key.SetFromInteger(keys[i]);
+    tree.Insert(index_key, rid, transaction);
+    for (size_t j = 0; j <= i; j += 7) {
+      rids.clear();
+      index_key.SetFromInteger(keys[j]);
+      ASSERT_TRUE(tree.GetValue(index_key, &rids));
+      ASSERT_EQ(rids.size(), 1);
+      ASSERT_EQ(rids[0].GetSlotNum(), keys[j]);
+    }
+  }
+
+  // removing keys rewrites separators in the cached internal pages
+  for (int64_t key = 1; key <= 20; ++key) {
+    index_key.SetFromInteger(key);
+    tree.Remove(index_key, transaction);
+  }
+  for (int64_t key = 1; key <= 500; ++key) {
+    rids.clear();
+    index_key.SetFromInteger(key);
+    EXPECT_EQ(tree.GetValue(index_key, &rids), key > 20);
+  }
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete transaction;
+  delete bpm;
+}
 }  // namespace bustub
@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// memcmp_key_test.cpp
+//
+// Identification: test/storage/memcmp_key_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/index/b_plus_tree.h"
+#include "storage/index/memcmp_key.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+/** Checks that encoding the ascending `values` gives strictly ascending keys. */
+static void CheckEncodedOrder(const Column &column, const std::vector<Value> &values) {
+  Schema key_schema({column});
+  MemcmpComparator<16> comparator(&key_schema);
+  std::vector<MemcmpKey<16>> keys(values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    keys[i].SetFromKey(Tuple({values[i]}, &key_schema), key_schema);
+  }
+  for (size_t i = 0; i + 1 < keys.size(); i++) {
+    EXPECT_EQ(-1, comparator(keys[i], keys[i + 1])) << values[i].ToString() << " vs " << values[i + 1].ToString();
+    EXPECT_EQ(1, comparator(keys[i + 1], keys[i]));
+    EXPECT_EQ(0, comparator(keys[i], keys[i]));
+  }
+}
+
+TEST(MemcmpKeyTest, EncodedOrderTest) {
+  CheckEncodedOrder(Column("a", TypeId::INTEGER),
+                    {ValueFactory::GetIntegerValue(BUSTUB_INT32_MIN + 1), ValueFactory::GetIntegerValue(-256),
+                     ValueFactory::GetIntegerValue(-1), ValueFactory::GetIntegerValue(0),
+                     ValueFactory::GetIntegerValue(1), ValueFactory::GetIntegerValue(256),
+                     ValueFactory::GetIntegerValue(BUSTUB_INT32_MAX)});
+  CheckEncodedOrder(Column("a", TypeId::BIGINT),
+                    {ValueFactory::GetBigIntValue(BUSTUB_INT64_MIN + 1), ValueFactory::GetBigIntValue(-(1LL << 40)),
+                     ValueFactory::GetBigIntValue(-1), ValueFactory::GetBigIntValue(0),
+                     ValueFactory::GetBigIntValue(1LL << 40), ValueFactory::GetBigIntValue(BUSTUB_INT64_MAX)});
+  CheckEncodedOrder(Column("a", TypeId::DECIMAL),
+                    {ValueFactory::GetDecimalValue(-1e10), ValueFactory::GetDecimalValue(-2.5),
+                     ValueFactory::GetDecimalValue(-0.5), ValueFactory::GetDecimalValue(0.0),
+                     ValueFactory::GetDecimalValue(0.5), ValueFactory::GetDecimalValue(2.5),
+                     ValueFactory::GetDecimalValue(1e10)});
+  CheckEncodedOrder(Column("a", TypeId::VARCHAR, 8),
+                    {ValueFactory::GetVarcharValue(""), ValueFactory::GetVarcharValue("a"),
+                     ValueFactory::GetVarcharValue("ab"), ValueFactory::GetVarcharValue("abc"),
+                     ValueFactory::GetVarcharValue("b"), ValueFactory::GetVarcharValue("zzzzzzzz")});
+}
+
+TEST(MemcmpKeyTest, CompositeKeyTest) {
+  Schema key_schema({Column("name", TypeId::VARCHAR, 8), Column("id", TypeId::INTEGER)});
+  ASSERT_EQ(12, MemcmpKeyEncoder::EncodedSize(key_schema));
+  MemcmpComparator<16> comparator(&key_schema);
+
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto *bpm = new BufferPoolManager(50, disk_manager.get());
+  page_id_t page_id;
+  auto header_page = bpm->NewPage(&page_id);
+  BPlusTree<MemcmpKey<16>, RID, MemcmpComparator<16>> tree("foo_pk", header_page->GetPageId(), bpm, comparator, 3, 4);
+  auto *transaction = new Transaction(0);
+
+  // insert (name, id) pairs out of order, the value remembers the insertion order
+  std::vector<std::pair<std::string, int32_t>> pairs;
+  for (const auto *name : {"carol", "", "bob", "alice", "bo", "bobby"}) {
+    for (int32_t id : {7, -3, 0, 42, -100}) {
+      pairs.emplace_back(name, id);
+    }
+  }
+  for (size_t i = 0; i < pairs.size(); i++) {
+    MemcmpKey<16> index_key;
+    index_key.SetFromKey(
+        Tuple({ValueFactory::GetVarcharValue(pairs[i].first), ValueFactory::GetIntegerValue(pairs[i].second)},
+              &key_schema),
+        key_schema);
+    ASSERT_TRUE(tree.Insert(index_key, RID(0, i), transaction));
+  }
+
+  // the tree orders by name first, then by id
+  auto expected = pairs;
+  std::sort(expected.begin(), expected.end());
+  size_t count = 0;
+  for (auto iter = tree.Begin(); !iter.IsEnd(); ++iter) {
+    ASSERT_LT(count, expected.size());
+    EXPECT_EQ(expected[count], pairs[(*iter).second.GetSlotNum()]);
+    count++;
+  }
+  EXPECT_EQ(expected.size(), count);
+
+  bpm->UnpinPage(HEADER_PAGE_ID, true);
+  delete transaction;
+  delete bpm;
+}
+
+}  // namespace bustub
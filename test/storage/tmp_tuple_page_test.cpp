@@ -10,20 +10,21 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <memory>
+#include <string>
 #include <vector>
 
+#include "buffer/buffer_pool_manager.h"
 #include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
 #include "storage/page/tmp_tuple_page.h"
+#include "storage/table/tmp_tuple_heap.h"
 #include "type/value_factory.h"
 
 namespace bustub {
 
 // NOLINTNEXTLINE
-TEST(TmpTuplePageTest, DISABLED_BasicTest) {
-  // There are many ways to do this assignment, and this is only one of them.
-  // If you don't like the TmpTuplePage idea, please feel free to delete this test case entirely.
-  // You will get full credit as long as you are correctly using a linear probe hash table.
-
+TEST(TmpTuplePageTest, BasicTest) {
   TmpTuplePage page{};
   page_id_t page_id = 15445;
   page.Init(page_id, BUSTUB_PAGE_SIZE);
@@ -46,6 +47,47 @@ TEST(TmpTuplePageTest, DISABLED_BasicTest) {
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + sizeof(page_id_t) + sizeof(lsn_t)), BUSTUB_PAGE_SIZE - 8);
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + BUSTUB_PAGE_SIZE - 8), 4);
   ASSERT_EQ(*reinterpret_cast<uint32_t *>(data + BUSTUB_PAGE_SIZE - 4), 123);
+  ASSERT_EQ(tmp_tuple, TmpTuple(page_id, BUSTUB_PAGE_SIZE - 8));
+
+  std::vector<Tuple> tuples;
+  page.GetTuples(BUSTUB_PAGE_SIZE, &tuples);
+  ASSERT_EQ(1, tuples.size());
+  ASSERT_EQ(123, tuples[0].GetValue(&schema, 0).GetAs<int32_t>());
+}
+
+// NOLINTNEXTLINE
+TEST(TmpTuplePageTest, HeapTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(5, disk_manager.get());
+  Schema schema({Column{"a", TypeId::INTEGER}, Column{"b", TypeId::VARCHAR, 64}});
+
+  {
+    // more pages than the buffer pool has frames, so that some are written to disk and read back
+    TmpTupleHeap heap(bpm.get());
+    for (int i = 0; i < 2000; i++) {
+      heap.Append(Tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(std::to_string(i))}, &schema));
+    }
+    ASSERT_EQ(2000, heap.GetTupleCount());
+    ASSERT_GT(heap.GetPageCount(), 5);
+
+    int next = 0;
+    for (size_t page_idx = 0; page_idx < heap.GetPageCount(); page_idx++) {
+      std::vector<Tuple> tuples;
+      heap.ReadPage(page_idx, &tuples);
+      for (const auto &tuple : tuples) {
+        ASSERT_EQ(next, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+        ASSERT_EQ(std::to_string(next), tuple.GetValue(&schema, 1).ToString());
+        next++;
+      }
+    }
+    ASSERT_EQ(2000, next);
+  }
+
+  // the pages of the heap are deleted along with it, so that all the frames are free
+  page_id_t page_id;
+  for (int i = 0; i < 5; i++) {
+    ASSERT_NE(nullptr, bpm->NewPage(&page_id));
+  }
 }
 
 }  // namespace bustub
@@ -0,0 +1,509 @@
+//===----------------------------------------------------------------------===//
+//
+//                         BusTub
+//
+// table_heap_test.cpp
+//
+// Identification: test/table/table_heap_test.cpp
+//
+// Copyright (c) 2015-2023, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "buffer/buffer_pool_manager.h"
+#include "fmt/format.h"
+#include "gtest/gtest.h"
+#include "storage/disk/disk_manager_memory.h"
+#include "storage/table/table_heap.h"
+#include "storage/table/tuple.h"
+#include "type/value_factory.h"
+
+namespace bustub {
+
+static auto CountPages(BufferPoolManager *bpm, const TableHeap &table) -> size_t {
+  size_t count = 0;
+  for (auto page_id = table.GetFirstPageId(); page_id != INVALID_PAGE_ID; count++) {
+    auto guard = bpm->FetchPageRead(page_id);
+    page_id = guard.As<TablePage>()->GetNextPageId();
+  }
+  return count;
+}
+
+/** @return the first column of every live tuple, in scan order */
+static auto ScanValues(TableHeap *table, const Schema &schema) -> std::vector<int32_t> {
+  std::vector<int32_t> values;
+  for (auto iter = table->MakeIterator(); !iter.IsEnd(); ++iter) {
+    auto [meta, tuple] = iter.GetTuple();
+    if (!meta.is_deleted_) {
+      values.push_back(tuple.GetValue(&schema, 0).GetAs<int32_t>());
+    }
+  }
+  return values;
+}
+
+static auto MakeTuple(const Schema &schema, int32_t value) -> Tuple {
+  return Tuple({ValueFactory::GetIntegerValue(value), ValueFactory::GetVarcharValue(std::string(24, 'x'))}, &schema);
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, FreeSpaceReuseTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(50, disk_manager.get());
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::VARCHAR, 32)});
+  TableHeap table(bpm.get());
+  const TupleMeta meta{INVALID_TXN_ID, INVALID_TXN_ID, false};
+  const TupleMeta deleted_meta{INVALID_TXN_ID, INVALID_TXN_ID, true};
+
+  // churn: keep every tenth tuple of each round, delete the rest
+  std::vector<RID> rids;
+  std::multiset<int32_t> expected;
+  size_t pages_after_first_round = 0;
+  for (int32_t round = 0; round < 10; round++) {
+    for (int32_t i = 0; i < 1000; i++) {
+      auto rid = table.InsertTuple(meta, MakeTuple(schema, round * 1000 + i));
+      ASSERT_TRUE(rid.has_value());
+      if (i % 10 == 0) {
+        expected.insert(round * 1000 + i);
+      } else {
+        rids.push_back(*rid);
+      }
+    }
+    for (auto rid : rids) {
+      table.UpdateTupleMeta(deleted_meta, rid);
+    }
+    rids.clear();
+    if (round == 0) {
+      pages_after_first_round = CountPages(bpm.get(), table);
+    }
+    table.Vacuum([](const Tuple &, RID, RID) {});
+  }
+
+  // The space of the deleted tuples was taken again instead of growing the table: at most 1900 tuples are live at
+  // once, where 10000 were inserted.
+  EXPECT_LE(CountPages(bpm.get(), table), 2 * pages_after_first_round);
+  auto values = ScanValues(&table, schema);
+  EXPECT_EQ(expected, std::multiset<int32_t>(values.begin(), values.end()));
+
+  // until a vacuum, an insert never takes the room of a deleted tuple, which an abort may still revive
+  std::vector<RID> deleted_rids;
+  for (int32_t i = 0; i < 1000; i++) {
+    deleted_rids.push_back(*table.InsertTuple(meta, MakeTuple(schema, 10000 + i)));
+  }
+  for (auto rid : deleted_rids) {
+    table.UpdateTupleMeta(deleted_meta, rid);
+  }
+  for (int32_t i = 0; i < 1000; i++) {
+    ASSERT_TRUE(table.InsertTuple(meta, MakeTuple(schema, 11000 + i)).has_value());
+    expected.insert(11000 + i);
+  }
+  for (int32_t i = 0; i < 1000; i++) {
+    table.UpdateTupleMeta(meta, deleted_rids[i]);
+    expected.insert(10000 + i);
+  }
+  values = ScanValues(&table, schema);
+  EXPECT_EQ(expected, std::multiset<int32_t>(values.begin(), values.end()));
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, VacuumTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(50, disk_manager.get());
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::VARCHAR, 32)});
+  TableHeap table(bpm.get());
+  const TupleMeta meta{INVALID_TXN_ID, INVALID_TXN_ID, false};
+  const TupleMeta deleted_meta{INVALID_TXN_ID, INVALID_TXN_ID, true};
+
+  std::vector<RID> rids;
+  for (int32_t i = 0; i < 2000; i++) {
+    rids.push_back(*table.InsertTuple(meta, MakeTuple(schema, i)));
+  }
+  auto pages_before = CountPages(bpm.get(), table);
+
+  // keep one tuple in five, spread over every page
+  std::multiset<int32_t> expected;
+  for (int32_t i = 0; i < 2000; i++) {
+    if (i % 5 == 0) {
+      expected.insert(i);
+    } else {
+      table.UpdateTupleMeta(deleted_meta, rids[i]);
+    }
+  }
+
+  std::set<int64_t> old_rids;
+  std::vector<std::pair<RID, int32_t>> moved;
+  auto released = table.Vacuum([&](const Tuple &tuple, RID old_rid, RID new_rid) {
+    EXPECT_TRUE(old_rids.insert(old_rid.Get()).second);
+    EXPECT_LT(new_rid.GetPageId(), old_rid.GetPageId());
+    moved.emplace_back(new_rid, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+  });
+  EXPECT_FALSE(moved.empty());
+  for (const auto &[new_rid, value] : moved) {
+    auto [new_meta, new_tuple] = table.GetTuple(new_rid);
+    EXPECT_FALSE(new_meta.is_deleted_);
+    EXPECT_EQ(value, new_tuple.GetValue(&schema, 0).GetAs<int32_t>());
+  }
+  auto pages_after = CountPages(bpm.get(), table);
+  EXPECT_GT(released, 0);
+  EXPECT_EQ(pages_before - released, pages_after);
+  EXPECT_LE(pages_after, pages_before / 4 + 1);
+
+  auto values = ScanValues(&table, schema);
+  EXPECT_EQ(expected, std::multiset<int32_t>(values.begin(), values.end()));
+
+  // the table keeps growing from its new last page
+  for (int32_t i = 2000; i < 3000; i++) {
+    ASSERT_TRUE(table.InsertTuple(meta, MakeTuple(schema, i)).has_value());
+    expected.insert(i);
+  }
+  values = ScanValues(&table, schema);
+  EXPECT_EQ(expected, std::multiset<int32_t>(values.begin(), values.end()));
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, BulkInsertTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(50, disk_manager.get());
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::VARCHAR, 32)});
+  TableHeap table(bpm.get());
+  const TupleMeta meta{INVALID_TXN_ID, INVALID_TXN_ID, false};
+
+  // a few tuples first go through the row path, into the first page
+  std::vector<Tuple> tuples;
+  for (int32_t i = 0; i < 10; i++) {
+    tuples.push_back(MakeTuple(schema, i));
+  }
+  auto rids = table.InsertTuples(meta, tuples);
+  ASSERT_EQ(10, rids.size());
+  EXPECT_EQ(1, CountPages(bpm.get(), table));
+
+  // many more fill new pages, more than the buffer pool holds
+  tuples.clear();
+  for (int32_t i = 10; i < 10000; i++) {
+    tuples.push_back(MakeTuple(schema, i));
+  }
+  rids = table.InsertTuples(meta, tuples);
+  ASSERT_EQ(tuples.size(), rids.size());
+  for (size_t i = 0; i < rids.size(); i++) {
+    EXPECT_EQ(10 + static_cast<int32_t>(i), table.GetTuple(rids[i]).second.GetValue(&schema, 0).GetAs<int32_t>());
+  }
+  // new pages are full but for the last one
+  auto tuples_per_page = (BUSTUB_PAGE_SIZE - TABLE_PAGE_HEADER_SIZE) / TablePage::RequiredSpace(tuples[0]);
+  EXPECT_EQ(2 + (tuples.size() - 1) / tuples_per_page, CountPages(bpm.get(), table));
+
+  auto values = ScanValues(&table, schema);
+  ASSERT_EQ(10000, values.size());
+  for (int32_t i = 0; i < 10000; i++) {
+    EXPECT_EQ(i, values[i]);
+  }
+
+  // later inserts fill the first page, then the room left in the last new page
+  auto pages = CountPages(bpm.get(), table);
+  for (int32_t i = 10000; i < 10000 + static_cast<int32_t>(tuples_per_page - 10 + 1); i++) {
+    ASSERT_TRUE(table.InsertTuple(meta, MakeTuple(schema, i)).has_value());
+  }
+  EXPECT_EQ(pages, CountPages(bpm.get(), table));
+
+  // the first page of a table bulk loaded from empty stays empty, and scans skip it
+  TableHeap bulk_table(bpm.get());
+  bulk_table.InsertTuples(meta, tuples);
+  values = ScanValues(&bulk_table, schema);
+  ASSERT_EQ(tuples.size(), values.size());
+  EXPECT_EQ(10, values.front());
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, ConcurrentInsertTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(50, disk_manager.get());
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::VARCHAR, 32)});
+  TableHeap table(bpm.get());
+  const TupleMeta meta{INVALID_TXN_ID, INVALID_TXN_ID, false};
+
+  const int32_t num_threads = 8;
+  const int32_t tuples_per_thread = 2000;
+  std::vector<std::thread> threads;
+  for (int32_t tid = 0; tid < num_threads; tid++) {
+    threads.emplace_back([&, tid] {
+      for (int32_t i = tid * tuples_per_thread; i < (tid + 1) * tuples_per_thread; i++) {
+        auto rid = table.InsertTuple(meta, MakeTuple(schema, i));
+        ASSERT_TRUE(rid.has_value());
+        EXPECT_EQ(i, table.GetTuple(*rid).second.GetValue(&schema, 0).GetAs<int32_t>());
+      }
+    });
+  }
+  // a scan running meanwhile only ever sees whole pages
+  for (int round = 0; round < 5; round++) {
+    auto values = ScanValues(&table, schema);
+    EXPECT_EQ(values.size(), std::set<int32_t>(values.begin(), values.end()).size());
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // every tuple is found exactly once by following the page chain
+  auto values = ScanValues(&table, schema);
+  ASSERT_EQ(num_threads * tuples_per_thread, values.size());
+  std::sort(values.begin(), values.end());
+  for (int32_t i = 0; i < num_threads * tuples_per_thread; i++) {
+    EXPECT_EQ(i, values[i]);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, PaxLayoutTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(50, disk_manager.get());
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::VARCHAR, 32), Column("c", TypeId::BIGINT)});
+  TableHeap table(bpm.get(), TableLayout::PAX, schema);
+  EXPECT_EQ(TableLayout::PAX, table.GetLayout());
+  const TupleMeta meta{INVALID_TXN_ID, INVALID_TXN_ID, false};
+  const TupleMeta deleted_meta{INVALID_TXN_ID, INVALID_TXN_ID, true};
+
+  // varchars of every length, so that some pages fill up by their varchar data before their capacity
+  std::vector<RID> rids;
+  for (int32_t i = 0; i < 5000; i++) {
+    auto value = i % 7 == 0 ? ValueFactory::GetNullValueByType(TypeId::VARCHAR)
+                            : ValueFactory::GetVarcharValue(std::string(i % 33, 'a' + i % 26));
+    Tuple tuple({ValueFactory::GetIntegerValue(i), value, ValueFactory::GetBigIntValue(int64_t{i} * 3)}, &schema);
+    auto rid = table.InsertTuple(meta, tuple);
+    ASSERT_TRUE(rid.has_value());
+    rids.push_back(*rid);
+  }
+  EXPECT_GT(CountPages(bpm.get(), table), 1);
+  for (int32_t i = 0; i < 5000; i += 13) {
+    auto [tuple_meta, tuple] = table.GetTuple(rids[i]);
+    EXPECT_FALSE(tuple_meta.is_deleted_);
+    EXPECT_EQ(i, tuple.GetValue(&schema, 0).GetAs<int32_t>());
+    if (i % 7 == 0) {
+      EXPECT_TRUE(tuple.GetValue(&schema, 1).IsNull());
+    } else {
+      EXPECT_EQ(std::string(i % 33, 'a' + i % 26), tuple.GetValue(&schema, 1).ToString());
+    }
+    EXPECT_EQ(int64_t{i} * 3, tuple.GetValue(&schema, 2).GetAs<int64_t>());
+  }
+  for (int32_t i = 0; i < 5000; i += 2) {
+    table.UpdateTupleMeta(deleted_meta, rids[i]);
+  }
+
+  // the row iterator still sees every tuple
+  auto values = ScanValues(&table, schema);
+  ASSERT_EQ(2500, values.size());
+  EXPECT_EQ(1, values.front());
+
+  // a column scan reads the same tuples, in the same order
+  size_t count = 0;
+  for (auto iter = table.MakeColumnIterator({2, 0}); !iter.IsEnd(); ++iter) {
+    if (iter.GetTupleMeta().is_deleted_) {
+      continue;
+    }
+    auto a = iter.GetValue(1).GetAs<int32_t>();
+    EXPECT_EQ(values[count], a);
+    EXPECT_EQ(int64_t{a} * 3, iter.GetValue(0).GetAs<int64_t>());
+    EXPECT_EQ(rids[a].Get(), iter.GetRID().Get());
+    count++;
+  }
+  EXPECT_EQ(2500, count);
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, ZoneMapTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(50, disk_manager.get());
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::VARCHAR, 32)});
+  TableHeap table(bpm.get(), TableLayout::ROW, schema);
+  const TupleMeta meta{INVALID_TXN_ID, INVALID_TXN_ID, false};
+  const TupleMeta deleted_meta{INVALID_TXN_ID, INVALID_TXN_ID, true};
+  ASSERT_NE(nullptr, table.GetZoneMap());
+
+  // time-ordered inserts: each page covers its own range of values; every third `b` is null
+  std::vector<RID> rids;
+  for (int32_t i = 0; i < 3000; i++) {
+    auto b = i % 3 == 0 ? ValueFactory::GetNullValueByType(TypeId::VARCHAR)
+                        : ValueFactory::GetVarcharValue(fmt::format("{:04}", i));
+    rids.push_back(*table.InsertTuple(meta, Tuple({ValueFactory::GetIntegerValue(i), b}, &schema)));
+  }
+  ASSERT_GT(CountPages(bpm.get(), table), 2);
+
+  int32_t previous_max = -1;
+  for (auto page_id = table.GetFirstPageId(); page_id != INVALID_PAGE_ID;) {
+    auto zone = table.GetZoneMap()->Get(page_id);
+    ASSERT_TRUE(zone.has_value());
+    auto guard = bpm->FetchPageRead(page_id);
+    const auto *page = guard.As<TablePage>();
+    EXPECT_EQ(page->GetNumTuples(), zone->tuple_count_);
+    auto min = zone->columns_[0].min_.GetAs<int32_t>();
+    auto max = zone->columns_[0].max_.GetAs<int32_t>();
+    EXPECT_EQ(previous_max + 1, min);
+    EXPECT_EQ(min + static_cast<int32_t>(zone->tuple_count_) - 1, max);
+    EXPECT_EQ((max + 3) / 3 - (min + 2) / 3, zone->columns_[1].null_count_);
+    EXPECT_FALSE(zone->AllNull(1));
+    previous_max = max;
+    page_id = page->GetNextPageId();
+  }
+  EXPECT_EQ(2999, previous_max);
+
+  // deletes leave the zones as they are, vacuum narrows them to the live tuples
+  auto first_zone = *table.GetZoneMap()->Get(table.GetFirstPageId());
+  for (int32_t i = 10; i < 3000; i++) {
+    table.UpdateTupleMeta(deleted_meta, rids[i]);
+  }
+  EXPECT_EQ(first_zone.columns_[0].max_.GetAs<int32_t>(),
+            table.GetZoneMap()->Get(table.GetFirstPageId())->columns_[0].max_.GetAs<int32_t>());
+  table.Vacuum([](const Tuple &, RID, RID) {});
+  auto zone = table.GetZoneMap()->Get(table.GetFirstPageId());
+  ASSERT_TRUE(zone.has_value());
+  EXPECT_EQ(10, zone->tuple_count_);
+  EXPECT_EQ(0, zone->columns_[0].min_.GetAs<int32_t>());
+  EXPECT_EQ(9, zone->columns_[0].max_.GetAs<int32_t>());
+  EXPECT_EQ("0008", zone->columns_[1].max_.ToString());
+  EXPECT_EQ(4, zone->columns_[1].null_count_);
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, TupleViewTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(50, disk_manager.get());
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::VARCHAR, 32)});
+  TableHeap table(bpm.get(), TableLayout::ROW, schema);
+  const TupleMeta meta{INVALID_TXN_ID, INVALID_TXN_ID, false};
+  const TupleMeta deleted_meta{INVALID_TXN_ID, INVALID_TXN_ID, true};
+
+  // a view reads the same values as the tuple it views, and materializes into an equal tuple
+  auto tuple = MakeTuple(schema, 7);
+  TupleView view(tuple);
+  EXPECT_EQ(7, view.GetValue(&schema, 0).GetAs<int32_t>());
+  EXPECT_EQ(std::string(24, 'x'), view.GetValue(&schema, 1).ToString());
+  auto copy = view.Materialize();
+  EXPECT_EQ(tuple.GetLength(), copy.GetLength());
+  EXPECT_EQ(0, memcmp(tuple.GetData(), copy.GetData(), tuple.GetLength()));
+
+  std::vector<RID> rids;
+  for (int32_t i = 0; i < 1000; i++) {
+    rids.push_back(*table.InsertTuple(meta, MakeTuple(schema, i)));
+  }
+  for (int32_t i = 0; i < 1000; i += 2) {
+    table.UpdateTupleMeta(deleted_meta, rids[i]);
+  }
+  {
+    auto guard = bpm->FetchPageRead(rids[5].GetPageId());
+    auto [view_meta, page_view] = guard.As<TablePage>()->GetTupleView(rids[5]);
+    EXPECT_FALSE(view_meta.is_deleted_);
+    EXPECT_EQ(5, page_view.GetValue(&schema, 0).GetAs<int32_t>());
+    EXPECT_EQ(rids[5].Get(), page_view.GetRid().Get());
+  }
+
+  // reading page by page in place, only the tuples taken are copied out
+  std::vector<int32_t> values;
+  size_t pages = 0;
+  for (auto iter = table.MakeIterator(); !iter.IsEnd();) {
+    auto page_id = iter.GetRID().GetPageId();
+    while (!iter.IsEnd() && iter.GetRID().GetPageId() == page_id) {
+      auto taken = iter.NextInPage([&](const TupleMeta &tuple_meta, const TupleView &tuple_view) {
+        return !tuple_meta.is_deleted_ && tuple_view.GetValue(&schema, 0).GetAs<int32_t>() % 3 == 1;
+      });
+      if (taken.has_value()) {
+        values.push_back(taken->GetValue(&schema, 0).GetAs<int32_t>());
+        EXPECT_EQ(rids[values.back()].Get(), taken->GetRid().Get());
+      }
+    }
+    pages++;
+  }
+  EXPECT_EQ(CountPages(bpm.get(), table), pages);
+  std::vector<int32_t> expected;
+  for (int32_t i = 1; i < 1000; i += 6) {
+    expected.push_back(i);
+  }
+  EXPECT_EQ(expected, values);
+}
+
+// NOLINTNEXTLINE
+TEST(TableHeapTest, OutOfLineTest) {
+  auto disk_manager = std::make_unique<DiskManagerUnlimitedMemory>();
+  auto bpm = std::make_unique<BufferPoolManager>(50, disk_manager.get());
+  Schema schema({Column("a", TypeId::INTEGER), Column("b", TypeId::VARCHAR, 20000), Column("c", TypeId::VARCHAR, 16)});
+  TableHeap table(bpm.get(), TableLayout::ROW, schema);
+  const TupleMeta meta{INVALID_TXN_ID, INVALID_TXN_ID, false};
+  const TupleMeta deleted_meta{INVALID_TXN_ID, INVALID_TXN_ID, true};
+  auto large = [](int32_t i) { return fmt::format("{:05}", i) + std::string(10000, static_cast<char>('a' + i % 26)); };
+  auto make_tuple = [&](int32_t i, const std::string &b) {
+    return Tuple({ValueFactory::GetIntegerValue(i), ValueFactory::GetVarcharValue(b),
+                  ValueFactory::GetVarcharValue(fmt::format("c{}", i))},
+                 &schema);
+  };
+
+  // a value larger than a page is stored out of line, and the tuples left in line are small
+  std::vector<RID> rids;
+  for (int32_t i = 0; i < 40; i++) {
+    rids.push_back(*table.InsertTuple(meta, make_tuple(i, i % 4 == 0 ? "small" : large(i))));
+  }
+  EXPECT_EQ(1, CountPages(bpm.get(), table));
+  for (int32_t i = 0; i < 40; i++) {
+    auto [tuple_meta, tuple] = table.GetTuple(rids[i]);
+    EXPECT_EQ(i % 4 == 0 ? "small" : large(i), tuple.GetValue(&schema, 1).ToString());
+    EXPECT_EQ(fmt::format("c{}", i), tuple.GetValue(&schema, 2).ToString());
+  }
+
+  // a scan that does not read the large column only sees the prefix of its values
+  auto iter = table.MakeIterator();
+  iter.ReadColumns({0, 2});
+  auto filter = [&](const TupleMeta &, const TupleView &view) {
+    return view.GetValue(&schema, 0).GetAs<int32_t>() == 5;
+  };
+  std::optional<Tuple> taken;
+  while (!iter.IsEnd() && !taken.has_value()) {
+    taken = iter.NextInPage(filter);
+  }
+  ASSERT_TRUE(taken.has_value());
+  EXPECT_EQ(large(5).substr(0, OUT_OF_LINE_PREFIX_SIZE), taken->GetValue(&schema, 1).ToString());
+  EXPECT_EQ("c5", taken->GetValue(&schema, 2).ToString());
+
+  // the whole value is read back in for a scan that reads it, and for the zone
+  auto full_iter = table.MakeIterator();
+  taken.reset();
+  while (!full_iter.IsEnd() && !taken.has_value()) {
+    taken = full_iter.NextInPage([&](const TupleMeta &, const TupleView &view) {
+      return view.GetValue(&schema, 1).ToString() == large(7);
+    });
+  }
+  ASSERT_TRUE(taken.has_value());
+  EXPECT_EQ(7, taken->GetValue(&schema, 0).GetAs<int32_t>());
+  EXPECT_EQ(large(1), table.GetZoneMap()->Get(table.GetFirstPageId())->columns_[1].min_.ToString());
+
+  // updates in place and bulk inserts store out of line too
+  table.UpdateTupleInPlaceUnsafe(meta, make_tuple(1, large(25)), rids[1]);
+  EXPECT_EQ(large(25), table.GetTuple(rids[1]).second.GetValue(&schema, 1).ToString());
+  std::vector<Tuple> tuples;
+  for (int32_t i = 40; i < 200; i++) {
+    tuples.push_back(make_tuple(i, large(i)));
+  }
+  auto bulk_rids = table.InsertTuples(meta, tuples);
+  rids.insert(rids.end(), bulk_rids.begin(), bulk_rids.end());
+  EXPECT_EQ(large(123), table.GetTuple(rids[123]).second.GetValue(&schema, 1).ToString());
+
+  // tuples moved by a vacuum keep their values
+  for (int32_t i = 0; i < 200; i += 2) {
+    table.UpdateTupleMeta(deleted_meta, rids[i]);
+  }
+  std::set<int32_t> moved;
+  table.Vacuum([&](const Tuple &tuple, RID, RID new_rid) {
+    auto i = tuple.GetValue(&schema, 0).GetAs<int32_t>();
+    EXPECT_EQ(large(i), tuple.GetValue(&schema, 1).ToString());
+    moved.insert(i);
+    rids[i] = new_rid;
+  });
+  EXPECT_FALSE(moved.empty());
+  for (int32_t i = 3; i < 200; i += 2) {
+    EXPECT_EQ(large(i), table.GetTuple(rids[i]).second.GetValue(&schema, 1).ToString());
+  }
+}
+
+}  // namespace bustub
@@ -0,0 +1,107 @@
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "argparse/argparse.hpp"
+#include "common/bustub_instance.h"
+#include "fmt/format.h"
+
+// Every heap allocation of the process goes through these, so that a query can be charged for the ones it makes.
+static std::atomic<uint64_t> allocation_count{0};
+
+// NOLINTNEXTLINE
+auto operator new(size_t size) -> void * {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (auto *ptr = std::malloc(size == 0 ? 1 : size); ptr != nullptr) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+// NOLINTNEXTLINE
+auto operator new[](size_t size) -> void * { return operator new(size); }
+
+// NOLINTNEXTLINE
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+// NOLINTNEXTLINE
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+
+// NOLINTNEXTLINE
+void operator delete(void *ptr, size_t size) noexcept { std::free(ptr); }
+
+// NOLINTNEXTLINE
+void operator delete[](void *ptr, size_t size) noexcept { std::free(ptr); }
+
+// Under AddressSanitizer, some allocations still go through its own operator new and come back through ours.
+// NOLINTNEXTLINE
+extern "C" auto __asan_default_options() -> const char * { return "alloc_dealloc_mismatch=0"; }
+
+/**
+ * The queries of the p3.leaderboard tests, and a hash join and a sort that materialize their whole input. q2 is left
+ * out: the optimizer cannot plan it yet, so it fails in p3.leaderboard-q2 as well.
+ */
+static const std::vector<std::pair<std::string, std::string>> QUERIES = {
+    {"q1", "select * from t1 where x >= 90 and y = 10"},
+    {"q3",
+     "select v, d1, d2 from (select v, max(v1) as d1, max(v1) + max(v1) + max(v2) as d2, "
+     "min(v1), max(v2), min(v2), max(v1) + min(v1), max(v2) + min(v2), "
+     "min(v1), max(v2), min(v2), max(v1) + min(v1), max(v2) + min(v2), "
+     "min(v1), max(v2), min(v2), max(v1) + min(v1), max(v2) + min(v2), "
+     "min(v1), max(v2), min(v2), max(v1) + min(v1), max(v2) + min(v2), "
+     "min(v1), max(v2), min(v2), max(v1) + min(v1), max(v2) + min(v2), "
+     "min(v1), max(v2), min(v2), max(v1) + min(v1), max(v2) + min(v2), "
+     "min(v1), max(v2), min(v2), max(v1) + min(v1), max(v2) + min(v2), "
+     "min(v1), max(v2), min(v2), max(v1) + min(v1), max(v2) + min(v2) "
+     "from __mock_t7 left join (select v4 from __mock_t8 where 1 == 2) on v < v4 group by v)"},
+    {"join", "select * from __mock_t4_1m a inner join __mock_t5_1m b on a.x = b.x"},
+    {"sort", "select * from __mock_t7 order by v1 desc"},
+};
+
+// NOLINTNEXTLINE
+auto main(int argc, char **argv) -> int {
+  argparse::ArgumentParser program("bustub-alloc-bench");
+  program.add_argument("--repeat").help("run each query n times");
+
+  try {
+    program.parse_args(argc, argv);
+  } catch (const std::runtime_error &err) {
+    std::cerr << err.what() << std::endl;
+    std::cerr << program;
+    return 1;
+  }
+
+  uint64_t repeat = 1;
+  if (program.present("--repeat")) {
+    repeat = std::stoi(program.get("--repeat"));
+  }
+
+  auto bustub = std::make_unique<bustub::BustubInstance>();
+  bustub->GenerateMockTable();
+  bustub::NoopWriter writer;
+  bustub->ExecuteSql("create table t1(x int, y int, z int);", writer);
+  bustub->ExecuteSql("create index t1xy on t1(x, y);", writer);
+  bustub->ExecuteSql("insert into t1 select * from __mock_t1;", writer);
+
+  fmt::print("{:<6}{:<8}{:>16}{:>16}\n", "query", "arena", "allocations", "time_ms");
+  for (const auto &[name, sql] : QUERIES) {
+    for (const auto *arena : {"false", "true"}) {
+      bustub->ExecuteSql(fmt::format("set query_arena={};", arena), writer);
+      auto allocations = allocation_count.load();
+      auto start = std::chrono::steady_clock::now();
+      for (uint64_t i = 0; i < repeat; i++) {
+        bustub->ExecuteSql(sql, writer);
+      }
+      auto elapsed = std::chrono::steady_clock::now() - start;
+      fmt::print("{:<6}{:<8}{:>16}{:>16}\n", name, arena, (allocation_count.load() - allocations) / repeat,
+                 std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() / repeat);
+    }
+  }
+  return 0;
+}
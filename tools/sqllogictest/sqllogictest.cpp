@@ -75,6 +75,21 @@ auto ProcessExtraOptions(const std::string &sql, bustub::BustubInstance &instanc
           fmt::print("IndexScan not found\n");
           return false;
         }
+      } else if (opt == "ensure:index_only_scan") {
+        if (!bustub::StringUtil::Contains(result.str(), "index_only=true")) {
+          fmt::print("index-only IndexScan not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:sorted_fetch") {
+        if (!bustub::StringUtil::Contains(result.str(), "sorted_fetch=true")) {
+          fmt::print("IndexScan with sorted fetch not found\n");
+          return false;
+        }
+      } else if (opt == "ensure:columnar_scan") {
+        if (!bustub::StringUtil::Contains(result.str(), "columns=")) {
+          fmt::print("SeqScan reading some columns not found\n");
+          return false;
+        }
       } else if (opt == "ensure:hash_join") {
         if (bustub::StringUtil::Split(result.str(), "HashJoin").size() != 2 &&
             !bustub::StringUtil::Contains(result.str(), "Filter")) {